@@ -31,6 +31,9 @@ extern "C" {
 
 struct flash_img_context {
 	uint8_t buf[CONFIG_IMG_BLOCK_BUF_SIZE];
+#ifdef CONFIG_IMG_WRITE_BEHIND
+	uint8_t wb_buf[CONFIG_IMG_BLOCK_BUF_SIZE * (CONFIG_IMG_WRITE_BEHIND_BUFFERS - 1)];
+#endif
 	const struct flash_area *flash_area;
 	struct stream_flash_ctx stream;
 };
@@ -49,6 +52,11 @@ struct flash_img_check {
 /**
  * @brief Initialize context needed for writing the image to the flash.
  *
+ * With CONFIG_IMG_WRITE_BEHIND, the image is written in the background
+ * until a write with the flush flag set returns. An image given up before
+ * that has to be stopped with stream_flash_write_behind_stop() on
+ * @p ctx->stream before @p ctx is initialized again or freed.
+ *
  * @param ctx     context to be initialized
  * @param area_id flash area id of partition where the image should be written
  *
@@ -33,6 +33,29 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief Progress of the garbage collection of a sector
+ *
+ * Kept in the file system when the garbage collection is incremental,
+ * see @kconfig{CONFIG_NVS_GC_INCREMENTAL}.
+ */
+struct nvs_gc_state {
+	/** Address of the sector being collected */
+	uint32_t sec_addr;
+	/** Address of the next allocation table entry to collect */
+	uint32_t addr;
+	/** Address of the last allocation table entry to collect */
+	uint32_t stop_addr;
+	/** Upper bound of the space taken by the entries left to copy */
+	uint32_t need;
+	/** End of the data left by a copy interrupted by a power loss */
+	uint32_t torn_end;
+	/** Space kept for a copy interrupted by a power loss */
+	uint16_t slack;
+	/** Current step of the collection */
+	uint8_t phase;
+};
+
 /**
  * @brief Non-volatile Storage File system structure
  */
@@ -62,6 +85,14 @@ struct nvs_fs {
 #if CONFIG_NVS_LOOKUP_CACHE
 	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
 #endif
+#if CONFIG_NVS_GC_INCREMENTAL
+	/** Pending garbage collection */
+	struct nvs_gc_state gc;
+#if CONFIG_NVS_GC_WORKQUEUE
+	/** Work item running the pending garbage collection */
+	struct k_work gc_work;
+#endif
+#endif
 };
 
 /**
@@ -80,6 +111,9 @@ struct nvs_fs {
  *
  * @param fs Pointer to file system
  * @retval 0 Success
+ * @retval -ENOSPC With CONFIG_NVS_GC_INCREMENTAL, if a garbage collection
+ * torn by several power losses can no longer be completed. The file system is
+ * left as is, erasing its sectors makes it usable again, without its content.
  * @retval -ERRNO errno code if error
  */
 int nvs_mount(struct nvs_fs *fs);
@@ -153,6 +187,52 @@ ssize_t nvs_read(struct nvs_fs *fs, uint16_t id, void *data, size_t len);
  */
 ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len, uint16_t cnt);
 
+/**
+ * @brief Callback invoked by nvs_walk() for each entry.
+ *
+ * @param id Id of the entry
+ * @param len Length of the entry data, 0 for a deleted entry
+ * @param addr Address of the entry, to be passed to nvs_read_addr()
+ * @param arg Argument given to nvs_walk()
+ *
+ * @return 0 to continue the walk, any other value stops it and is returned by nvs_walk().
+ */
+typedef int (*nvs_walk_cb_t)(uint16_t id, size_t len, uint32_t addr, void *arg);
+
+/**
+ * @brief Walk through all entries of the file system, newest first.
+ *
+ * Every version of an id still present in flash is reported, the first one being the latest.
+ * This visits all entries in a single pass over the allocation table, so it is much faster
+ * than reading many ids one at a time with nvs_read(), which searches the table backwards
+ * for each of them.
+ *
+ * @param fs Pointer to file system
+ * @param cb Callback invoked for each entry
+ * @param arg Argument passed to @p cb
+ *
+ * @retval 0 Success
+ * @retval -ERRNO errno code if error
+ * @return The value returned by @p cb if it stopped the walk.
+ */
+int nvs_walk(struct nvs_fs *fs, nvs_walk_cb_t cb, void *arg);
+
+/**
+ * @brief Read an entry found by nvs_walk().
+ *
+ * The address is only valid until the next write to the file system, which may move entries.
+ *
+ * @param fs Pointer to file system
+ * @param id Id of the entry to be read
+ * @param addr Address of the entry, as reported by nvs_walk()
+ * @param data Pointer to data buffer
+ * @param len Number of bytes to be read
+ *
+ * @return Number of bytes read, as for nvs_read(). Returns -ENOENT if there is no entry with
+ * id @p id at @p addr.
+ */
+ssize_t nvs_read_addr(struct nvs_fs *fs, uint16_t id, uint32_t addr, void *data, size_t len);
+
 /**
  * @brief Calculate the available free space in the file system.
  *
@@ -188,6 +268,22 @@ size_t nvs_sector_max_data_size(struct nvs_fs *fs);
  */
 int nvs_sector_use_next(struct nvs_fs *fs);
 
+/**
+ * @brief Run a slice of the pending garbage collection.
+ *
+ * With @kconfig{CONFIG_NVS_GC_INCREMENTAL}, the sector freed when the write sector gets full is
+ * collected in slices of @kconfig{CONFIG_NVS_GC_SLICE} allocation table entries, or of its
+ * erase. This runs one of them, from an idle thread for instance.
+ *
+ * @param fs Pointer to the file system.
+ *
+ * @retval 1 Garbage collection is still pending.
+ * @retval 0 No garbage collection is pending.
+ * @retval -ENOTSUP Garbage collection is not incremental.
+ * @retval -ERRNO errno code if error
+ */
+int nvs_gc_step(struct nvs_fs *fs);
+
 /**
  * @}
  */
@@ -64,6 +64,16 @@ struct zms_fs {
 	/** Lookup table used to cache ATE addresses of written IDs */
 	uint64_t lookup_cache[CONFIG_ZMS_LOOKUP_CACHE_SIZE];
 #endif
+#if CONFIG_ZMS_LOOKUP_INDEX
+	/** IDs of the lookup index, `0xFFFFFFFF` for free slots */
+	uint32_t index_id[CONFIG_ZMS_LOOKUP_INDEX_SIZE];
+	/** ATE addresses of the lookup index, for the ID in the same slot */
+	uint64_t index_addr[CONFIG_ZMS_LOOKUP_INDEX_SIZE];
+	/** Number of used slots in the lookup index */
+	uint32_t index_used;
+	/** Whether all stored IDs are in the lookup index */
+	bool index_complete;
+#endif
 };
 
 /**
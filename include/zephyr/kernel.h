@@ -5330,13 +5330,31 @@ struct k_mem_slab_info {
 #endif
 };
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/* Free blocks kept by one CPU, only locked by the other CPUs when the
+ * shared free list runs out.
+ */
+struct z_mem_slab_cpu_cache {
+	struct k_spinlock lock;
+	uint16_t count;
+	char *blocks[CONFIG_MEM_SLAB_CPU_CACHE_SIZE];
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
 	char *buffer;
 	char *free_list;
+	/* With CONFIG_MEM_SLAB_CPU_CACHE, num_used includes cached blocks */
 	struct k_mem_slab_info info;
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	struct z_mem_slab_cpu_cache cpu_cache[CONFIG_MP_MAX_NUM_CPUS];
+	/* Number of threads about to wait for a free block */
+	atomic_t cache_waiters;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 
 #ifdef CONFIG_OBJ_CORE_MEM_SLAB
@@ -5344,6 +5362,10 @@ struct k_mem_slab {
 #endif
 };
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+uint32_t z_mem_slab_num_cached(struct k_mem_slab *slab);
+#endif
+
 #define Z_MEM_SLAB_INITIALIZER(_slab, _slab_buffer, _slab_block_size, \
 			       _slab_num_blocks)                      \
 	{                                                             \
@@ -5490,7 +5512,11 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	return slab->info.num_used - z_mem_slab_num_cached(slab);
+#else
 	return slab->info.num_used;
+#endif
 }
 
 /**
@@ -5525,7 +5551,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->info.num_blocks - slab->info.num_used;
+	return slab->info.num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /**
@@ -5564,10 +5590,33 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab);
 
 /* kernel synchronized heap struct */
 
+/** @cond INTERNAL_HIDDEN */
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+/* Size classes of 8, 16, ... CONFIG_K_HEAP_CPU_CACHE_MAX_SIZE bytes */
+#define Z_HEAP_CACHE_CLASSES (LOG2(CONFIG_K_HEAP_CPU_CACHE_MAX_SIZE) - 2)
+
+struct z_heap_cpu_cache {
+	/* Only taken by another CPU when the heap runs out of memory */
+	struct k_spinlock lock;
+	/* Free blocks of each class, linked through their first word */
+	void *blocks[Z_HEAP_CACHE_CLASSES];
+	uint16_t count[Z_HEAP_CACHE_CLASSES];
+	size_t bytes;
+	uint32_t hits;
+	uint32_t misses;
+};
+#endif
+/** @endcond */
+
 struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+	struct z_heap_cpu_cache cpu_cache[CONFIG_MP_MAX_NUM_CPUS];
+	/* Threads about to wait for memory, frees bypass the caches */
+	atomic_t cache_waiters;
+#endif
 };
 
 /**
@@ -5696,6 +5745,24 @@ void *k_heap_realloc(struct k_heap *h, void *ptr, size_t bytes, k_timeout_t time
  */
 void k_heap_free(struct k_heap *h, void *mem) __attribute_nonnull(1);
 
+/**
+ * @brief Get the memory stats for a k_heap
+ *
+ * This routine gets the runtime memory usage stats for the heap @a h,
+ * including the blocks held by its per-CPU caches when
+ * CONFIG_K_HEAP_CPU_CACHE is enabled. Requires
+ * CONFIG_SYS_HEAP_RUNTIME_STATS.
+ *
+ * @param h Heap
+ * @param stats Pointer to memory into which to copy memory usage statistics
+ *
+ * @retval 0 Success
+ * @retval -EINVAL Any parameter points to NULL
+ */
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+int k_heap_runtime_stats_get(struct k_heap *h, struct sys_memory_stats *stats);
+#endif
+
 /* Hand-calculated minimum heap sizes needed to return a successful
  * 1-byte allocation.  See details in lib/os/heap.[ch]
  */
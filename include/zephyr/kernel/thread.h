@@ -128,6 +128,14 @@ struct _thread_base {
 #endif /* CONFIG_MP_MAX_NUM_CPUS */
 #endif /* CONFIG_SCHED_CPU_MASK */
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	/* CPU whose run queue holds the thread */
+	uint8_t runq_cpu;
+
+	/* k_cycle_get_32() when the thread was added to the run queue */
+	uint32_t runq_time;
+#endif /* CONFIG_SCHED_CPU_RUNQ */
+
 	/* data returned by APIs */
 	void *swap_data;
 
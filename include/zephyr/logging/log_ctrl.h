@@ -295,6 +295,21 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage);
  */
 int log_mem_get_max_usage(uint32_t *max);
 
+/**
+ * @brief Get number of messages dropped on a CPU.
+ *
+ * Requires CONFIG_LOG_CPU_BUFFERS option. The count covers messages dropped
+ * while logging on the given CPU since logging was initialized.
+ *
+ * @param[in] cpu CPU index.
+ * @param[out] cnt Number of dropped messages.
+ *
+ * @retval -EINVAL if CPU index is out of range.
+ * @retval -ENOTSUP if feature is disabled.
+ * @retval 0 successfully read the counter.
+ */
+int log_dropped_cpu_get(unsigned int cpu, uint32_t *cnt);
+
 #if defined(CONFIG_LOG) && !defined(CONFIG_LOG_MODE_MINIMAL)
 #define LOG_CORE_INIT() log_core_init()
 #define LOG_PANIC() log_panic()
@@ -9,7 +9,6 @@
 #include <zephyr/logging/log_msg.h>
 #include <zephyr/sys/util.h>
 #include <stdarg.h>
-#include <zephyr/sys/atomic.h>
 #include <zephyr/kernel.h>
 
 #ifdef __cplusplus
@@ -87,17 +86,42 @@ typedef int (*log_output_func_t)(uint8_t *buf, size_t size, void *ctx);
 
 /* @brief Control block structure for log_output instance.  */
 struct log_output_control_block {
-	atomic_t offset;
+	size_t offset;
 	void *ctx;
 	const char *hostname;
 };
 
+#if defined(CONFIG_LOG_DICTIONARY_COMPACT) || defined(__DOXYGEN__)
+/** @brief State of the compact dictionary encoder of a log_output instance. */
+struct log_dict_output_state {
+	/** Timestamp of the previous message, others are sent as deltas. */
+	log_timestamp_t timestamp;
+	/** Set once the stream started with a reset record. */
+	bool started;
+	/** Number of messages sent since the last reset record. */
+	uint16_t since_sync;
+#if defined(CONFIG_LOG_DICTIONARY_COMPRESS) || defined(__DOXYGEN__)
+	/** Number of bytes of history at the start of @p buf. */
+	uint16_t history_len;
+	/** Recently sent messages, followed by the one being compressed. */
+	uint8_t buf[CONFIG_LOG_DICTIONARY_COMPRESS_WINDOW +
+		    CONFIG_LOG_DICTIONARY_COMPRESS_MAX_MSG];
+	/** Compressed message. */
+	uint8_t out[CONFIG_LOG_DICTIONARY_COMPRESS_MAX_MSG + 8];
+#endif
+};
+#endif
+
 /** @brief Log_output instance structure. */
 struct log_output {
 	log_output_func_t func;
 	struct log_output_control_block *control_block;
 	uint8_t *buf;
 	size_t size;
+#if defined(CONFIG_LOG_DICTIONARY_COMPACT) || defined(__DOXYGEN__)
+	/** Compact dictionary encoder state. */
+	struct log_dict_output_state *dict_state;
+#endif
 };
 
 /**
@@ -133,6 +157,31 @@ log_format_func_t log_format_func_t_get(uint32_t log_type);
 		.size = _size,						\
 	}
 
+/** @brief Create log_output instance used for dictionary based logging.
+ *
+ * Same as @ref LOG_OUTPUT_DEFINE, with the state needed to send messages in
+ * the format set by CONFIG_LOG_DICTIONARY_COMPACT. Instances created with
+ * @ref LOG_OUTPUT_DEFINE send dictionary based messages in the default
+ * format.
+ *
+ * @param _name Instance name.
+ * @param _func Function for processing output data.
+ * @param _buf  Pointer to the output buffer.
+ * @param _size Size of the output buffer.
+ */
+#define LOG_OUTPUT_DICT_DEFINE(_name, _func, _buf, _size)		\
+	static struct log_output_control_block _name##_control_block;	\
+	IF_ENABLED(CONFIG_LOG_DICTIONARY_COMPACT,			\
+		   (static struct log_dict_output_state _name##_dict_state;)) \
+	static const struct log_output _name = {			\
+		.func = _func,						\
+		.control_block = &_name##_control_block,		\
+		.buf = _buf,						\
+		.size = _size,						\
+		IF_ENABLED(CONFIG_LOG_DICTIONARY_COMPACT,		\
+			   (.dict_state = &_name##_dict_state,))	\
+	}
+
 /** @brief Process log messages v2 to readable strings.
  *
  * Function is using provided context with the buffer and output function to
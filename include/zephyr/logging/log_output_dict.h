@@ -23,8 +23,46 @@ extern "C" {
 enum log_dict_output_msg_type {
 	MSG_NORMAL = 0,
 	MSG_DROPPED_MSG = 1,
+	/** Compact message, see CONFIG_LOG_DICTIONARY_COMPACT. */
+	MSG_COMPACT = 2,
+	/** Compressed compact message, see CONFIG_LOG_DICTIONARY_COMPRESS. */
+	MSG_COMPACT_LZ = 3,
+	/** Start of a compact stream or resynchronization point, sets the
+	 *  timestamp and clears the history.
+	 */
+	MSG_COMPACT_RESET = 4,
 };
 
+/*
+ * Compact message, after the type byte, with varint being an unsigned
+ * LEB128 integer and zigzag mapping signed values to unsigned ones:
+ *
+ *   uint8_t (level << 4) | domain
+ *   varint  source
+ *   varint  zigzag(timestamp - timestamp of the previous message)
+ *   varint  package length in bytes
+ *   varint  data length in bytes
+ *   varint  zigzag(word) for each 32 bit word of the package arguments,
+ *           as many as the package header says, in target endianness
+ *   uint8_t remaining package bytes (string indexes and strings), then data
+ *
+ * A compressed message is a varint with the length of the compact message
+ * above, then LZ77 sequences producing it. Each sequence is a token byte
+ * holding the literal count in the upper and the match length minus 3 in
+ * the lower nibble, a varint extending either when the nibble is 15, the
+ * literals and, unless the message is complete, a varint with the distance
+ * back to the match in the history and the message so far, followed by the
+ * match length extension. Compressed messages are appended to the history,
+ * uncompressed compact messages are not.
+ *
+ * A reset record is the type byte followed by the LOG_DICT_COMPACT_SYNC
+ * bytes and a varint with the absolute timestamp the next delta refers to.
+ * It starts the stream and is repeated every
+ * CONFIG_LOG_DICTIONARY_COMPACT_SYNC_INTERVAL messages, so that a parser
+ * joining late or losing bytes can search for it and carry on from there.
+ */
+#define LOG_DICT_COMPACT_SYNC { 0x5A, 0xC3, 0x96, 0x3C }
+
 /**
  * Output header for one dictionary based log message.
  */
@@ -214,6 +214,11 @@ enum ethernet_hw_caps {
 
 	/** 5 Gbits link supported */
 	ETHERNET_LINK_5000BASE_T	= BIT(22),
+
+	/** TCP segmentation offload supported, the driver splits TCP
+	 *  packets having a non-zero net_pkt_gso_size() into segments
+	 */
+	ETHERNET_HW_TX_TSO		= BIT(23),
 };
 
 /** @cond INTERNAL_HIDDEN */
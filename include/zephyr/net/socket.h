@@ -76,6 +76,8 @@ extern "C" {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: turn on ZSOCK_MSG_DONTWAIT after the first message */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 /** @} */
 
 /**
@@ -474,6 +476,24 @@ static inline ssize_t zsock_send(int sock, const void *buf, size_t len,
 __syscall ssize_t zsock_sendmsg(int sock, const struct msghdr *msg,
 				int flags);
 
+/**
+ * @brief Send multiple messages on a socket
+ *
+ * @details
+ * Send up to @a vlen messages with a single call, as if zsock_sendmsg()
+ * was called for each of them, and store the number of bytes sent for
+ * each message in its msg_len field. The socket is looked up and locked
+ * only once for the whole batch.
+ * See the Linux sendmmsg(2) manual page for a description of the semantics.
+ * This function is also exposed as `sendmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @return Number of messages sent, or -1 with errno set if the first
+ *         message could not be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
 /**
  * @brief Receive data from an arbitrary network address
  *
@@ -500,6 +520,71 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
  */
 __syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
 
+/**
+ * @brief Receive multiple messages from a socket
+ *
+ * @details
+ * Receive up to @a vlen messages with a single call, as if zsock_recvmsg()
+ * was called for each of them, and store the number of bytes received for
+ * each message in its msg_len field. The socket is looked up and locked
+ * only once for the whole batch. With ZSOCK_MSG_WAITFORONE in @a flags,
+ * the call only blocks until the first message is received.
+ * See the Linux recvmmsg(2) manual page for a description of the semantics.
+ * This function is also exposed as `recvmmsg()`
+ * if @kconfig{CONFIG_POSIX_API} is defined.
+ *
+ * @return Number of messages received, or -1 with errno set if no message
+ *         could be received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+struct net_buf;
+
+/**
+ * @brief Receive data without copying it out of the network buffers
+ *
+ * @details
+ * Dequeue the next received packet of a UDP or TCP socket and hand its
+ * unread payload over to the caller as a chain of network buffer
+ * fragments. For a datagram socket, one whole datagram is returned,
+ * for a stream socket, the data of one received TCP segment. The caller
+ * owns the fragments and must return them with zsock_recv_buf_release()
+ * once done with the data: until then they are not available for
+ * receiving other packets, and the TCP receive window stays closed by
+ * their length.
+ *
+ * ZSOCK_MSG_PEEK is not supported. This function is only available to
+ * supervisor threads: it is not a system call, as the network buffers
+ * are kernel objects outside of any memory domain. User mode threads
+ * keep using zsock_recv() and zsock_recvmsg().
+ *
+ * @param sock Socket to receive from.
+ * @param frags Set to the first fragment holding the data, or to NULL
+ *              when no data is returned.
+ * @param flags ZSOCK_MSG_DONTWAIT or 0.
+ * @param src_addr Set to the source address of a datagram, if not NULL.
+ * @param addrlen Value-result length of @a src_addr.
+ *
+ * @return Number of bytes in @a frags, 0 at the end of a stream, or -1
+ *         with errno set.
+ */
+ssize_t zsock_recv_buf(int sock, struct net_buf **frags, int flags,
+		       struct sockaddr *src_addr, socklen_t *addrlen);
+
+/**
+ * @brief Release network buffers returned by zsock_recv_buf()
+ *
+ * @details
+ * For a stream socket, this opens the TCP receive window by the length
+ * of the released data. The buffers must be released before the socket
+ * is closed.
+ *
+ * @param sock Socket the buffers were received from.
+ * @param frags Fragment chain returned by zsock_recv_buf(), may be NULL.
+ */
+void zsock_recv_buf_release(int sock, struct net_buf *frags);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -922,6 +1007,8 @@ struct ifreq {
 #define TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define TCP_KEEPCNT 4
+/** Congestion control algorithm name, e.g. "reno" or "cubic" */
+#define TCP_CONGESTION 5
 
 /** @} */
 
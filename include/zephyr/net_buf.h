@@ -1070,6 +1070,17 @@ struct net_buf_data_alloc {
 
 /** @endcond */
 
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+/** @cond INTERNAL_HIDDEN */
+struct net_buf_pool_cpu_cache {
+	/* Only taken by another CPU when buffers run out */
+	struct k_spinlock lock;
+	uint16_t count;
+	struct net_buf *bufs[CONFIG_NET_BUF_POOL_CPU_CACHE_SIZE];
+};
+/** @endcond */
+#endif /* CONFIG_NET_BUF_POOL_CPU_CACHE */
+
 /**
  * @brief Network buffer pool representation.
  *
@@ -1110,6 +1121,14 @@ struct net_buf_pool {
 
 	/** Start of buffer storage array */
 	struct net_buf * const __bufs;
+
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+	/** Free buffers kept by each CPU */
+	struct net_buf_pool_cpu_cache cpu_cache[CONFIG_MP_MAX_NUM_CPUS];
+
+	/** Number of threads about to wait for a free buffer */
+	atomic_t cache_waiters;
+#endif
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -1457,6 +1476,12 @@ __deprecated struct net_buf * __must_check net_buf_get(struct k_fifo *fifo,
 						       k_timeout_t timeout);
 #endif
 
+/** @cond INTERNAL_HIDDEN */
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+void net_buf_pool_cache_put(struct net_buf_pool *pool, struct net_buf *buf);
+#endif
+/** @endcond */
+
 /**
  * @brief Destroy buffer from custom destroy callback
  *
@@ -1477,7 +1502,11 @@ static inline void net_buf_destroy(struct net_buf *buf)
 		buf->__buf = NULL;
 	}
 
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+	net_buf_pool_cache_put(pool, buf);
+#else
 	k_lifo_put(&pool->free, buf);
+#endif
 }
 
 /**
@@ -435,6 +435,13 @@ struct rtio {
 
 	/* Completion queue */
 	struct mpsc cq;
+
+#ifdef CONFIG_RTIO_WORKQ_FAIR
+	/* Deadline, in cycles, of the last request of the context handed
+	 * to the RTIO work-queues
+	 */
+	uint32_t workq_tag;
+#endif
 };
 
 /** The memory partition associated with all RTIO context information */
@@ -42,6 +42,16 @@ struct rtio_work_req {
 	 * This is filled inside @ref rtio_work_req_submit.
 	 */
 	rtio_work_submit_t handler;
+
+#if CONFIG_RTIO_WORKQ_IODEV_INFLIGHT > 0
+	/** Node in the queue of the requests waiting for their iodev,
+	 * see @kconfig{CONFIG_RTIO_WORKQ_IODEV_INFLIGHT}.
+	 */
+	sys_snode_t node;
+
+	/** Requests of the same iodev, in flight and waiting. */
+	struct rtio_work_iodev *iodev;
+#endif
 };
 
 /**
@@ -58,6 +68,12 @@ struct rtio_work_req *rtio_work_req_alloc(void);
 /**
  * @brief Submit RTIO work request.
  *
+ * Requests are run by the threads of the RTIO work-queues by priority. With
+ * @kconfig{CONFIG_RTIO_WORKQ_FAIR}, requests of the same priority from different RTIO
+ * contexts are taken in turn. With @kconfig{CONFIG_RTIO_WORKQ_IODEV_INFLIGHT}, requests of
+ * an iodev which has as many requests in the threads' hands as allowed wait for one of them
+ * to complete, so that a slow device does not hold all the threads.
+ *
  * @param req Item to fill with request information.
  * @param iodev_sqe RTIO Operation information.
  * @param handler Callback to handler where work operation is performed.
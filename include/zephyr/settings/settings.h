@@ -12,6 +12,7 @@
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/slist.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys_clock.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -383,6 +384,60 @@ int settings_commit(void);
  */
 int settings_commit_subtree(const char *subtree);
 
+#if defined(CONFIG_SETTINGS_WRITE_BACK) || defined(__DOXYGEN__)
+/**
+ * Statistics of the write-back cache of saved settings.
+ */
+struct settings_write_back_stats {
+	/** Number of saves and deletes requested. */
+	uint32_t saves;
+	/** Number of pending saves replaced by a later save of the same setting. */
+	uint32_t merged;
+	/** Number of saves and deletes written to the storage back-end. */
+	uint32_t writes;
+	/** Number of times the pending saves were written. */
+	uint32_t flushes;
+};
+
+/**
+ * Start a batch of saves. Saves done until the matching
+ * settings_save_batch_commit() are kept in RAM, repeated saves of the same
+ * setting being merged, and written together at the end. Batches can be
+ * nested, the saves are written when the outermost one is committed.
+ *
+ * A batch larger than the write-back cache is written in several steps,
+ * and a batch is not atomic against power loss.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int settings_save_batch_begin(void);
+
+/**
+ * End a batch of saves started with settings_save_batch_begin().
+ *
+ * @return 0 on success, -EINVAL if no batch was started, or the error of the
+ * storage back-end if writing the saves failed.
+ */
+int settings_save_batch_commit(void);
+
+/**
+ * Write all pending saves to the storage back-end.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int settings_flush(void);
+
+/**
+ * Get the statistics of the write-back cache. The number of back-end writes
+ * avoided is the number of saves less the number of writes.
+ *
+ * @param[out] stats Statistics.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int settings_write_back_stats_get(struct settings_write_back_stats *stats);
+#endif /* CONFIG_SETTINGS_WRITE_BACK */
+
 /**
  * @} settings
  */
@@ -488,6 +543,28 @@ struct settings_store_itf {
 	 *  - cs - Corresponding backend handler node
 	 */
 	void *(*csi_storage_get)(struct settings_store *cs);
+
+#if defined(CONFIG_SETTINGS_WRITE_BACK) || defined(__DOXYGEN__)
+	int (*csi_lock)(struct settings_store *cs, k_timeout_t timeout);
+	/**< Take the lock of the storage before pending saves are written
+	 * from log_panic() or sys_reboot(). Optional, the pending saves are
+	 * not written from there for a backend without it.
+	 *
+	 * Parameters:
+	 *  - cs - Corresponding backend handler node
+	 *  - timeout - How long to wait for the lock
+	 *
+	 * Returns 0 if the lock was taken, an error if it is in use, including
+	 * by the calling thread.
+	 */
+
+	void (*csi_unlock)(struct settings_store *cs);
+	/**< Release the lock taken by csi_lock.
+	 *
+	 * Parameters:
+	 *  - cs - Corresponding backend handler node
+	 */
+#endif /* CONFIG_SETTINGS_WRITE_BACK */
 };
 
 /**
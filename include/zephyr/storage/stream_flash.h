@@ -25,6 +25,10 @@
 
 #include <stdbool.h>
 #include <zephyr/drivers/flash.h>
+#ifdef CONFIG_STREAM_FLASH_WRITE_BEHIND
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -39,7 +43,9 @@ extern "C" {
  * data read back from the flash after a flash write has completed.
  * This enables verifying that the data has been correctly stored (for
  * instance by using a SHA function). The write buffer 'buf' provided in
- * stream_flash_init is used as a read buffer for this purpose.
+ * stream_flash_init is used as a read buffer for this purpose, or the one
+ * written when buffers are written in the background.
+ * See stream_flash_write_behind().
  *
  * @param buf Pointer to the data read.
  * @param len The length of the data read.
@@ -69,6 +75,17 @@ struct stream_flash_ctx {
 #endif
 	size_t write_block_size;	/* Offset/size device write alignment */
 	uint8_t erase_value;
+#ifdef CONFIG_STREAM_FLASH_WRITE_BEHIND
+	uint8_t wb_count; /* Number of write buffers, 0 when writing synchronously */
+	uint8_t wb_fill; /* Index of the buffer being filled */
+	uint8_t wb_write; /* Index of the next buffer to write to flash */
+	uint8_t *wb_bufs; /* Write buffers following the one given at init */
+	size_t wb_queued; /* Number of bytes written or waiting to be written */
+	atomic_t wb_pending; /* Number of full buffers waiting to be written */
+	int wb_err; /* First error of a write to flash done in the background */
+	struct k_sem wb_free; /* Buffers free to be filled */
+	struct k_work wb_work; /* Writes full buffers to flash */
+#endif
 };
 
 /**
@@ -125,6 +142,51 @@ size_t stream_flash_bytes_written(const struct stream_flash_ctx *ctx);
 int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *data,
 				size_t len, bool flush);
 
+/**
+ * @brief Write full buffers to flash in the background.
+ *
+ * Once enabled, a buffer filled by stream_flash_buffered_write() is written to flash by a
+ * dedicated work queue, erase included, while the next buffers are filled. The call only blocks
+ * when all buffers are full. Otherwise, the writes to flash overlap with producing the data, for
+ * instance with receiving the next chunks of an image.
+ *
+ * This has to be called after stream_flash_init() and stream_flash_progress_load(), before
+ * writing any data.
+ *
+ * Errors of the writes done in the background are returned by the next call to
+ * stream_flash_buffered_write(). stream_flash_bytes_written() only counts the bytes already
+ * in flash, and a write with the flush flag set waits for all of them to be written.
+ *
+ * The buffers are in use until a write with the flush flag set returns. To give up a stream
+ * before that, for instance before initializing the context again, call
+ * stream_flash_write_behind_stop().
+ *
+ * @note Available with CONFIG_STREAM_FLASH_WRITE_BEHIND.
+ *
+ * @param ctx context
+ * @param bufs @p count buffers of the length given to stream_flash_init(), used in turn with
+ *             the one given there.
+ * @param count Number of buffers in @p bufs, at least 1.
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_write_behind(struct stream_flash_ctx *ctx, uint8_t *bufs, size_t count);
+
+/**
+ * @brief Stop writing full buffers to flash in the background.
+ *
+ * Waits for the buffer being written to flash, if any, and drops the data not yet written. The
+ * context then writes synchronously, following the bytes already in flash, until write-behind
+ * is enabled again. Does nothing if write-behind is not enabled on the context.
+ *
+ * @note Available with CONFIG_STREAM_FLASH_WRITE_BEHIND.
+ *
+ * @param ctx context, initialized with stream_flash_init()
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_write_behind_stop(struct stream_flash_ctx *ctx);
+
 /**
  * @brief Erase the flash page to which a given offset belongs.
  *
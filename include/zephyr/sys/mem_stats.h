@@ -25,6 +25,13 @@ struct sys_memory_stats {
 	size_t  free_bytes;
 	size_t  allocated_bytes;
 	size_t  max_allocated_bytes;
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+	/* Free blocks held by per-CPU caches, counted as allocated above */
+	size_t  cached_bytes;
+	/* Allocations served from, and missed by, the per-CPU caches */
+	size_t  cache_hits;
+	size_t  cache_misses;
+#endif
 };
 
 #ifdef __cplusplus
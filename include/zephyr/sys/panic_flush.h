@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Flush hooks run before the system goes down
+ *
+ * Subsystems keeping data in RAM for a while register a hook to write it
+ * out when log_panic() or sys_reboot() is called, without those having
+ * to know about them.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_PANIC_FLUSH_H_
+#define ZEPHYR_INCLUDE_SYS_PANIC_FLUSH_H_
+
+#include <zephyr/sys/slist.h>
+#include <zephyr/sys_clock.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Panic flush hook
+ */
+struct sys_panic_flush {
+	/** Node of the list of hooks, for internal use. */
+	sys_snode_t node;
+
+	/**
+	 * @brief Write out the data kept in RAM.
+	 *
+	 * Called from log_panic() and sys_reboot(), possibly from an ISR or
+	 * with interrupts locked. Whatever cannot be done within @p timeout
+	 * is skipped.
+	 *
+	 * @param hook The registered hook.
+	 * @param timeout How long the hook may wait for resources in use:
+	 * K_NO_WAIT from log_panic() or an ISR, and
+	 * CONFIG_SYS_PANIC_FLUSH_REBOOT_TIMEOUT_MS from sys_reboot().
+	 */
+	void (*flush)(struct sys_panic_flush *hook, k_timeout_t timeout);
+};
+
+/**
+ * @brief Register a panic flush hook.
+ *
+ * Hooks cannot be unregistered.
+ *
+ * @param hook Hook to register, with static storage duration.
+ */
+void sys_panic_flush_register(struct sys_panic_flush *hook);
+
+/**
+ * @brief Run the registered panic flush hooks, in registration order.
+ *
+ * @param timeout How long each hook may wait for resources in use.
+ */
+void sys_panic_flush_run(k_timeout_t timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_PANIC_FLUSH_H_ */
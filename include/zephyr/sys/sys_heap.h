@@ -37,7 +37,9 @@ extern "C" {
  * sample of the smallest bucket that might fit, falling back rapidly
  * to the smallest block guaranteed to fit.  Split memory remaining in
  * the chunk is always returned immediately to the heap for other
- * allocation.
+ * allocation.  CONFIG_SYS_HEAP_ALLOC_BEST_FIT instead searches for the
+ * smallest free block that fits, trading the constant time bound
+ * for even less fragmentation.
  *
  * Excellent performance with firmly bounded runtime.  All operations
  * are constant time (though there is a search of the smallest bucket
@@ -96,6 +98,19 @@ int sys_heap_runtime_stats_get(struct sys_heap *heap,
  */
 int sys_heap_runtime_stats_reset_max(struct sys_heap *heap);
 
+/**
+ * @brief Get the size of the largest free block of a sys_heap
+ *
+ * Unlike the amount of free memory, this tells how fragmented the heap
+ * is: an allocation bigger than the returned size cannot succeed.  The
+ * free list of one bucket is walked, so the heap must be locked the
+ * same way as for allocations.
+ *
+ * @param heap Pointer to sys_heap
+ * @return Number of usable bytes in the largest free block
+ */
+size_t sys_heap_largest_free(struct sys_heap *heap);
+
 #endif
 
 /** @brief Initialize sys_heap
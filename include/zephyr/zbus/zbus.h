@@ -10,11 +10,16 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/sys/iterable_sections.h>
+#if defined(CONFIG_ZBUS_LOANED_MSG)
+#include <zephyr/net_buf.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+struct net_buf;
+
 /**
  * @brief Zbus API
  * @defgroup zbus_apis Zbus APIs
@@ -63,6 +68,25 @@ struct zbus_channel_data {
 	struct net_buf_pool *msg_subscriber_pool;
 #endif /* ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_ISOLATION */
 
+#if defined(CONFIG_ZBUS_LOANED_MSG) || defined(__DOXYGEN__)
+	/** Pool of the message buffers loaned to publishers. None unless set with
+	 * zbus_chan_set_loan_pool().
+	 */
+	struct net_buf_pool *loan_pool;
+
+	/** Last committed loaned buffer, holding the channel's message instead of the
+	 * message field of the channel when not NULL.
+	 */
+	struct net_buf *loan_buf;
+#endif /* CONFIG_ZBUS_LOANED_MSG */
+
+#if defined(CONFIG_ZBUS_SEQLOCK_CHANNEL) || defined(__DOXYGEN__)
+	/** Sequence number of the last message published to a seqlock channel. Its lowest bit
+	 * selects which of the two message copies holds the message.
+	 */
+	atomic_t seq;
+#endif /* CONFIG_ZBUS_SEQLOCK_CHANNEL */
+
 #if defined(CONFIG_ZBUS_CHANNEL_PUBLISH_STATS) || defined(__DOXYGEN__)
 	/** Kernel timestamp of the last publish action on this channel */
 	k_ticks_t publish_timestamp;
@@ -105,6 +129,13 @@ struct zbus_channel {
 	 */
 	bool (*validator)(const void *msg, size_t msg_size);
 
+#if defined(CONFIG_ZBUS_SEQLOCK_CHANNEL) || defined(__DOXYGEN__)
+	/** Seqlock channel flag. Such a channel keeps two copies of its message and is read
+	 * without being locked, see @ref ZBUS_CHAN_DEFINE_SEQLOCK.
+	 */
+	bool seqlock;
+#endif /* CONFIG_ZBUS_SEQLOCK_CHANNEL */
+
 	/** Mutable channel data struct. */
 	struct zbus_channel_data *data;
 };
@@ -270,7 +301,7 @@ struct zbus_channel_observation {
 #define _ZBUS_MESSAGE_NAME(_name) _CONCAT(_zbus_message_, _name)
 
 /* clang-format off */
-#define _ZBUS_CHAN_DEFINE(_name, _id, _type, _validator, _user_data)                               \
+#define _ZBUS_CHAN_DEFINE(_name, _id, _type, _validator, _user_data, _seqlock)                     \
 	static struct zbus_channel_data _CONCAT(_zbus_chan_data_, _name) = {                       \
 		.observers_start_idx = -1,                                                         \
 		.observers_end_idx = -1,                                                           \
@@ -289,6 +320,7 @@ struct zbus_channel_observation {
 		.message_size = sizeof(_type),                                                     \
 		.user_data = _user_data,                                                           \
 		.validator = _validator,                                                           \
+		IF_ENABLED(CONFIG_ZBUS_SEQLOCK_CHANNEL, (.seqlock = _seqlock,))                    \
 		.data = &_CONCAT(_zbus_chan_data_, _name),                                         \
 		IF_ENABLED(ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_ISOLATION,                             \
 			   (.msg_subscriber_pool = &_zbus_msg_subscribers_pool,))                  \
@@ -383,7 +415,7 @@ struct zbus_channel_observation {
  */
 #define ZBUS_CHAN_DEFINE(_name, _type, _validator, _user_data, _observers, _init_val)              \
 	static _type _ZBUS_MESSAGE_NAME(_name) = _init_val;                                        \
-	_ZBUS_CHAN_DEFINE(_name, ZBUS_CHAN_ID_INVALID, _type, _validator, _user_data);             \
+	_ZBUS_CHAN_DEFINE(_name, ZBUS_CHAN_ID_INVALID, _type, _validator, _user_data, false);      \
 	/* Extern declaration of observers */                                                      \
 	ZBUS_OBS_DECLARE(_observers);                                                              \
 	/* Create all channel observations from observers list */                                  \
@@ -407,7 +439,43 @@ struct zbus_channel_observation {
  */
 #define ZBUS_CHAN_DEFINE_WITH_ID(_name, _id, _type, _validator, _user_data, _observers, _init_val) \
 	static _type _ZBUS_MESSAGE_NAME(_name) = _init_val;                                        \
-	_ZBUS_CHAN_DEFINE(_name, _id, _type, _validator, _user_data);                              \
+	_ZBUS_CHAN_DEFINE(_name, _id, _type, _validator, _user_data, false);                       \
+	/* Extern declaration of observers */                                                      \
+	ZBUS_OBS_DECLARE(_observers);                                                              \
+	/* Create all channel observations from observers list */                                  \
+	FOR_EACH_FIXED_ARG_NONEMPTY_TERM(_ZBUS_CHAN_OBSERVATION, (;), _name, _observers)
+
+/**
+ * @brief Zbus seqlock channel definition.
+ *
+ * This macro defines a channel read without locking it, for a message published often by a
+ * single publisher and read by many threads, like a sensor sample. The channel keeps two copies
+ * of the message. Publishing fills the one readers are not told to read before switching them
+ * to it, and zbus_chan_read() copies the message without taking the channel's semaphore,
+ * retrying if it was published twice meanwhile. Readers never block, including the ones
+ * preempting the publisher, and the publisher never waits for them nor gets its priority
+ * boosted.
+ *
+ * The message of a seqlock channel must only be changed by publishing it. After claiming the
+ * channel, the message is read-only and zbus_chan_loan() is not supported.
+ *
+ * @note Available with @kconfig{CONFIG_ZBUS_SEQLOCK_CHANNEL}.
+ *
+ * @param _name The channel's name.
+ * @param _type The Message type. It must be a struct or union.
+ * @param _validator The validator function.
+ * @param _user_data A pointer to the user data.
+ *
+ * @see struct zbus_channel
+ * @param _observers The observers list. The sequence indicates the priority of the observer. The
+ * first the highest priority.
+ * @param _init_val The message initialization.
+ */
+#define ZBUS_CHAN_DEFINE_SEQLOCK(_name, _type, _validator, _user_data, _observers, _init_val)      \
+	BUILD_ASSERT(IS_ENABLED(CONFIG_ZBUS_SEQLOCK_CHANNEL),                                      \
+		     "CONFIG_ZBUS_SEQLOCK_CHANNEL is required");                                   \
+	static _type _ZBUS_MESSAGE_NAME(_name)[2] = {_init_val, _init_val};                        \
+	_ZBUS_CHAN_DEFINE(_name, ZBUS_CHAN_ID_INVALID, _type, _validator, _user_data, true);       \
 	/* Extern declaration of observers */                                                      \
 	ZBUS_OBS_DECLARE(_observers);                                                              \
 	/* Create all channel observations from observers list */                                  \
@@ -578,6 +646,9 @@ int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t
  *
  * This routine reads a message from a channel.
  *
+ * A channel defined with @ref ZBUS_CHAN_DEFINE_SEQLOCK is read without being locked, so the
+ * read never waits and @p timeout is ignored.
+ *
  * @param[in] chan The channel's reference.
  * @param[out] msg Reference to the message where the read function copies the channel's
  * message data to.
@@ -603,6 +674,9 @@ int zbus_chan_read(const struct zbus_channel *chan, void *msg, k_timeout_t timeo
  *
  * @warning This routine should only be called once before a zbus_chan_finish.
  *
+ * @note Claiming a channel defined with @ref ZBUS_CHAN_DEFINE_SEQLOCK does not block its readers,
+ * and its message must not be changed.
+ *
  * @param[in] chan The channel's reference.
  * @param[in] timeout Waiting period to claim the channel,
  *                or one of the special values K_NO_WAIT and K_FOREVER.
@@ -685,6 +759,20 @@ const struct zbus_channel *zbus_chan_from_id(uint32_t channel_id);
 
 #endif
 
+#if defined(CONFIG_ZBUS_SEQLOCK_CHANNEL)
+
+/** @cond INTERNAL_HIDDEN */
+
+/* Copy of a seqlock channel's message holding the message published with sequence number seq */
+static inline void *_zbus_chan_seqlock_msg(const struct zbus_channel *chan, atomic_val_t seq)
+{
+	return (uint8_t *)chan->message + (seq & 1) * chan->message_size;
+}
+
+/** @endcond */
+
+#endif /* CONFIG_ZBUS_SEQLOCK_CHANNEL */
+
 /**
  * @brief Get the reference for a channel message directly.
  *
@@ -701,6 +789,18 @@ static inline void *zbus_chan_msg(const struct zbus_channel *chan)
 {
 	__ASSERT(chan != NULL, "chan is required");
 
+#if defined(CONFIG_ZBUS_LOANED_MSG)
+	if (chan->data->loan_buf != NULL) {
+		return chan->data->loan_buf->data;
+	}
+#endif /* CONFIG_ZBUS_LOANED_MSG */
+
+#if defined(CONFIG_ZBUS_SEQLOCK_CHANNEL)
+	if (chan->seqlock) {
+		return _zbus_chan_seqlock_msg(chan, atomic_get(&chan->data->seq));
+	}
+#endif /* CONFIG_ZBUS_SEQLOCK_CHANNEL */
+
 	return chan->message;
 }
 
@@ -722,6 +822,18 @@ static inline const void *zbus_chan_const_msg(const struct zbus_channel *chan)
 {
 	__ASSERT(chan != NULL, "chan is required");
 
+#if defined(CONFIG_ZBUS_LOANED_MSG)
+	if (chan->data->loan_buf != NULL) {
+		return chan->data->loan_buf->data;
+	}
+#endif /* CONFIG_ZBUS_LOANED_MSG */
+
+#if defined(CONFIG_ZBUS_SEQLOCK_CHANNEL)
+	if (chan->seqlock) {
+		return _zbus_chan_seqlock_msg(chan, atomic_get(&chan->data->seq));
+	}
+#endif /* CONFIG_ZBUS_SEQLOCK_CHANNEL */
+
 	return chan->message;
 }
 
@@ -776,6 +888,111 @@ static inline void zbus_chan_set_msg_sub_pool(const struct zbus_channel *chan,
 
 #endif /* ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_ISOLATION */
 
+#if defined(CONFIG_ZBUS_LOANED_MSG) || defined(__DOXYGEN__)
+
+/**
+ * @brief Define a pool of loaned message buffers.
+ *
+ * This macro defines the pool of @p _count message buffers a channel of message type @p _type
+ * loans to its publishers, see zbus_chan_set_loan_pool(). A buffer is back in the pool once the
+ * publisher, the channel and every subscriber holding it have released it, so the pool needs
+ * at least two buffers: one holding the channel's message and one to publish the next message.
+ *
+ * @param _name The pool's name.
+ * @param _type The channel's message type.
+ * @param _count The number of message buffers.
+ */
+#define ZBUS_LOAN_POOL_DEFINE(_name, _type, _count)                                                \
+	NET_BUF_POOL_FIXED_DEFINE(_name, _count, sizeof(_type), 0, NULL)
+
+/**
+ * @brief Set the pool of the message buffers a channel loans to its publishers.
+ *
+ * This must be done before the first loan, and the pool must have been defined for the
+ * channel's message type with @ref ZBUS_LOAN_POOL_DEFINE.
+ *
+ * @param chan The channel's reference.
+ * @param pool The reference to the pool of message buffers.
+ */
+static inline void zbus_chan_set_loan_pool(const struct zbus_channel *chan,
+					   struct net_buf_pool *pool)
+{
+	__ASSERT(chan != NULL, "chan is required");
+	__ASSERT(pool != NULL, "pool is required");
+
+	chan->data->loan_pool = pool;
+}
+
+/**
+ * @brief Loan a message buffer from a channel.
+ *
+ * This routine hands a buffer of the channel's pool to the publisher, to build the next message
+ * in place: the message is at the buffer's data, of the channel's message size. The buffer is
+ * then published with zbus_chan_commit(), or released with zbus_msg_release().
+ *
+ * @param chan The channel's reference.
+ * @param[out] buf The loaned buffer's reference.
+ * @param timeout Waiting period for a buffer to be available,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Buffer loaned.
+ * @retval -ENOTSUP The channel has no pool of loaned buffers, or is a seqlock channel.
+ * @retval -ENOMEM No buffer available in the waiting period.
+ * @retval -EFAULT A parameter is incorrect. The function only returns this value when the
+ * @kconfig{CONFIG_ZBUS_ASSERT_MOCK} is enabled.
+ */
+int zbus_chan_loan(const struct zbus_channel *chan, struct net_buf **buf, k_timeout_t timeout);
+
+/**
+ * @brief Publish a loaned message buffer to a channel.
+ *
+ * This routine publishes the message built in a buffer loaned by zbus_chan_loan() without
+ * copying it. The buffer becomes the channel's message, read in place by the listeners, and
+ * message subscribers receive references to it instead of copies. It returns to the pool
+ * once the next message is published and all the subscribers released it.
+ *
+ * The reference to the buffer is handed over to the channel, even if this fails.
+ *
+ * @param chan The channel's reference.
+ * @param buf The loaned buffer's reference.
+ * @param timeout Waiting period to publish the channel,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Channel published.
+ * @retval -ENOMSG The message is invalid based on the validator function or some of the
+ * observers could not receive the notification.
+ * @retval -EBUSY The channel is busy.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EFAULT A parameter is incorrect, the notification could not be sent to one or more
+ * observer, or the function context is invalid (inside an ISR). The function only returns this
+ * value when the @kconfig{CONFIG_ZBUS_ASSERT_MOCK} is enabled.
+ */
+int zbus_chan_commit(const struct zbus_channel *chan, struct net_buf *buf, k_timeout_t timeout);
+
+/**
+ * @brief Read a channel's loaned message buffer.
+ *
+ * This routine gives a reference to the buffer holding the channel's message when it was
+ * published with zbus_chan_commit(), instead of copying the message. The message is at the
+ * buffer's data and must not be modified. The reference is released with zbus_msg_release().
+ *
+ * @param[in] chan The channel's reference.
+ * @param[out] buf The buffer's reference.
+ * @param[in] timeout Waiting period to read the channel,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Channel read.
+ * @retval -ENODATA The channel's message is not in a loaned buffer.
+ * @retval -EBUSY The channel is busy.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EFAULT A parameter is incorrect. The function only returns this value when the
+ * @kconfig{CONFIG_ZBUS_ASSERT_MOCK} is enabled.
+ */
+int zbus_chan_read_ref(const struct zbus_channel *chan, struct net_buf **buf,
+		       k_timeout_t timeout);
+
+#endif /* CONFIG_ZBUS_LOANED_MSG */
+
 #if defined(CONFIG_ZBUS_CHANNEL_PUBLISH_STATS) || defined(__DOXYGEN__)
 
 /**
@@ -1068,8 +1285,46 @@ int zbus_sub_wait(const struct zbus_observer *sub, const struct zbus_channel **c
 int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel **chan, void *msg,
 		      k_timeout_t timeout);
 
+/**
+ * @brief Wait for a reference to a channel message.
+ *
+ * This routine works as zbus_sub_wait_msg(), but gives a reference to the buffer holding the
+ * message instead of copying it. The message is at the buffer's data and must not be modified.
+ * With @kconfig{CONFIG_ZBUS_LOANED_MSG}, messages published with zbus_chan_commit() are not
+ * copied at all on their way to the subscriber. The reference is released with
+ * zbus_msg_release().
+ *
+ * @param[in] sub The subscriber's reference.
+ * @param[out] chan The notification channel's reference.
+ * @param[out] buf The reference to the buffer holding the message.
+ * @param[in] timeout Waiting period for a notification arrival,
+ *                or one of the special values, K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message received.
+ * @retval -ENOMSG Could not retrieve the net_buf from the subscriber FIFO.
+ * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
+ * function only returns this value when the @kconfig{CONFIG_ZBUS_ASSERT_MOCK} is enabled.
+ */
+int zbus_sub_wait_msg_ref(const struct zbus_observer *sub, const struct zbus_channel **chan,
+			  struct net_buf **buf, k_timeout_t timeout);
+
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
+#if defined(CONFIG_ZBUS_LOANED_MSG) || defined(CONFIG_ZBUS_MSG_SUBSCRIBER) || defined(__DOXYGEN__)
+
+/**
+ * @brief Release a reference to a message buffer.
+ *
+ * This routine releases a reference given by zbus_chan_loan(), zbus_chan_read_ref() or
+ * zbus_sub_wait_msg_ref(). Loaned buffers are shared by several threads, so their references
+ * must be released with this routine rather than with net_buf_unref().
+ *
+ * @param buf The buffer's reference.
+ */
+void zbus_msg_release(struct net_buf *buf);
+
+#endif /* CONFIG_ZBUS_LOANED_MSG || CONFIG_ZBUS_MSG_SUBSCRIBER */
+
 /**
  *
  * @brief Iterate over channels.
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_KERNEL_INCLUDE_TIMEOUT_WHEEL_H_
+#define ZEPHYR_KERNEL_INCLUDE_TIMEOUT_WHEEL_H_
+
+/**
+ * @file
+ * @brief Hierarchical timer wheel backend for the kernel timeout queue
+ *
+ * Timeouts are stored by absolute expiry tick (kept in the
+ * struct _timeout dticks field) in a set of wheels of
+ * Z_TIMEOUT_WHEEL_SLOTS slots each.  Level N holds timeouts whose expiry
+ * differs from the wheel base tick in bits [N * Z_TIMEOUT_WHEEL_BITS,
+ * (N + 1) * Z_TIMEOUT_WHEEL_BITS), anything further away sits on an
+ * unsorted overflow list.  When the base crosses a slot boundary the
+ * matching slot of the upper level is cascaded down, so that insertion
+ * and removal are O(1) while the expiry order (including FIFO order of
+ * timeouts expiring on the same tick) matches the delta list exactly.
+ *
+ * All functions must be called with the owning timeout lock held.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/dlist.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define Z_TIMEOUT_WHEEL_BITS   6
+#define Z_TIMEOUT_WHEEL_SLOTS  BIT(Z_TIMEOUT_WHEEL_BITS)
+#define Z_TIMEOUT_WHEEL_LEVELS CONFIG_TIMEOUT_QUEUE_WHEEL_LEVELS
+
+struct z_timeout_wheel_level {
+	/* Bit N is set when slots[N] is initialized and not empty */
+	uint64_t bitmap;
+	sys_dlist_t slots[Z_TIMEOUT_WHEEL_SLOTS];
+};
+
+struct z_timeout_wheel {
+	/* Tick all slot positions are computed against */
+	uint64_t base;
+	/* Cached earliest timeout, only meaningful when first_valid */
+	struct _timeout *first;
+	bool first_valid;
+	struct z_timeout_wheel_level levels[Z_TIMEOUT_WHEEL_LEVELS];
+	/* Timeouts too far away for the highest level */
+	sys_dlist_t overflow;
+};
+
+/**
+ * @brief Statically initialize an empty timer wheel with a base of 0
+ *
+ * @param obj Timer wheel being defined
+ */
+#define Z_TIMEOUT_WHEEL_INITIALIZER(obj)				\
+	{								\
+		.first_valid = true,					\
+		.overflow = SYS_DLIST_STATIC_INIT(&(obj).overflow),	\
+	}
+
+/**
+ * @brief Initialize an empty timer wheel
+ *
+ * @param w Timer wheel
+ * @param base Current tick
+ */
+void z_timeout_wheel_init(struct z_timeout_wheel *w, uint64_t base);
+
+/**
+ * @brief Add a timeout to the wheel
+ *
+ * @param w Timer wheel
+ * @param to Timeout, with its dticks field set to the absolute expiry
+ *	     tick, which must not be earlier than the wheel base
+ */
+void z_timeout_wheel_insert(struct z_timeout_wheel *w, struct _timeout *to);
+
+/**
+ * @brief Remove a pending timeout from the wheel
+ *
+ * @param w Timer wheel
+ * @param to Timeout previously added with z_timeout_wheel_insert()
+ */
+void z_timeout_wheel_remove(struct z_timeout_wheel *w, struct _timeout *to);
+
+/**
+ * @brief Get the timeout that expires first
+ *
+ * Among timeouts expiring on the same tick, the one inserted first is
+ * returned.
+ *
+ * @param w Timer wheel
+ *
+ * @return Earliest pending timeout, or NULL if the wheel is empty
+ */
+struct _timeout *z_timeout_wheel_first(struct z_timeout_wheel *w);
+
+/**
+ * @brief Move the wheel base forward
+ *
+ * No pending timeout may expire before @a tick.
+ *
+ * @param w Timer wheel
+ * @param tick New base tick
+ */
+void z_timeout_wheel_advance(struct z_timeout_wheel *w, uint64_t tick);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_KERNEL_INCLUDE_TIMEOUT_WHEEL_H_ */
@@ -12,10 +12,225 @@
 #include <ksched.h>
 #include <wait_q.h>
 
+/* Release the heap lock, letting the threads waiting for memory retry */
+static void heap_unlock_wake(struct k_heap *heap, k_spinlock_key_t key)
+{
+	if (IS_ENABLED(CONFIG_MULTITHREADING) && (z_unpend_all(&heap->wait_q) != 0)) {
+		z_reschedule(&heap->lock, key);
+	} else {
+		k_spin_unlock(&heap->lock, key);
+	}
+}
+
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+BUILD_ASSERT(IS_POWER_OF_TWO(CONFIG_K_HEAP_CPU_CACHE_MAX_SIZE),
+	     "CONFIG_K_HEAP_CPU_CACHE_MAX_SIZE must be a power of two");
+
+#define CACHE_MIN_SHIFT 3
+
+static inline size_t cache_class_size(int cls)
+{
+	return BIT(cls + CACHE_MIN_SHIFT);
+}
+
+/* Smallest class an allocation of @a bytes fits in */
+static inline int cache_class_alloc(size_t bytes)
+{
+	return (bytes <= BIT(CACHE_MIN_SHIFT)) ? 0 :
+	       LOG2CEIL(bytes) - CACHE_MIN_SHIFT;
+}
+
+/* Largest class a block of @a bytes usable bytes can serve, or -1 */
+static inline int cache_class_free(size_t bytes)
+{
+	if ((bytes < BIT(CACHE_MIN_SHIFT)) ||
+	    (bytes >= 2 * CONFIG_K_HEAP_CPU_CACHE_MAX_SIZE)) {
+		return -1;
+	}
+
+	return LOG2(bytes) - CACHE_MIN_SHIFT;
+}
+
+static void *cache_pop(struct z_heap_cpu_cache *cache, int cls)
+{
+	void *mem = cache->blocks[cls];
+
+	if (mem != NULL) {
+		cache->blocks[cls] = *(void **)mem;
+		cache->count[cls]--;
+		cache->bytes -= cache_class_size(cls);
+	}
+
+	return mem;
+}
+
+static void cache_push(struct z_heap_cpu_cache *cache, int cls, void *mem)
+{
+	*(void **)mem = cache->blocks[cls];
+	cache->blocks[cls] = mem;
+	cache->count[cls]++;
+	cache->bytes += cache_class_size(cls);
+}
+
+/* Take a block of class @a cls from the cache of the current CPU, refilling
+ * the cache with a batch of blocks from the heap when it is empty.
+ */
+static void *cache_get(struct k_heap *heap, int cls)
+{
+	struct z_heap_cpu_cache *cache;
+	void *batch = NULL;
+	k_spinlock_key_t key;
+	unsigned int irq_key;
+	void *mem;
+
+	/* Keeps us on this CPU, the cache lock only guards against the
+	 * other CPUs flushing it.
+	 */
+	irq_key = arch_irq_lock();
+	cache = &heap->cpu_cache[arch_curr_cpu()->id];
+
+	key = k_spin_lock(&cache->lock);
+	mem = cache_pop(cache, cls);
+	if (mem != NULL) {
+		cache->hits++;
+	} else {
+		cache->misses++;
+	}
+	k_spin_unlock(&cache->lock, key);
+
+	if (mem == NULL) {
+		key = k_spin_lock(&heap->lock);
+		for (int i = 0; i < CONFIG_K_HEAP_CPU_CACHE_BATCH; i++) {
+			void *block = sys_heap_aligned_alloc(&heap->heap,
+							     sizeof(void *),
+							     cache_class_size(cls));
+
+			if (block == NULL) {
+				break;
+			}
+
+			*(void **)block = batch;
+			batch = block;
+		}
+		k_spin_unlock(&heap->lock, key);
+
+		if (batch != NULL) {
+			mem = batch;
+			batch = *(void **)batch;
+
+			key = k_spin_lock(&cache->lock);
+			while (batch != NULL) {
+				void *next = *(void **)batch;
+
+				cache_push(cache, cls, batch);
+				batch = next;
+			}
+			k_spin_unlock(&cache->lock, key);
+		}
+	}
+
+	arch_irq_unlock(irq_key);
+
+	return mem;
+}
+
+/* Put a freed block in the cache of the current CPU, returning a batch of
+ * the least recently freed blocks to the heap when the cache is full.
+ */
+static bool cache_put(struct k_heap *heap, void *mem)
+{
+	struct z_heap_cpu_cache *cache;
+	void *spill = NULL;
+	k_spinlock_key_t key;
+	unsigned int irq_key;
+	int cls;
+
+	/* Blocks allocated with a smaller alignment than the cache ones */
+	if (((uintptr_t)mem & (sizeof(void *) - 1)) != 0) {
+		return false;
+	}
+
+	cls = cache_class_free(sys_heap_usable_size(&heap->heap, mem));
+	if (cls < 0) {
+		return false;
+	}
+
+	irq_key = arch_irq_lock();
+	cache = &heap->cpu_cache[arch_curr_cpu()->id];
+
+	key = k_spin_lock(&cache->lock);
+
+	if (atomic_get(&heap->cache_waiters) != 0) {
+		k_spin_unlock(&cache->lock, key);
+		arch_irq_unlock(irq_key);
+		return false;
+	}
+
+	if (cache->count[cls] == CONFIG_K_HEAP_CPU_CACHE_DEPTH) {
+		void **last = &cache->blocks[cls];
+
+		for (int i = 0;
+		     i < CONFIG_K_HEAP_CPU_CACHE_DEPTH - CONFIG_K_HEAP_CPU_CACHE_BATCH;
+		     i++) {
+			last = (void **)*last;
+		}
+
+		spill = *last;
+		*last = NULL;
+		cache->count[cls] -= CONFIG_K_HEAP_CPU_CACHE_BATCH;
+		cache->bytes -= CONFIG_K_HEAP_CPU_CACHE_BATCH * cache_class_size(cls);
+	}
+
+	cache_push(cache, cls, mem);
+
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq_key);
+
+	/* The spilled blocks are off the cache, any CPU can free them. Like
+	 * any other free, this may satisfy a waiting allocation.
+	 */
+	if (spill != NULL) {
+		key = k_spin_lock(&heap->lock);
+		while (spill != NULL) {
+			void *next = *(void **)spill;
+
+			sys_heap_free(&heap->heap, spill);
+			spill = next;
+		}
+		heap_unlock_wake(heap, key);
+	}
+
+	return true;
+}
+
+/* Return the blocks cached by all CPUs to the heap, with its lock held */
+static void cache_flush(struct k_heap *heap)
+{
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		struct z_heap_cpu_cache *cache = &heap->cpu_cache[cpu];
+		k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+		for (int cls = 0; cls < Z_HEAP_CACHE_CLASSES; cls++) {
+			void *mem;
+
+			while ((mem = cache_pop(cache, cls)) != NULL) {
+				sys_heap_free(&heap->heap, mem);
+			}
+		}
+
+		k_spin_unlock(&cache->lock, key);
+	}
+}
+#endif /* CONFIG_K_HEAP_CPU_CACHE */
+
 void k_heap_init(struct k_heap *heap, void *mem, size_t bytes)
 {
 	z_waitq_init(&heap->wait_q);
 	sys_heap_init(&heap->heap, mem, bytes);
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+	(void)memset(heap->cpu_cache, 0, sizeof(heap->cpu_cache));
+	atomic_clear(&heap->cache_waiters);
+#endif
 
 	SYS_PORT_TRACING_OBJ_INIT(k_heap, heap);
 }
@@ -68,6 +283,21 @@ void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 	k_timepoint_t end = sys_timepoint_calc(timeout);
 	void *ret = NULL;
 
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+	bool cache_flushed = false;
+
+	if ((align <= sizeof(void *)) && (bytes > 0) &&
+	    (bytes <= CONFIG_K_HEAP_CPU_CACHE_MAX_SIZE)) {
+		ret = cache_get(heap, cache_class_alloc(bytes));
+		if (ret != NULL) {
+			SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, heap, timeout);
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, heap,
+						       timeout, ret);
+			return ret;
+		}
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&heap->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, heap, timeout);
@@ -79,6 +309,18 @@ void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 	while (ret == NULL) {
 		ret = sys_heap_aligned_alloc(&heap->heap, align, bytes);
 
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+		if ((ret == NULL) && !cache_flushed) {
+			/* Frees from now on bypass the caches, so that they
+			 * wake us up, and the cached blocks may make it fit.
+			 */
+			cache_flushed = true;
+			atomic_inc(&heap->cache_waiters);
+			cache_flush(heap);
+			continue;
+		}
+#endif
+
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
 		    (ret != NULL) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 			break;
@@ -101,6 +343,12 @@ void *k_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t bytes,
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, heap, timeout, ret);
 
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+	if (cache_flushed) {
+		atomic_dec(&heap->cache_waiters);
+	}
+#endif
+
 	k_spin_unlock(&heap->lock, key);
 	return ret;
 }
@@ -139,6 +387,9 @@ void *k_heap_realloc(struct k_heap *heap, void *ptr, size_t bytes, k_timeout_t t
 {
 	k_timepoint_t end = sys_timepoint_calc(timeout);
 	void *ret = NULL;
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+	bool cache_flushed = false;
+#endif
 
 	k_spinlock_key_t key = k_spin_lock(&heap->lock);
 
@@ -149,6 +400,16 @@ void *k_heap_realloc(struct k_heap *heap, void *ptr, size_t bytes, k_timeout_t t
 	while (ret == NULL) {
 		ret = sys_heap_aligned_realloc(&heap->heap, ptr, sizeof(void *), bytes);
 
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+		if ((ret == NULL) && (bytes > 0) && !cache_flushed) {
+			/* Same as in k_heap_aligned_alloc() */
+			cache_flushed = true;
+			atomic_inc(&heap->cache_waiters);
+			cache_flush(heap);
+			continue;
+		}
+#endif
+
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
 		    (ret != NULL) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 			break;
@@ -161,20 +422,59 @@ void *k_heap_realloc(struct k_heap *heap, void *ptr, size_t bytes, k_timeout_t t
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, realloc, heap, ptr, bytes, timeout, ret);
 
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+	if (cache_flushed) {
+		atomic_dec(&heap->cache_waiters);
+	}
+#endif
+
 	k_spin_unlock(&heap->lock, key);
 	return ret;
 }
 
 void k_heap_free(struct k_heap *heap, void *mem)
 {
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+	if ((mem != NULL) && cache_put(heap, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, heap);
+		return;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&heap->lock);
 
 	sys_heap_free(&heap->heap, mem);
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, heap);
-	if (IS_ENABLED(CONFIG_MULTITHREADING) && (z_unpend_all(&heap->wait_q) != 0)) {
-		z_reschedule(&heap->lock, key);
-	} else {
-		k_spin_unlock(&heap->lock, key);
+	heap_unlock_wake(heap, key);
+}
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+int k_heap_runtime_stats_get(struct k_heap *heap, struct sys_memory_stats *stats)
+{
+	k_spinlock_key_t key;
+	int ret;
+
+	if ((heap == NULL) || (stats == NULL)) {
+		return -EINVAL;
 	}
+
+	key = k_spin_lock(&heap->lock);
+	ret = sys_heap_runtime_stats_get(&heap->heap, stats);
+	k_spin_unlock(&heap->lock, key);
+
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		struct z_heap_cpu_cache *cache = &heap->cpu_cache[cpu];
+
+		key = k_spin_lock(&cache->lock);
+		stats->cached_bytes += cache->bytes;
+		stats->cache_hits += cache->hits;
+		stats->cache_misses += cache->misses;
+		k_spin_unlock(&cache->lock, key);
+	}
+#endif
+
+	return ret;
 }
+#endif /* CONFIG_SYS_HEAP_RUNTIME_STATS */
@@ -33,6 +33,9 @@ static int k_mem_slab_stats_raw(struct k_obj_core *obj_core, void *stats)
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
 	memcpy(stats, &slab->info, sizeof(slab->info));
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	((struct k_mem_slab_info *)stats)->num_used -= z_mem_slab_num_cached(slab);
+#endif
 	k_spin_unlock(&slab->lock, key);
 
 	return 0;
@@ -45,12 +48,14 @@ static int k_mem_slab_stats_query(struct k_obj_core *obj_core, void *stats)
 	struct k_mem_slab *slab;
 	k_spinlock_key_t   key;
 	struct sys_memory_stats *ptr = stats;
+	uint32_t num_used;
 
 	slab = CONTAINER_OF(obj_core, struct k_mem_slab, obj_core);
 	key = k_spin_lock(&slab->lock);
-	ptr->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
+	num_used = k_mem_slab_num_used_get(slab);
+	ptr->free_bytes = (slab->info.num_blocks - num_used) *
 			  slab->info.block_size;
-	ptr->allocated_bytes = slab->info.num_used * slab->info.block_size;
+	ptr->allocated_bytes = num_used * slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	ptr->max_allocated_bytes = slab->info.max_used * slab->info.block_size;
 #else
@@ -179,6 +184,11 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->info.num_used = 0U;
 	slab->lock = (struct k_spinlock) {};
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	memset(slab->cpu_cache, 0, sizeof(slab->cpu_cache));
+	atomic_clear(&slab->cache_waiters);
+#endif
+
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	slab->info.max_used = 0U;
 #endif /* CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION */
@@ -218,13 +228,195 @@ static bool slab_ptr_is_good(struct k_mem_slab *slab, const void *ptr)
 	       ((offset % slab->info.block_size) == 0);
 }
 
+/* Hands a free block over to the first waiting thread, or else puts it
+ * back on the free list.  Returns true if a thread was made ready.
+ */
+static bool free_block_locked(struct k_mem_slab *slab, char *mem)
+{
+	if (unlikely(slab->free_list == NULL) && IS_ENABLED(CONFIG_MULTITHREADING)) {
+		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
+
+		if (unlikely(pending_thread != NULL)) {
+			z_thread_return_value_set_with_data(pending_thread, 0, mem);
+			z_ready_thread(pending_thread);
+			return true;
+		}
+	}
+	*(char **) mem = slab->free_list;
+	slab->free_list = mem;
+	slab->info.num_used--;
+
+	return false;
+}
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+uint32_t z_mem_slab_num_cached(struct k_mem_slab *slab)
+{
+	uint32_t count = 0;
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		count += slab->cpu_cache[cpu].count;
+	}
+
+	return count;
+}
+
+/* Take a block from the cache of the current CPU, refilling it from the
+ * shared free list when it is empty.
+ */
+static void *cache_get(struct k_mem_slab *slab)
+{
+	struct z_mem_slab_cpu_cache *cache;
+	k_spinlock_key_t slab_key;
+	k_spinlock_key_t key;
+	unsigned int irq_key;
+	char *mem = NULL;
+
+	/* Keeps us on this CPU, the cache lock only guards against the
+	 * other CPUs flushing it.
+	 */
+	irq_key = arch_irq_lock();
+	cache = &slab->cpu_cache[arch_curr_cpu()->id];
+
+	key = k_spin_lock(&cache->lock);
+	if (cache->count > 0) {
+		mem = cache->blocks[--cache->count];
+	}
+	k_spin_unlock(&cache->lock, key);
+
+	if ((mem == NULL) && (slab->free_list != NULL)) {
+		slab_key = k_spin_lock(&slab->lock);
+		key = k_spin_lock(&cache->lock);
+
+		for (int i = 0; (i < CONFIG_MEM_SLAB_CPU_CACHE_BATCH) &&
+				(slab->free_list != NULL); i++) {
+			if (mem != NULL) {
+				cache->blocks[cache->count++] = mem;
+			}
+			mem = slab->free_list;
+			slab->free_list = *(char **)mem;
+			slab->info.num_used++;
+		}
+
+		k_spin_unlock(&cache->lock, key);
+		k_spin_unlock(&slab->lock, slab_key);
+	}
+
+	arch_irq_unlock(irq_key);
+
+	return mem;
+}
+
+/* Keep a freed block in the cache of the current CPU, unless a thread
+ * is about to wait for one.  Returns false if the block was not taken.
+ */
+static bool cache_put(struct k_mem_slab *slab, char *mem)
+{
+	struct z_mem_slab_cpu_cache *cache;
+	char *spill[CONFIG_MEM_SLAB_CPU_CACHE_BATCH];
+	k_spinlock_key_t key;
+	unsigned int irq_key;
+	bool woken = false;
+	int n = 0;
+
+	irq_key = arch_irq_lock();
+	cache = &slab->cpu_cache[arch_curr_cpu()->id];
+
+	key = k_spin_lock(&cache->lock);
+
+	if (atomic_get(&slab->cache_waiters) != 0) {
+		k_spin_unlock(&cache->lock, key);
+		arch_irq_unlock(irq_key);
+		return false;
+	}
+
+	if (cache->count == ARRAY_SIZE(cache->blocks)) {
+		/* Spill the least recently freed ones */
+		n = ARRAY_SIZE(spill);
+		memcpy(spill, cache->blocks, sizeof(spill));
+		cache->count -= n;
+		memmove(cache->blocks, &cache->blocks[n],
+			cache->count * sizeof(cache->blocks[0]));
+	}
+
+	cache->blocks[cache->count++] = mem;
+
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq_key);
+
+	/* Spilled blocks still go to waiters first, in case one showed up
+	 * since we checked.
+	 */
+	if (n > 0) {
+		key = k_spin_lock(&slab->lock);
+		while (n > 0) {
+			woken |= free_block_locked(slab, spill[--n]);
+		}
+
+		if (woken) {
+			z_reschedule(&slab->lock, key);
+		} else {
+			k_spin_unlock(&slab->lock, key);
+		}
+	}
+
+	return true;
+}
+
+/* Return the blocks cached by all CPUs to the slab, called with the slab
+ * lock held.  Returns true if a waiting thread was made ready.
+ */
+static bool cache_flush(struct k_mem_slab *slab)
+{
+	bool woken = false;
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		struct z_mem_slab_cpu_cache *cache = &slab->cpu_cache[cpu];
+		k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+		while (cache->count > 0) {
+			woken |= free_block_locked(slab, cache->blocks[--cache->count]);
+		}
+
+		k_spin_unlock(&cache->lock, key);
+	}
+
+	return woken;
+}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	bool waiting = false;
+	bool woken = false;
+
+	*mem = cache_get(slab);
+	if (*mem != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+
+		return 0;
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 	int result;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (slab->free_list == NULL) {
+		/* Blocks freed from now on bypass the caches, so that they
+		 * wake us up, and the ones already cached get back to the
+		 * free list, or to the threads already waiting.
+		 */
+		atomic_inc(&slab->cache_waiters);
+		waiting = true;
+		woken = cache_flush(slab);
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	if (slab->free_list != NULL) {
 		/* take a free block */
 		*mem = slab->free_list;
@@ -255,6 +447,10 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 			*mem = _current->base.swap_data;
 		}
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+		atomic_dec(&slab->cache_waiters);
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
 
 		return result;
@@ -262,6 +458,17 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (waiting) {
+		atomic_dec(&slab->cache_waiters);
+	}
+
+	if (woken) {
+		z_reschedule(&slab->lock, key);
+		return result;
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	k_spin_unlock(&slab->lock, key);
 
 	return result;
@@ -275,24 +482,23 @@ void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
 		return;
 	}
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (cache_put(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
+	}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
-	if (unlikely(slab->free_list == NULL) && IS_ENABLED(CONFIG_MULTITHREADING)) {
-		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
-
-		if (unlikely(pending_thread != NULL)) {
-			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+	if (free_block_locked(slab, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 
-			z_thread_return_value_set_with_data(pending_thread, 0, mem);
-			z_ready_thread(pending_thread);
-			z_reschedule(&slab->lock, key);
-			return;
-		}
+		z_reschedule(&slab->lock, key);
+		return;
 	}
-	*(char **) mem = slab->free_list;
-	slab->free_list = (char *) mem;
-	slab->info.num_used--;
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 
@@ -306,9 +512,10 @@ int k_mem_slab_runtime_stats_get(struct k_mem_slab *slab, struct sys_memory_stat
 	}
 
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	uint32_t num_used = k_mem_slab_num_used_get(slab);
 
-	stats->allocated_bytes = slab->info.num_used * slab->info.block_size;
-	stats->free_bytes = (slab->info.num_blocks - slab->info.num_used) *
+	stats->allocated_bytes = num_used * slab->info.block_size;
+	stats->free_bytes = (slab->info.num_blocks - num_used) *
 			    slab->info.block_size;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	stats->max_allocated_bytes = slab->info.max_used *
@@ -59,6 +59,8 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
 	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_CPU_RUNQ)
+	return &_kernel.cpus[thread->base.runq_cpu].ready_q.runq;
 #else
 	ARG_UNUSED(thread);
 	return &_kernel.ready_q.runq;
@@ -67,17 +69,149 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_CPU_RUNQ)
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_CPU_RUNQ */
+}
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+/* CPUs whose run queue is not empty, so that scheduling only looks at
+ * those.  Protected by _sched_spinlock like the run queues.
+ */
+static uint32_t runq_busy_cpus;
+
+BUILD_ASSERT(CONFIG_MP_MAX_NUM_CPUS <= 32, "runq_busy_cpus is 32 bits wide");
+
+static inline bool runq_cpu_allowed(struct k_thread *thread, int cpu)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	return (thread->base.cpu_mask & BIT(cpu)) != 0;
+#else
+	ARG_UNUSED(thread);
+	ARG_UNUSED(cpu);
+	return true;
+#endif /* CONFIG_SCHED_CPU_MASK */
+}
+
+static inline void runq_queued_inc(int cpu)
+{
+	_kernel.cpus[cpu].ready_q.queued++;
+	runq_busy_cpus |= BIT(cpu);
+}
+
+static inline void runq_queued_dec(int cpu)
+{
+	if (--_kernel.cpus[cpu].ready_q.queued == 0U) {
+		runq_busy_cpus &= ~BIT(cpu);
+	}
+}
+
+/* Whether the CPU runs the thread right away, being idle with nothing
+ * queued or running a thread it preempts.
+ */
+static inline bool runq_cpu_runs(struct k_thread *thread, int cpu)
+{
+	struct _cpu *c = &_kernel.cpus[cpu];
+	struct k_thread *curr = c->current;
+
+	/* Skip CPUs not started, as ipi_mask_create() does */
+	if ((curr == NULL) || !runq_cpu_allowed(thread, cpu)) {
+		return false;
+	}
+
+	if (z_is_idle_thread_object(curr)) {
+		return c->ready_q.queued == 0U;
+	}
+
+	return thread_is_preemptible(curr) && (z_sched_prio_cmp(thread, curr) > 0);
+}
+
+/* Choose the CPU whose run queue gets a thread made ready.  Prefer
+ * the CPU it last ran on, whose cache may still hold its data, if it
+ * runs there right away.  Else prefer an idle CPU, then the CPU running
+ * the lowest priority thread it preempts.  A thread preempting none
+ * waits on the CPU it last ran on, from which another CPU may still
+ * take it, and *waits is set.
+ */
+static int runq_cpu_pick(struct k_thread *thread, bool *waits)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	int last = thread->base.cpu;
+	int lowest = -1;
+
+	*waits = false;
+
+	if ((last < num_cpus) && runq_cpu_runs(thread, last)) {
+		return last;
+	}
+
+	for (int i = 0; i < num_cpus; i++) {
+		struct k_thread *curr = _kernel.cpus[i].current;
+
+		if ((i == last) || !runq_cpu_runs(thread, i)) {
+			continue;
+		}
+
+		if (z_is_idle_thread_object(curr)) {
+			return i;
+		}
+
+		if ((lowest < 0) ||
+		    (z_sched_prio_cmp(_kernel.cpus[lowest].current, curr) > 0)) {
+			lowest = i;
+		}
+	}
+
+	if (lowest >= 0) {
+		return lowest;
+	}
+
+	*waits = true;
+
+	if ((last < num_cpus) && runq_cpu_allowed(thread, last)) {
+		return last;
+	}
+
+	for (int i = 0; i < num_cpus; i++) {
+		if (runq_cpu_allowed(thread, i)) {
+			return i;
+		}
+	}
+
+	return 0;
 }
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	bool waits;
+	int cpu = runq_cpu_pick(thread, &waits);
+
+	thread->base.runq_cpu = cpu;
+	runq_queued_inc(cpu);
+
+	/* Only a thread left waiting can be pulled by balancing, the
+	 * others do not need the time they were queued at.
+	 */
+	if (waits) {
+		thread->base.runq_time = k_cycle_get_32();
+	}
+
+	/* An idle CPU would not notice it.  A thread left waiting does
+	 * not preempt anything, so its CPU needs no IPI.  This is the
+	 * only IPI sent for a thread made ready, rather than one to
+	 * every CPU it could preempt.
+	 */
+	if (!waits && (cpu != _current_cpu->id)) {
+		flag_ipi(IPI_CPU_MASK(cpu));
+	}
+#endif /* CONFIG_SCHED_CPU_RUNQ */
+
 	_priq_run_add(thread_runq(thread), thread);
 }
 
@@ -86,6 +220,10 @@ static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 	__ASSERT_NO_MSG(!z_is_idle_thread_object(thread));
 
 	_priq_run_remove(thread_runq(thread), thread);
+
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	runq_queued_dec(thread->base.runq_cpu);
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 }
 
 static ALWAYS_INLINE void runq_yield(void)
@@ -93,9 +231,100 @@ static ALWAYS_INLINE void runq_yield(void)
 	_priq_run_yield(curr_cpu_runq());
 }
 
+#ifdef CONFIG_SCHED_CPU_RUNQ
+/* Pull a thread waiting on CPU from, the one with the most queued
+ * threads, when it has at least two more than the current CPU, so that
+ * threads of equal priority spread over the CPUs.  Done at most once
+ * per balancing interval, and not for a thread still cache hot.  The
+ * cycle counter is only read when there is a queue to pull from.
+ * Returns true if a thread was pulled.
+ */
+static bool runq_balance(int from)
+{
+	int self = _current_cpu->id;
+	struct _ready_q *local = &_current_cpu->ready_q;
+	struct _ready_q *busiest = &_kernel.cpus[from].ready_q;
+	struct k_thread *thread;
+	uint32_t now;
+
+	if (busiest->queued < (local->queued + 2U)) {
+		return false;
+	}
+
+	now = k_cycle_get_32();
+	if ((now - local->balanced) <
+	    k_us_to_cyc_ceil32(CONFIG_SCHED_CPU_RUNQ_BALANCE_INTERVAL_US)) {
+		return false;
+	}
+	local->balanced = now;
+
+	/* With CONFIG_SCHED_CPU_MASK, only a thread allowed here.  A
+	 * thread that runs on its CPU right away is not waiting.
+	 */
+	thread = _priq_run_best(&busiest->runq);
+	if ((thread == NULL) || runq_cpu_runs(thread, from) ||
+	    ((now - thread->base.runq_time) <
+	     k_us_to_cyc_ceil32(CONFIG_SCHED_CPU_RUNQ_MIGRATION_COST_US))) {
+		return false;
+	}
+
+	_priq_run_remove(&busiest->runq, thread);
+	runq_queued_dec(from);
+
+	thread->base.runq_cpu = self;
+	_priq_run_add(&local->runq, thread);
+	runq_queued_inc(self);
+
+	return true;
+}
+#endif /* CONFIG_SCHED_CPU_RUNQ */
+
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_CPU_RUNQ
+	struct k_thread *best = _priq_run_best(curr_cpu_runq());
+	struct k_thread *other = NULL;
+	uint32_t busy = runq_busy_cpus & ~BIT(_current_cpu->id);
+	int busiest = -1;
+
+	/* The best thread queued anywhere runs, as with a single run
+	 * queue, but ties are left to the CPU they are queued on.  A
+	 * CPU with nothing queued steals rather than going idle.  A
+	 * single pass over the non-empty queues, with the scheduler lock
+	 * held, finds both that thread and the queue to balance from.
+	 */
+	while (busy != 0U) {
+		int i = u32_count_trailing_zeros(busy);
+		struct _ready_q *ready_q = &_kernel.cpus[i].ready_q;
+		struct k_thread *thread;
+
+		busy &= busy - 1U;
+
+		thread = _priq_run_best(&ready_q->runq);
+		if ((thread != NULL) &&
+		    ((other == NULL) || (z_sched_prio_cmp(thread, other) > 0))) {
+			other = thread;
+		}
+
+		if ((busiest < 0) ||
+		    (ready_q->queued > _kernel.cpus[busiest].ready_q.queued)) {
+			busiest = i;
+		}
+	}
+
+	if ((busiest >= 0) && runq_balance(busiest)) {
+		best = _priq_run_best(curr_cpu_runq());
+	}
+
+	if ((other != NULL) &&
+	    ((best == NULL) || (z_sched_prio_cmp(other, best) > 0))) {
+		best = other;
+	}
+
+	return best;
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif /* CONFIG_SCHED_CPU_RUNQ */
 }
 
 /* _current is never in the run queue until context switch on
@@ -350,7 +579,9 @@ static void ready_thread(struct k_thread *thread)
 		queue_thread(thread);
 		update_cache(0);
 
+#ifndef CONFIG_SCHED_CPU_RUNQ
 		flag_ipi(ipi_mask_create(thread));
+#endif /* !CONFIG_SCHED_CPU_RUNQ */
 	}
 }
 
@@ -932,13 +1163,13 @@ void init_ready_q(struct _ready_q *ready_q)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_CPU_RUNQ)
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
 #else
 	init_ready_q(&_kernel.ready_q);
-#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY */
+#endif /* CONFIG_SCHED_CPU_MASK_PIN_ONLY || CONFIG_SCHED_CPU_RUNQ */
 }
 
 void z_impl_k_thread_priority_set(k_tid_t thread, int prio)
@@ -6,21 +6,58 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/spinlock.h>
+#include <zephyr/sys/barrier.h>
 #include <ksched.h>
 #include <timeout_q.h>
+#include <timeout_wheel.h>
 #include <zephyr/internal/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
 
 static uint64_t curr_tick;
 
+#if defined(CONFIG_TIMEOUT_PER_CPU)
+/* Each CPU owns a timer wheel and the lock protecting it, and timeouts
+ * are queued on the CPU arming them, so arming and aborting timeouts
+ * on different CPUs doesn't contend.  curr_tick and announce_remaining
+ * are only modified with every CPU's lock held (see lock_all()), so
+ * holding any one of them is enough to read those.
+ */
+struct timeout_cpu {
+	struct k_spinlock lock;
+	struct z_timeout_wheel wheel;
+};
+
+#define TIMEOUT_CPU_INIT(i, _) \
+	{ .wheel = Z_TIMEOUT_WHEEL_INITIALIZER(timeout_cpus[i].wheel) }
+
+static struct timeout_cpu timeout_cpus[CONFIG_MP_MAX_NUM_CPUS] = {
+	LISTIFY(CONFIG_MP_MAX_NUM_CPUS, TIMEOUT_CPU_INIT, (,))
+};
+
+/* Expiry tick the system timer was last programmed for, never later
+ * than the earliest pending timeout.  Protected by timeout_lock.
+ */
+static uint64_t programmed_tick = UINT64_MAX;
+#elif defined(CONFIG_TIMEOUT_QUEUE_WHEEL)
+static struct z_timeout_wheel timeout_wheel =
+	Z_TIMEOUT_WHEEL_INITIALIZER(timeout_wheel);
+#else
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif /* CONFIG_TIMEOUT_PER_CPU */
 
+/* With CONFIG_TIMEOUT_PER_CPU this only serializes programming of the
+ * system timer, otherwise it protects all of the state above.
+ */
 static struct k_spinlock timeout_lock;
 
 #define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
 		  ? K_TICKS_FOREVER : INT_MAX)
 
+/* Largest tick count a timeout can be kept at */
+#define MAX_TICKS ((k_ticks_t)(IS_ENABLED(CONFIG_TIMEOUT_64BIT) \
+			       ? INT64_MAX : UINT32_MAX))
+
 /* Ticks left to process in the currently-executing sys_clock_announce() */
 static int announce_remaining;
 
@@ -36,6 +73,159 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#if defined(CONFIG_TIMEOUT_QUEUE_WHEEL)
+/* Absolute tick @a dticks after curr_tick, saturated so that timeouts
+ * too far away to ever expire don't wrap around into the past
+ */
+static k_ticks_t expiry_tick(k_ticks_t dticks)
+{
+	return (k_ticks_t)MIN(curr_tick + (uint64_t)dticks, (uint64_t)MAX_TICKS);
+}
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+#if defined(CONFIG_TIMEOUT_PER_CPU)
+/* The wheels keep the absolute expiry tick in dticks */
+
+static struct timeout_cpu *local_timeouts(void)
+{
+	/* Any queue works, a thread migrating right after reading its
+	 * CPU only costs some locality.
+	 */
+	return &timeout_cpus[arch_curr_cpu()->id];
+}
+
+static struct timeout_cpu *timeout_owner(const struct _timeout *to)
+{
+	return &timeout_cpus[to->cpu];
+}
+
+/* Lock the CPU queue holding @a to and tell if it is pending there.
+ *
+ * The owner read before locking can be stale: the timeout may have been
+ * aborted and armed again on another CPU, whose lock we don't hold.
+ * insert_timeout() sets the owner before linking the node, so once the
+ * node is seen linked, reading the owner again tells which wheel it is
+ * on.  Only the owner's lock allows unlinking it, so a linked node owned
+ * by the locked CPU stays where it is until unlocked.
+ */
+static struct timeout_cpu *lock_owner(const struct _timeout *to,
+				      k_spinlock_key_t *key, bool *pending)
+{
+	for (;;) {
+		uint8_t cpu = *(volatile const uint8_t *)&to->cpu;
+		struct timeout_cpu *tc = &timeout_cpus[cpu];
+
+		*key = k_spin_lock(&tc->lock);
+		*pending = sys_dnode_is_linked(&to->node);
+		barrier_dmem_fence_full();
+
+		if (!*pending ||
+		    (*(volatile const uint8_t *)&to->cpu == cpu)) {
+			return tc;
+		}
+
+		k_spin_unlock(&tc->lock, *key);
+	}
+}
+
+static k_spinlock_key_t lock_all(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&timeout_cpus[0].lock);
+
+	for (unsigned int i = 1; i < arch_num_cpus(); i++) {
+		(void)k_spin_lock(&timeout_cpus[i].lock);
+	}
+
+	return key;
+}
+
+static void unlock_all(k_spinlock_key_t key)
+{
+	for (unsigned int i = arch_num_cpus() - 1; i > 0; i--) {
+		k_spin_release(&timeout_cpus[i].lock);
+	}
+
+	k_spin_unlock(&timeout_cpus[0].lock, key);
+}
+
+/* Earliest timeout of all CPUs, must hold all locks */
+static struct _timeout *first(void)
+{
+	struct _timeout *ret = NULL;
+
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		struct _timeout *t = z_timeout_wheel_first(&timeout_cpus[i].wheel);
+
+		if ((t != NULL) && ((ret == NULL) || (t->dticks < ret->dticks))) {
+			ret = t;
+		}
+	}
+
+	return ret;
+}
+
+/* Ticks from curr_tick until @a t expires */
+static k_ticks_t timeout_dticks(const struct _timeout *t)
+{
+	return t->dticks - curr_tick;
+}
+
+static void insert_timeout(struct timeout_cpu *tc, struct _timeout *to,
+			   k_ticks_t dticks)
+{
+	to->cpu = ARRAY_INDEX(timeout_cpus, tc);
+	to->dticks = expiry_tick(dticks);
+	/* Publish the owner before the node is seen linked (see lock_owner()) */
+	barrier_dmem_fence_full();
+	z_timeout_wheel_insert(&tc->wheel, to);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	z_timeout_wheel_remove(&timeout_owner(t)->wheel, t);
+}
+
+/* No timeout may expire within the next @a ticks, must hold all locks */
+static void advance_timeouts(k_ticks_t ticks)
+{
+	curr_tick += ticks;
+
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		z_timeout_wheel_advance(&timeout_cpus[i].wheel, curr_tick);
+	}
+}
+#elif defined(CONFIG_TIMEOUT_QUEUE_WHEEL)
+/* The wheel keeps the absolute expiry tick in dticks */
+
+static struct _timeout *first(void)
+{
+	return z_timeout_wheel_first(&timeout_wheel);
+}
+
+/* Ticks from curr_tick until @a t expires */
+static k_ticks_t timeout_dticks(const struct _timeout *t)
+{
+	return t->dticks - curr_tick;
+}
+
+static void insert_timeout(struct _timeout *to, k_ticks_t dticks)
+{
+	to->dticks = expiry_tick(dticks);
+	z_timeout_wheel_insert(&timeout_wheel, to);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	z_timeout_wheel_remove(&timeout_wheel, t);
+}
+
+/* No timeout may expire within the next @a ticks */
+static void advance_timeouts(k_ticks_t ticks)
+{
+	curr_tick += ticks;
+	z_timeout_wheel_advance(&timeout_wheel, curr_tick);
+}
+#else
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -50,6 +240,30 @@ static struct _timeout *next(struct _timeout *t)
 	return (n == NULL) ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
+/* Ticks from curr_tick until @a t expires, only valid for first() */
+static k_ticks_t timeout_dticks(const struct _timeout *t)
+{
+	return t->dticks;
+}
+
+static void insert_timeout(struct _timeout *to, k_ticks_t dticks)
+{
+	struct _timeout *t;
+
+	to->dticks = dticks;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			return;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	sys_dlist_append(&timeout_list, &to->node);
+}
+
 static void remove_timeout(struct _timeout *t)
 {
 	if (next(t) != NULL) {
@@ -59,6 +273,18 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+/* No timeout may expire within the next @a ticks */
+static void advance_timeouts(k_ticks_t ticks)
+{
+	struct _timeout *t = first();
+
+	if (t != NULL) {
+		t->dticks -= ticks;
+	}
+	curr_tick += ticks;
+}
+#endif /* CONFIG_TIMEOUT_PER_CPU */
+
 static int32_t elapsed(void)
 {
 	/* While sys_clock_announce() is executing, new relative timeouts will be
@@ -80,22 +306,251 @@ static int32_t elapsed(void)
 	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
 }
 
-static int32_t next_timeout(void)
+/* Ticks from curr_tick until a timeout of @a ticks relative ticks armed
+ * now expires, saturated instead of overflowing for the longest ones
+ */
+static k_ticks_t relative_dticks(k_ticks_t ticks)
+{
+	k_ticks_t slack = 1 + elapsed();
+
+	return (ticks > MAX_TICKS - slack) ? MAX_TICKS : ticks + slack;
+}
+
+/* Ticks from now until @a to expires, for sys_clock_set_timeout() */
+static int32_t timeout_wait(const struct _timeout *to)
 {
-	struct _timeout *to = first();
 	int32_t ticks_elapsed = elapsed();
 	int32_t ret;
 
 	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	    ((int64_t)(timeout_dticks(to) - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, timeout_dticks(to) - ticks_elapsed);
+	}
+
+	return ret;
+}
+
+#ifdef CONFIG_TIMEOUT_PER_CPU
+/* Ticks from now until @a tick (UINT64_MAX for never), must hold any
+ * CPU's lock
+ */
+static int32_t tick_wait(uint64_t tick)
+{
+	int64_t ticks = (int64_t)(tick - curr_tick) - elapsed();
+	int32_t ret;
+
+	if ((tick == UINT64_MAX) || (ticks > (int64_t)INT_MAX)) {
+		ret = MAX_WAIT;
+	} else {
+		ret = MAX(0, ticks);
+	}
+
+	return ret;
+}
+
+/* Must hold timeout_lock and any CPU's lock */
+static void program_timeout(const struct _timeout *to)
+{
+	programmed_tick = (to == NULL) ? UINT64_MAX : to->dticks;
+	sys_clock_set_timeout(timeout_wait(to), false);
+}
+
+void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
+		   k_timeout_t timeout)
+{
+	struct timeout_cpu *tc;
+	k_spinlock_key_t key;
+	k_ticks_t dticks;
+
+	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		return;
+	}
+
+#ifdef CONFIG_KERNEL_COHERENCE
+	__ASSERT_NO_MSG(arch_mem_coherent(to));
+#endif /* CONFIG_KERNEL_COHERENCE */
+
+	__ASSERT(!sys_dnode_is_linked(&to->node), "");
+	to->fn = fn;
+
+	tc = local_timeouts();
+	key = k_spin_lock(&tc->lock);
+
+	if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
+	    (Z_TICK_ABS(timeout.ticks) >= 0)) {
+		k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
+
+		dticks = MAX(1, ticks);
+	} else {
+		dticks = relative_dticks(timeout.ticks);
+	}
+
+	insert_timeout(tc, to, dticks);
+
+	/* The system timer is never programmed later than any pending
+	 * timeout, so only a new earliest timeout of this CPU can need
+	 * to move it.
+	 */
+	if ((to == z_timeout_wheel_first(&tc->wheel)) &&
+	    (announce_remaining == 0)) {
+		K_SPINLOCK(&timeout_lock) {
+			if ((uint64_t)to->dticks < programmed_tick) {
+				program_timeout(to);
+			}
+		}
+	}
+
+	k_spin_unlock(&tc->lock, key);
+}
+
+int z_abort_timeout(struct _timeout *to)
+{
+	bool is_first = false;
+	int ret = -EINVAL;
+	k_spinlock_key_t key;
+	bool pending;
+	struct timeout_cpu *tc = lock_owner(to, &key, &pending);
+
+	if (pending) {
+		is_first = (to == z_timeout_wheel_first(&tc->wheel));
+		remove_timeout(to);
+		ret = 0;
+	}
+
+	k_spin_unlock(&tc->lock, key);
+
+	if (is_first) {
+		key = lock_all();
+
+		K_SPINLOCK(&timeout_lock) {
+			if ((uint64_t)to->dticks == programmed_tick) {
+				program_timeout(first());
+			}
+		}
+
+		unlock_all(key);
 	}
 
 	return ret;
 }
 
+k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+	k_spinlock_key_t key;
+	bool pending;
+	struct timeout_cpu *tc = lock_owner(timeout, &key, &pending);
+
+	if (pending) {
+		ticks = timeout_dticks(timeout) - elapsed();
+	}
+
+	k_spin_unlock(&tc->lock, key);
+
+	return ticks;
+}
+
+k_ticks_t z_timeout_expires(const struct _timeout *timeout)
+{
+	k_ticks_t ticks;
+	k_spinlock_key_t key;
+	bool pending;
+	struct timeout_cpu *tc = lock_owner(timeout, &key, &pending);
+
+	ticks = curr_tick;
+	if (pending) {
+		ticks += timeout_dticks(timeout);
+	}
+
+	k_spin_unlock(&tc->lock, key);
+
+	return ticks;
+}
+
+int32_t z_get_next_timeout_expiry(void)
+{
+	struct timeout_cpu *tc = local_timeouts();
+	int32_t ret = (int32_t) K_TICKS_FOREVER;
+
+	/* The system timer is kept programmed for the earliest
+	 * pending timeout, so there is no need to lock and look at
+	 * every CPU's wheel.  Any CPU's lock keeps curr_tick stable.
+	 */
+	K_SPINLOCK(&tc->lock) {
+		K_SPINLOCK(&timeout_lock) {
+			ret = tick_wait(programmed_tick);
+		}
+	}
+
+	return ret;
+}
+
+void sys_clock_announce(int32_t ticks)
+{
+	k_spinlock_key_t key = lock_all();
+
+	/* As below, timeouts of all CPUs expire in order on the CPU
+	 * announcing the tick, with all CPU locks held between
+	 * callbacks.  first() breaks ties by CPU index, so timeouts of
+	 * different CPUs expiring on the same tick do not fire in the
+	 * order they were armed (see CONFIG_TIMEOUT_PER_CPU).
+	 */
+	if (announce_remaining != 0) {
+		announce_remaining += ticks;
+		unlock_all(key);
+		return;
+	}
+
+	announce_remaining = ticks;
+
+	struct _timeout *t;
+
+	for (t = first();
+	     (t != NULL) && (timeout_dticks(t) <= announce_remaining);
+	     t = first()) {
+		int dt = timeout_dticks(t);
+
+		advance_timeouts(dt);
+		remove_timeout(t);
+
+		unlock_all(key);
+		t->fn(t);
+		key = lock_all();
+		announce_remaining -= dt;
+	}
+
+	advance_timeouts(announce_remaining);
+	announce_remaining = 0;
+
+	K_SPINLOCK(&timeout_lock) {
+		program_timeout(first());
+	}
+
+	unlock_all(key);
+
+#ifdef CONFIG_TIMESLICING
+	z_time_slice();
+#endif /* CONFIG_TIMESLICING */
+}
+
+int64_t sys_clock_tick_get(void)
+{
+	struct timeout_cpu *tc = local_timeouts();
+	uint64_t t = 0U;
+
+	K_SPINLOCK(&tc->lock) {
+		t = curr_tick + elapsed();
+	}
+	return t;
+}
+#else
+static int32_t next_timeout(void)
+{
+	return timeout_wait(first());
+}
+
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 		   k_timeout_t timeout)
 {
@@ -111,29 +566,18 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	to->fn = fn;
 
 	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
+		k_ticks_t dticks;
 
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    (Z_TICK_ABS(timeout.ticks) >= 0)) {
 			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
 
-			to->dticks = MAX(1, ticks);
+			dticks = MAX(1, ticks);
 		} else {
-			to->dticks = timeout.ticks + 1 + elapsed();
+			dticks = relative_dticks(timeout.ticks);
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
-
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+		insert_timeout(to, dticks);
 
 		if (to == first() && announce_remaining == 0) {
 			sys_clock_set_timeout(next_timeout(), false);
@@ -163,6 +607,9 @@ int z_abort_timeout(struct _timeout *to)
 /* must be locked */
 static k_ticks_t timeout_rem(const struct _timeout *timeout)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	return timeout_dticks(timeout);
+#else
 	k_ticks_t ticks = 0;
 
 	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
@@ -173,6 +620,7 @@ static k_ticks_t timeout_rem(const struct _timeout *timeout)
 	}
 
 	return ticks;
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
 }
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
@@ -233,12 +681,11 @@ void sys_clock_announce(int32_t ticks)
 	struct _timeout *t;
 
 	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
+	     (t != NULL) && (timeout_dticks(t) <= announce_remaining);
 	     t = first()) {
-		int dt = t->dticks;
+		int dt = timeout_dticks(t);
 
-		curr_tick += dt;
-		t->dticks = 0;
+		advance_timeouts(dt);
 		remove_timeout(t);
 
 		k_spin_unlock(&timeout_lock, key);
@@ -247,11 +694,7 @@ void sys_clock_announce(int32_t ticks)
 		announce_remaining -= dt;
 	}
 
-	if (t != NULL) {
-		t->dticks -= announce_remaining;
-	}
-
-	curr_tick += announce_remaining;
+	advance_timeouts(announce_remaining);
 	announce_remaining = 0;
 
 	sys_clock_set_timeout(next_timeout(), false);
@@ -273,6 +716,8 @@ int64_t sys_clock_tick_get(void)
 	return t;
 }
 
+#endif /* CONFIG_TIMEOUT_PER_CPU */
+
 uint32_t sys_clock_tick_get_32(void)
 {
 #ifdef CONFIG_TICKLESS_KERNEL
@@ -335,7 +780,58 @@ k_timeout_t sys_timepoint_timeout(k_timepoint_t timepoint)
 #ifdef CONFIG_ZTEST
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
+#if defined(CONFIG_TIMEOUT_PER_CPU)
+	k_spinlock_key_t key = lock_all();
+	struct _timeout *t;
+	sys_dlist_t pending;
+
+	/* Same as below, for every CPU's wheel */
+	sys_dlist_init(&pending);
+	while ((t = first()) != NULL) {
+		remove_timeout(t);
+		t->dticks = timeout_dticks(t);
+		sys_dlist_append(&pending, &t->node);
+	}
+
+	curr_tick = tick;
+	for (unsigned int i = 0; i < arch_num_cpus(); i++) {
+		z_timeout_wheel_init(&timeout_cpus[i].wheel, curr_tick);
+	}
+
+	for (sys_dnode_t *n = sys_dlist_get(&pending); n != NULL;
+	     n = sys_dlist_get(&pending)) {
+		t = CONTAINER_OF(n, struct _timeout, node);
+		insert_timeout(timeout_owner(t), t, t->dticks);
+	}
+
+	unlock_all(key);
+#elif defined(CONFIG_TIMEOUT_QUEUE_WHEEL)
+	K_SPINLOCK(&timeout_lock) {
+		struct _timeout *t;
+		sys_dlist_t pending;
+
+		/* Rebuild the wheel around the new base, keeping each
+		 * timeout's remaining ticks and the expiry order.
+		 */
+		sys_dlist_init(&pending);
+		while ((t = first()) != NULL) {
+			remove_timeout(t);
+			t->dticks = timeout_dticks(t);
+			sys_dlist_append(&pending, &t->node);
+		}
+
+		curr_tick = tick;
+		z_timeout_wheel_init(&timeout_wheel, curr_tick);
+
+		for (sys_dnode_t *n = sys_dlist_get(&pending); n != NULL;
+		     n = sys_dlist_get(&pending)) {
+			t = CONTAINER_OF(n, struct _timeout, node);
+			insert_timeout(t, t->dticks);
+		}
+	}
+#else
 	curr_tick = tick;
+#endif /* CONFIG_TIMEOUT_PER_CPU */
 }
 
 void z_vrfy_sys_clock_tick_set(uint64_t tick)
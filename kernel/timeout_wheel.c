@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/math_extras.h>
+#include <timeout_wheel.h>
+
+#define LEVEL_SHIFT(l) ((l) * Z_TIMEOUT_WHEEL_BITS)
+
+static inline struct _timeout *to_timeout(sys_dnode_t *n)
+{
+	return (n == NULL) ? NULL : CONTAINER_OF(n, struct _timeout, node);
+}
+
+static inline uint64_t expiry_of(const struct _timeout *to)
+{
+	return (uint64_t)to->dticks;
+}
+
+/* Level a timeout expiring at @a expiry belongs to relative to the
+ * wheel base, or Z_TIMEOUT_WHEEL_LEVELS for the overflow list.
+ */
+static int level_of(const struct z_timeout_wheel *w, uint64_t expiry)
+{
+	uint64_t diff = expiry ^ w->base;
+	int level;
+
+	if (diff < Z_TIMEOUT_WHEEL_SLOTS) {
+		return 0;
+	}
+
+	level = (63 - u64_count_leading_zeros(diff)) / Z_TIMEOUT_WHEEL_BITS;
+
+	return MIN(level, Z_TIMEOUT_WHEEL_LEVELS);
+}
+
+static inline unsigned int slot_of(uint64_t expiry, int level)
+{
+	return (expiry >> LEVEL_SHIFT(level)) & (Z_TIMEOUT_WHEEL_SLOTS - 1);
+}
+
+static sys_dlist_t *list_of(struct z_timeout_wheel *w, uint64_t expiry,
+			    int *level, unsigned int *slot)
+{
+	*level = level_of(w, expiry);
+
+	if (*level == Z_TIMEOUT_WHEEL_LEVELS) {
+		return &w->overflow;
+	}
+
+	*slot = slot_of(expiry, *level);
+
+	return &w->levels[*level].slots[*slot];
+}
+
+static void place(struct z_timeout_wheel *w, struct _timeout *to)
+{
+	int level;
+	unsigned int slot;
+	sys_dlist_t *list = list_of(w, expiry_of(to), &level, &slot);
+
+	/* Slot lists are only initialized once they get populated, so
+	 * that a zeroed wheel is valid without an init hook.
+	 */
+	if ((level < Z_TIMEOUT_WHEEL_LEVELS) &&
+	    ((w->levels[level].bitmap & BIT64(slot)) == 0)) {
+		sys_dlist_init(list);
+		w->levels[level].bitmap |= BIT64(slot);
+	}
+
+	sys_dlist_append(list, &to->node);
+}
+
+void z_timeout_wheel_init(struct z_timeout_wheel *w, uint64_t base)
+{
+	w->base = base;
+	w->first = NULL;
+	w->first_valid = true;
+
+	for (int l = 0; l < Z_TIMEOUT_WHEEL_LEVELS; l++) {
+		w->levels[l].bitmap = 0;
+	}
+
+	sys_dlist_init(&w->overflow);
+}
+
+void z_timeout_wheel_insert(struct z_timeout_wheel *w, struct _timeout *to)
+{
+	__ASSERT_NO_MSG(expiry_of(to) >= w->base);
+
+	place(w, to);
+
+	/* Equal expiry keeps the cached one: it was inserted earlier */
+	if (w->first_valid &&
+	    ((w->first == NULL) || (expiry_of(to) < expiry_of(w->first)))) {
+		w->first = to;
+	}
+}
+
+void z_timeout_wheel_remove(struct z_timeout_wheel *w, struct _timeout *to)
+{
+	int level;
+	unsigned int slot;
+	sys_dlist_t *list = list_of(w, expiry_of(to), &level, &slot);
+
+	sys_dlist_remove(&to->node);
+	if ((level < Z_TIMEOUT_WHEEL_LEVELS) && sys_dlist_is_empty(list)) {
+		w->levels[level].bitmap &= ~BIT64(slot);
+	}
+
+	if (to == w->first) {
+		w->first_valid = false;
+	}
+}
+
+/* First timeout in list order having the smallest expiry */
+static struct _timeout *list_min(sys_dlist_t *list)
+{
+	struct _timeout *best = NULL;
+	struct _timeout *t;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(list, t, node) {
+		if ((best == NULL) || (expiry_of(t) < expiry_of(best))) {
+			best = t;
+		}
+	}
+
+	return best;
+}
+
+static struct _timeout *find_first(struct z_timeout_wheel *w)
+{
+	for (int l = 0; l < Z_TIMEOUT_WHEEL_LEVELS; l++) {
+		uint64_t bitmap = w->levels[l].bitmap;
+		sys_dlist_t *list;
+
+		if (bitmap == 0) {
+			continue;
+		}
+
+		/* Every timeout on a level lies in the same upper level
+		 * slot as the base and after it, so the lowest occupied
+		 * slot is the earliest one.  Level 0 slots hold a single
+		 * expiry tick and need no search.
+		 */
+		list = &w->levels[l].slots[u64_count_trailing_zeros(bitmap)];
+
+		return (l == 0) ? to_timeout(sys_dlist_peek_head(list))
+				: list_min(list);
+	}
+
+	return list_min(&w->overflow);
+}
+
+struct _timeout *z_timeout_wheel_first(struct z_timeout_wheel *w)
+{
+	if (!w->first_valid) {
+		w->first = find_first(w);
+		w->first_valid = true;
+	}
+
+	return w->first;
+}
+
+/* Redistribute @a list according to the current base, keeping order */
+static void cascade(struct z_timeout_wheel *w, sys_dlist_t *list)
+{
+	sys_dlist_t tmp;
+	sys_dnode_t *n;
+
+	if (sys_dlist_is_empty(list)) {
+		return;
+	}
+
+	sys_dlist_init(&tmp);
+	while ((n = sys_dlist_get(list)) != NULL) {
+		sys_dlist_append(&tmp, n);
+	}
+
+	while ((n = sys_dlist_get(&tmp)) != NULL) {
+		place(w, to_timeout(n));
+	}
+}
+
+void z_timeout_wheel_advance(struct z_timeout_wheel *w, uint64_t tick)
+{
+	uint64_t diff = tick ^ w->base;
+
+	__ASSERT_NO_MSG(tick >= w->base);
+
+	if (diff == 0) {
+		return;
+	}
+
+	w->base = tick;
+
+	/* Anything left on a level when the base leaves its enclosing
+	 * slot has already expired, so only the slot the base moves
+	 * into needs to be cascaded, from the top down.
+	 */
+	if ((diff >> LEVEL_SHIFT(Z_TIMEOUT_WHEEL_LEVELS)) != 0) {
+		cascade(w, &w->overflow);
+	}
+
+	for (int l = Z_TIMEOUT_WHEEL_LEVELS - 1; l > 0; l--) {
+		unsigned int slot;
+
+		if ((diff >> LEVEL_SHIFT(l)) == 0) {
+			continue;
+		}
+
+		slot = slot_of(tick, l);
+		if ((w->levels[l].bitmap & BIT64(slot)) != 0) {
+			w->levels[l].bitmap &= ~BIT64(slot);
+			cascade(w, &w->levels[l].slots[slot]);
+		}
+	}
+}
@@ -208,6 +208,70 @@ size_t sys_heap_usable_size(struct sys_heap *heap, void *mem)
 	return chunk_sz - (addr - chunk_base);
 }
 
+#ifdef CONFIG_SYS_HEAP_ALLOC_BEST_FIT
+/* Returns the smallest chunk of bucket "bi" that is at least "sz"
+ * units long, or zero if none is.
+ */
+static chunkid_t bucket_best_fit(struct z_heap *h, int bi, chunksz_t sz)
+{
+	chunkid_t first = h->buckets[bi].next;
+	chunkid_t best = 0;
+	chunksz_t best_sz = 0;
+	chunkid_t c = first;
+
+	if (first == 0U) {
+		return 0;
+	}
+
+	do {
+		chunksz_t csz = chunk_size(h, c);
+
+		if ((csz >= sz) && ((best == 0U) || (csz < best_sz))) {
+			best = c;
+			best_sz = csz;
+			if (csz == sz) {
+				/* Cannot do better than an exact fit */
+				break;
+			}
+		}
+		c = next_free_chunk(h, c);
+		CHECK(c != 0);
+	} while (c != first);
+
+	return best;
+}
+
+static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
+{
+	int bi = bucket_idx(h, sz);
+	chunkid_t c;
+
+	CHECK(bi <= bucket_idx(h, h->end_chunk));
+
+	/* The bucket of the requested size holds chunks that may be
+	 * too small as well as the best candidates, all bigger
+	 * buckets only hold chunks that fit.  So the smallest chunk
+	 * is either found in the requested bucket, or else in the
+	 * smallest non-empty bigger one.
+	 */
+	c = bucket_best_fit(h, bi, sz);
+	if (c == 0U) {
+		uint32_t bmask = h->avail_buckets & ~BIT_MASK(bi + 1);
+
+		if (bmask == 0U) {
+			return 0;
+		}
+
+		bi = __builtin_ctz(bmask);
+		c = bucket_best_fit(h, bi, sz);
+		CHECK(c != 0U);
+	}
+
+	free_list_remove_bidx(h, c, bi);
+	CHECK(chunk_size(h, c) >= sz);
+	return c;
+}
+#else
 static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 {
 	int bi = bucket_idx(h, sz);
@@ -259,6 +323,7 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 
 	return 0;
 }
+#endif /* CONFIG_SYS_HEAP_ALLOC_BEST_FIT */
 
 void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 {
@@ -18,6 +18,11 @@ int sys_heap_runtime_stats_get(struct sys_heap *heap,
 	stats->free_bytes = heap->heap->free_bytes;
 	stats->allocated_bytes = heap->heap->allocated_bytes;
 	stats->max_allocated_bytes = heap->heap->max_allocated_bytes;
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+	stats->cached_bytes = 0;
+	stats->cache_hits = 0;
+	stats->cache_misses = 0;
+#endif
 
 	return 0;
 }
@@ -32,3 +37,24 @@ int sys_heap_runtime_stats_reset_max(struct sys_heap *heap)
 
 	return 0;
 }
+
+size_t sys_heap_largest_free(struct sys_heap *heap)
+{
+	struct z_heap *h = heap->heap;
+	chunksz_t largest = 0;
+	chunkid_t first, c;
+
+	if (h->avail_buckets == 0U) {
+		return 0;
+	}
+
+	/* Only the biggest non-empty bucket can hold the largest chunk */
+	first = h->buckets[31 - __builtin_clz(h->avail_buckets)].next;
+	c = first;
+	do {
+		largest = MAX(largest, chunk_size(h, c));
+		c = next_free_chunk(h, c);
+	} while (c != first);
+
+	return chunksz_to_bytes(h, largest);
+}
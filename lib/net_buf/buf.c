@@ -222,6 +222,124 @@ static uint8_t *data_ref(struct net_buf *buf, uint8_t *data)
 	return pool->alloc->cb->ref(buf, data);
 }
 
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+static void cache_spill(struct net_buf_pool *pool, sys_slist_t *list)
+{
+	if (!sys_slist_is_empty(list)) {
+		(void)k_queue_merge_slist(&pool->free._queue, list);
+	}
+}
+
+/* Take a buffer from the cache of the current CPU, refilling it from the
+ * shared free list when it is empty.
+ */
+static struct net_buf *cache_get(struct net_buf_pool *pool)
+{
+	struct net_buf *batch[CONFIG_NET_BUF_POOL_CPU_CACHE_BATCH];
+	struct net_buf_pool_cpu_cache *cache;
+	struct net_buf *buf = NULL;
+	k_spinlock_key_t key;
+	unsigned int irq_key;
+	size_t n = 0;
+
+	/* Keeps us on this CPU, the cache lock only guards against the
+	 * other CPUs flushing it.
+	 */
+	irq_key = arch_irq_lock();
+	cache = &pool->cpu_cache[arch_curr_cpu()->id];
+
+	key = k_spin_lock(&cache->lock);
+	if (cache->count > 0) {
+		buf = cache->bufs[--cache->count];
+	}
+	k_spin_unlock(&cache->lock, key);
+
+	if (buf == NULL) {
+		while (n < ARRAY_SIZE(batch)) {
+			batch[n] = k_lifo_get(&pool->free, K_NO_WAIT);
+			if (batch[n] == NULL) {
+				break;
+			}
+
+			n++;
+		}
+
+		if (n > 0) {
+			buf = batch[--n];
+
+			key = k_spin_lock(&cache->lock);
+			while (n > 0) {
+				cache->bufs[cache->count++] = batch[--n];
+			}
+			k_spin_unlock(&cache->lock, key);
+		}
+	}
+
+	arch_irq_unlock(irq_key);
+
+	return buf;
+}
+
+void net_buf_pool_cache_put(struct net_buf_pool *pool, struct net_buf *buf)
+{
+	struct net_buf_pool_cpu_cache *cache;
+	sys_slist_t spill;
+	k_spinlock_key_t key;
+	unsigned int irq_key;
+
+	sys_slist_init(&spill);
+
+	irq_key = arch_irq_lock();
+	cache = &pool->cpu_cache[arch_curr_cpu()->id];
+
+	key = k_spin_lock(&cache->lock);
+
+	if (atomic_get(&pool->cache_waiters) != 0) {
+		/* Someone is about to block on the free list */
+		sys_slist_append(&spill, &buf->node);
+	} else {
+		if (cache->count == ARRAY_SIZE(cache->bufs)) {
+			/* Spill the least recently freed ones */
+			for (int i = 0; i < CONFIG_NET_BUF_POOL_CPU_CACHE_BATCH; i++) {
+				sys_slist_append(&spill, &cache->bufs[i]->node);
+			}
+
+			cache->count -= CONFIG_NET_BUF_POOL_CPU_CACHE_BATCH;
+			memmove(cache->bufs,
+				&cache->bufs[CONFIG_NET_BUF_POOL_CPU_CACHE_BATCH],
+				cache->count * sizeof(cache->bufs[0]));
+		}
+
+		cache->bufs[cache->count++] = buf;
+	}
+
+	k_spin_unlock(&cache->lock, key);
+	arch_irq_unlock(irq_key);
+
+	cache_spill(pool, &spill);
+}
+
+/* Return the buffers cached by all CPUs to the shared free list */
+static void cache_flush(struct net_buf_pool *pool)
+{
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		struct net_buf_pool_cpu_cache *cache = &pool->cpu_cache[cpu];
+		sys_slist_t spill;
+		k_spinlock_key_t key;
+
+		sys_slist_init(&spill);
+
+		key = k_spin_lock(&cache->lock);
+		while (cache->count > 0) {
+			sys_slist_append(&spill, &cache->bufs[--cache->count]->node);
+		}
+		k_spin_unlock(&cache->lock, key);
+
+		cache_spill(pool, &spill);
+	}
+}
+#endif /* CONFIG_NET_BUF_POOL_CPU_CACHE */
+
 #if defined(CONFIG_NET_BUF_LOG)
 struct net_buf *net_buf_alloc_len_debug(struct net_buf_pool *pool, size_t size,
 					k_timeout_t timeout, const char *func,
@@ -239,6 +357,13 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 
 	NET_BUF_DBG("%s():%d: pool %p size %zu", func, line, pool, size);
 
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+	buf = cache_get(pool);
+	if (buf) {
+		goto success;
+	}
+#endif
+
 	/* We need to prevent race conditions
 	 * when accessing pool->uninit_count.
 	 */
@@ -271,6 +396,14 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 
 	k_spin_unlock(&pool->lock, key);
 
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+	/* Buffers freed from now on bypass the caches, so that they wake
+	 * us up, and the ones already cached get back to the free list.
+	 */
+	atomic_inc(&pool->cache_waiters);
+	cache_flush(pool);
+#endif
+
 	if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT) &&
 	    k_current_get() == k_work_queue_thread_get(&k_sys_work_q)) {
 		LOG_WRN("Timeout discarded. No blocking in syswq");
@@ -305,6 +438,9 @@ struct net_buf *net_buf_alloc_len(struct net_buf_pool *pool, size_t size,
 	}
 #else
 	buf = k_lifo_get(&pool->free, timeout);
+#endif
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+	atomic_dec(&pool->cache_waiters);
 #endif
 	if (!buf) {
 		NET_BUF_ERR("%s():%d: Failed to get free buffer", func, line);
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/panic_flush.h>
+
+static sys_slist_t panic_flush_hooks = SYS_SLIST_STATIC_INIT(&panic_flush_hooks);
+static struct k_spinlock panic_flush_lock;
+
+void sys_panic_flush_register(struct sys_panic_flush *hook)
+{
+	k_spinlock_key_t key = k_spin_lock(&panic_flush_lock);
+
+	sys_slist_append(&panic_flush_hooks, &hook->node);
+
+	k_spin_unlock(&panic_flush_lock, key);
+}
+
+void sys_panic_flush_run(k_timeout_t timeout)
+{
+	struct sys_panic_flush *hook;
+
+	/* The lock is not taken, the panic may have interrupted its owner.
+	 * Hooks are only ever appended, so the list can be walked anyway.
+	 */
+	SYS_SLIST_FOR_EACH_CONTAINER(&panic_flush_hooks, hook, node) {
+		hook->flush(hook, timeout);
+	}
+}
@@ -10,6 +10,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/sys/printk.h>
 #include <zephyr/debug/gcov.h>
+#include <zephyr/sys/panic_flush.h>
 
 extern void sys_arch_reboot(int type);
 
@@ -19,6 +20,11 @@ FUNC_NORETURN void sys_reboot(int type)
 	gcov_coverage_dump();
 #endif /* CONFIG_COVERAGE_DUMP */
 
+#ifdef CONFIG_SYS_PANIC_FLUSH
+	sys_panic_flush_run(k_is_in_isr() ? K_NO_WAIT :
+			    K_MSEC(CONFIG_SYS_PANIC_FLUSH_REBOOT_TIMEOUT_MS));
+#endif /* CONFIG_SYS_PANIC_FLUSH */
+
 	(void)irq_lock();
 
 	/* Disable caches to ensure all data is flushed */
@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Decoder of compact dictionary-based log messages
+
+This turns compact and compressed messages (see CONFIG_LOG_DICTIONARY_COMPACT
+and include/zephyr/logging/log_output_dict.h) back into the package and
+hexdump data of the default format.
+"""
+
+import struct
+from collections import namedtuple
+
+
+# Keep in sync with subsys/logging/log_output_dict.c
+LZ_MIN_MATCH = 3
+LZ_LEN_EXT = 15
+
+# Keep in sync with LOG_DICT_COMPACT_SYNC in include/zephyr/logging/log_output_dict.h
+SYNC = bytes([0x5A, 0xC3, 0x96, 0x3C])
+
+# The encoder never refers further back than its window, which is at most
+# this many bytes.
+HISTORY_MAX = 4096
+
+CompactMsg = namedtuple("CompactMsg",
+                        ["domain_id", "level", "source_id", "timestamp",
+                         "payload", "pkg_len"])
+
+
+def read_varint(data, offset):
+    """Read an unsigned LEB128 integer, return it with the next offset"""
+    value = 0
+    shift = 0
+
+    while True:
+        byte = data[offset]
+        offset += 1
+
+        value |= (byte & 0x7F) << shift
+        shift += 7
+
+        if (byte & 0x80) == 0:
+            return value, offset
+
+
+def unzigzag(value):
+    """Undo the zigzag mapping of a signed integer"""
+    return (value >> 1) ^ -(value & 1)
+
+
+def lz_decompress(data, offset, history):
+    """Decompress one message, return it with the offset after it"""
+    length, offset = read_varint(data, offset)
+    out = bytearray(history)
+    end = len(out) + length
+
+    while len(out) < end:
+        token = data[offset]
+        offset += 1
+
+        lit_len = token >> 4
+        if lit_len == LZ_LEN_EXT:
+            ext, offset = read_varint(data, offset)
+            lit_len += ext
+
+        out += data[offset:(offset + lit_len)]
+        offset += lit_len
+
+        if len(out) >= end:
+            break
+
+        distance, offset = read_varint(data, offset)
+        match_len = (token & 0x0F)
+        if match_len == LZ_LEN_EXT:
+            ext, offset = read_varint(data, offset)
+            match_len += ext
+        match_len += LZ_MIN_MATCH
+
+        if distance == 0 or distance > len(out):
+            raise ValueError(f"match distance {distance} out of history")
+
+        # Byte by byte as the match may overlap what it produces
+        start = len(out) - distance
+        for idx in range(match_len):
+            out.append(out[start + idx])
+
+    if len(out) != end:
+        raise ValueError("decompressed message longer than announced")
+
+    return bytes(out[len(history):]), offset
+
+
+class CompactDecoder():
+    """State of a compact message stream"""
+    def __init__(self, endian, timestamp_bits):
+        self.fmt_word = endian + "i"
+        self.timestamp_mask = (1 << timestamp_bits) - 1
+        self.timestamp = 0
+        self.history = bytearray()
+        self.synced = False
+
+
+    def reset(self, data, offset):
+        """Start decoding from the reset record at offset, after its type byte,
+        return the offset after it"""
+        if data[offset:(offset + len(SYNC))] != SYNC:
+            raise ValueError("bad reset record")
+
+        timestamp, offset = read_varint(data, offset + len(SYNC))
+
+        self.timestamp = timestamp & self.timestamp_mask
+        self.history = bytearray()
+        self.synced = True
+
+        return offset
+
+
+    def lost(self):
+        """Stream corrupted, nothing decodes until the next reset record"""
+        self.synced = False
+
+
+    def __parse(self, data, offset):
+        """Parse one uncompressed compact message, return it with the next offset"""
+        domain_lvl = data[offset]
+        source_id, offset = read_varint(data, offset + 1)
+        delta, offset = read_varint(data, offset)
+        pkg_len, offset = read_varint(data, offset)
+        data_len, offset = read_varint(data, offset)
+
+        self.timestamp = (self.timestamp + unzigzag(delta)) & self.timestamp_mask
+
+        payload = bytearray()
+        words = 1 if pkg_len >= 4 else 0
+        while len(payload) < words * 4:
+            word, offset = read_varint(data, offset)
+            payload += struct.pack(self.fmt_word, unzigzag(word))
+
+            # The package starts with its number of argument words
+            if len(payload) == 4:
+                words = max(1, min(payload[0], pkg_len // 4))
+
+        tail_len = pkg_len + data_len - len(payload)
+        payload += data[offset:(offset + tail_len)]
+        offset += tail_len
+
+        if len(payload) != pkg_len + data_len:
+            raise ValueError("truncated compact message")
+
+        msg = CompactMsg(domain_id=domain_lvl & 0x0F, level=domain_lvl >> 4,
+                         source_id=source_id, timestamp=self.timestamp,
+                         payload=bytes(payload), pkg_len=pkg_len)
+
+        return msg, offset
+
+
+    def decode(self, logdata, offset, compressed):
+        """Decode the message at offset, return it with the next offset"""
+        if not self.synced:
+            raise ValueError("no reset record yet")
+
+        if not compressed:
+            return self.__parse(logdata, offset)
+
+        data, offset = lz_decompress(logdata, offset, self.history)
+
+        self.history += data
+        del self.history[:-HISTORY_MAX]
+
+        msg, end = self.__parse(data, 0)
+        if end != len(data):
+            raise ValueError("compressed message length mismatch")
+
+        return msg, offset
@@ -22,6 +22,7 @@ from colorama import Fore
 
 from .log_parser import (LogParser, get_log_level_str_color, formalize_fmt_string)
 from .data_types import DataTypes
+from .compact import CompactDecoder, SYNC as COMPACT_SYNC
 
 
 HEX_BYTES_IN_LINE = 16
@@ -55,6 +56,9 @@ FMT_MSG_TIMESTAMP_64 = "Q"
 # Keep message types in sync with include/logging/log_output_dict.h
 MSG_TYPE_NORMAL = 0
 MSG_TYPE_DROPPED = 1
+MSG_TYPE_COMPACT = 2
+MSG_TYPE_COMPACT_LZ = 3
+MSG_TYPE_COMPACT_RESET = 4
 
 # Number of dropped messages
 FMT_DROPPED_CNT = "H"
@@ -85,8 +89,12 @@ class LogParserV3(LogParser):
 
         if "CONFIG_LOG_TIMESTAMP_64BIT" in self.database.get_kconfigs():
             self.fmt_msg_timestamp = endian + FMT_MSG_TIMESTAMP_64
+            timestamp_bits = 64
         else:
             self.fmt_msg_timestamp = endian + FMT_MSG_TIMESTAMP_32
+            timestamp_bits = 32
+
+        self.compact = CompactDecoder(endian, timestamp_bits)
 
 
     def __get_string(self, arg, arg_offset, string_tbl):
@@ -282,12 +290,41 @@ class LogParserV3(LogParser):
             domain_id = domain_lvl & 0x0F
             level = (domain_lvl >> 4) & 0x0F
 
-        level_str, color = get_log_level_str_color(level)
-        source_id_str = self.database.get_log_source_string(domain_id, source_id)
-
         # Skip over data to point to next message (save as return value)
         next_msg_offset = offset + pkg_len + data_len
 
+        if not self.print_one_msg(domain_id, level, source_id, timestamp,
+                                  logdata[offset:next_msg_offset], pkg_len):
+            return None
+
+        # Point to next message
+        return next_msg_offset
+
+
+    def parse_one_compact_msg(self, logdata, offset, compressed):
+        """Parse one compact log message and print the encoded message"""
+        try:
+            msg, offset = self.compact.decode(logdata, offset, compressed)
+        except (IndexError, ValueError) as err:
+            if self.compact.synced:
+                logger.error("------ Error decoding compact message: %s", err)
+            return None
+
+        if not self.print_one_msg(msg.domain_id, msg.level, msg.source_id,
+                                  msg.timestamp, msg.payload, msg.pkg_len):
+            return None
+
+        return offset
+
+
+    def print_one_msg(self, domain_id, level, source_id, timestamp, logdata, pkg_len):
+        """Print one message from its package followed by its hexdump data"""
+        offset = 0
+        next_msg_offset = len(logdata)
+
+        level_str, color = get_log_level_str_color(level)
+        source_id_str = self.database.get_log_source_string(domain_id, source_id)
+
         # Offset from beginning of cbprintf_packaged data to end of va_list arguments
         offset_end_of_args = struct.unpack_from("B", logdata, offset)[0]
         offset_end_of_args *= self.data_types.get_sizeof(DataTypes.INT)
@@ -312,7 +349,7 @@ class LogParserV3(LogParser):
 
         if len(string_tbl) != num_packed_strings:
             logger.error("------ Error extracting string table")
-            return None
+            return False
 
         # Skip packaged string header
         offset += self.data_types.get_sizeof(DataTypes.PTR)
@@ -332,7 +369,7 @@ class LogParserV3(LogParser):
 
         if not fmt_str:
             logger.error("------ Error getting format string at 0x%x", fmt_str_ptr)
-            return None
+            return False
 
         args = self.process_one_fmt_str(fmt_str, logdata[offset:offset_end_of_args], string_tbl)
 
@@ -346,12 +383,25 @@ class LogParserV3(LogParser):
             log_prefix = f"[{timestamp:>10}] <{level_str}> {source_id_str}: "
             print(f"{color}%s%s{Fore.RESET}" % (log_prefix, log_msg))
 
-        if data_len > 0:
+        if len(extra_data) > 0:
             # Has hexdump data
             self.print_hexdump(extra_data, len(log_prefix), color)
 
-        # Point to next message
-        return next_msg_offset
+        return True
+
+
+    def resync(self, logdata, offset):
+        """Skip to the next compact reset record, return its offset or None"""
+        pos = logdata.find(bytes([MSG_TYPE_COMPACT_RESET]) + COMPACT_SYNC, offset)
+        if pos < 0:
+            return None
+
+        if self.compact.synced:
+            logger.warning("------ Skipped %d bytes to resynchronize", pos - offset)
+
+        self.compact.lost()
+
+        return pos
 
 
     def parse_log_data(self, logdata, debug=False):
@@ -359,6 +409,8 @@ class LogParserV3(LogParser):
         offset = 0
 
         while offset < len(logdata):
+            msg_offset = offset
+
             # Get message type
             msg_type = struct.unpack_from(self.fmt_msg_type, logdata, offset)[0]
             offset += struct.calcsize(self.fmt_msg_type)
@@ -376,9 +428,30 @@ class LogParserV3(LogParser):
 
                 offset = ret
 
+            elif msg_type in (MSG_TYPE_COMPACT, MSG_TYPE_COMPACT_LZ):
+                ret = self.parse_one_compact_msg(logdata, offset,
+                                                 msg_type == MSG_TYPE_COMPACT_LZ)
+                if ret is None:
+                    # Carry on from the next reset record, if any
+                    ret = self.resync(logdata, msg_offset + 1)
+                    if ret is None:
+                        return False
+
+                offset = ret
+
+            elif msg_type == MSG_TYPE_COMPACT_RESET:
+                try:
+                    offset = self.compact.reset(logdata, offset)
+                except (IndexError, ValueError):
+                    offset = self.resync(logdata, msg_offset + 1)
+                    if offset is None:
+                        return False
+
             else:
-                logger.error("------ Unknown message type: %s", msg_type)
-                return False
+                offset = self.resync(logdata, msg_offset + 1)
+                if offset is None:
+                    logger.error("------ Unknown message type: %s", msg_type)
+                    return False
 
         return True
 
@@ -145,9 +145,17 @@ int flash_img_init_id(struct flash_img_context *ctx, uint8_t area_id)
 
 	flash_dev = flash_area_get_device(ctx->flash_area);
 
-	return stream_flash_init(&ctx->stream, flash_dev, ctx->buf,
+	rc = stream_flash_init(&ctx->stream, flash_dev, ctx->buf,
 			CONFIG_IMG_BLOCK_BUF_SIZE, ctx->flash_area->fa_off,
 			ctx->flash_area->fa_size, NULL);
+#ifdef CONFIG_IMG_WRITE_BEHIND
+	if (rc == 0) {
+		rc = stream_flash_write_behind(&ctx->stream, ctx->wb_buf,
+					       CONFIG_IMG_WRITE_BEHIND_BUFFERS - 1);
+	}
+#endif
+
+	return rc;
 }
 
 #ifdef CONFIG_MCUBOOT_BOOTLOADER_MODE_RAM_LOAD
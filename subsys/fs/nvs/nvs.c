@@ -508,6 +508,17 @@ static int nvs_recover_last_ate(struct nvs_fs *fs, uint32_t *addr)
 		ate_end_addr -= ate_size;
 	}
 
+	/* the last position within the sector can hold a delete ate */
+	if ((ate_end_addr == data_end_addr) && (data_end_addr & ADDR_OFFS_MASK)) {
+		rc = nvs_flash_ate_rd(fs, ate_end_addr, &end_ate);
+		if (rc) {
+			return rc;
+		}
+		if (nvs_ate_valid(fs, &end_ate) && (end_ate.len == 0U)) {
+			*addr = ate_end_addr;
+		}
+	}
+
 	return 0;
 }
 
@@ -620,26 +631,87 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 	return nvs_flash_ate_wrt(fs, &gc_done_ate);
 }
 
+/* possible data write after last ate write, update data_wra */
+static int nvs_data_wra_recover(struct nvs_fs *fs)
+{
+	int rc;
+	size_t empty_len;
+
+	while (fs->ate_wra > fs->data_wra) {
+		empty_len = fs->ate_wra - fs->data_wra;
+
+		rc = nvs_flash_cmp_const(fs, fs->data_wra, fs->flash_parameters->erase_value,
+					 empty_len);
+		if (rc < 0) {
+			return rc;
+		}
+		if (!rc) {
+			break;
+		}
+
+		fs->data_wra += fs->flash_parameters->write_block_size;
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+/* Writes may go on while the sector is collected as long as they leave room
+ * for the copies still to make, which is bounded by the space all valid
+ * entries of the sector take, and for the largest copy in case one of them
+ * is interrupted by a power loss.
+ */
+static int nvs_gc_bound(struct nvs_fs *fs, struct nvs_gc_state *gc)
+{
+	int rc;
+	struct nvs_ate gc_ate;
+	uint32_t addr;
+	size_t ate_size, data_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	for (addr = gc->addr; addr <= gc->stop_addr; addr += ate_size) {
+		rc = nvs_flash_ate_rd(fs, addr, &gc_ate);
+		if (rc) {
+			return rc;
+		}
+
+		if (!nvs_ate_valid(fs, &gc_ate) || !gc_ate.len) {
+			continue;
+		}
+
+		data_size = nvs_al_size(fs, gc_ate.len);
+		gc->need += data_size + ate_size;
+		gc->slack = MAX(gc->slack, data_size);
+	}
+
+	return 0;
+}
+#endif
+
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
- * sector.
+ * sector. nvs_gc_start() sets gc up to go through its entries from the most
+ * recent one, each nvs_gc_next() then copies one of them if it is still
+ * current, or erases the sector once all of them are done.
  */
-static int nvs_gc(struct nvs_fs *fs)
+static int nvs_gc_start(struct nvs_fs *fs, struct nvs_gc_state *gc)
 {
 	int rc;
-	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	uint32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
+	struct nvs_ate close_ate;
 	size_t ate_size;
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 
-	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
-	nvs_sector_advance(fs, &sec_addr);
-	gc_addr = sec_addr + fs->sector_size - ate_size;
+	gc->phase = NVS_GC_IDLE;
+	gc->need = 0U;
+	gc->slack = 0U;
+	gc->sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
+	nvs_sector_advance(fs, &gc->sec_addr);
+	gc->addr = gc->sec_addr + fs->sector_size - ate_size;
 
 	/* if the sector is not closed don't do gc */
-	rc = nvs_flash_ate_rd(fs, gc_addr, &close_ate);
+	rc = nvs_flash_ate_rd(fs, gc->addr, &close_ate);
 	if (rc < 0) {
 		/* flash error */
 		return rc;
@@ -647,84 +719,200 @@ static int nvs_gc(struct nvs_fs *fs)
 
 	rc = nvs_ate_cmp_const(&close_ate, fs->flash_parameters->erase_value);
 	if (!rc) {
-		goto gc_done;
+		gc->phase = NVS_GC_ERASE;
+		return 0;
 	}
 
-	stop_addr = gc_addr - ate_size;
+	gc->stop_addr = gc->addr - ate_size;
 
 	if (nvs_close_ate_valid(fs, &close_ate)) {
-		gc_addr &= ADDR_SECT_MASK;
-		gc_addr += close_ate.offset;
+		gc->addr &= ADDR_SECT_MASK;
+		gc->addr += close_ate.offset;
 	} else {
-		rc = nvs_recover_last_ate(fs, &gc_addr);
+		rc = nvs_recover_last_ate(fs, &gc->addr);
 		if (rc) {
 			return rc;
 		}
 	}
 
-	do {
-		gc_prev_addr = gc_addr;
-		rc = nvs_prev_ate(fs, &gc_addr, &gc_ate);
-		if (rc) {
-			return rc;
-		}
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	rc = nvs_gc_bound(fs, gc);
+	if (rc) {
+		return rc;
+	}
+#endif
+	gc->phase = NVS_GC_COPY;
 
-		if (!nvs_ate_valid(fs, &gc_ate)) {
-			continue;
-		}
+	return 0;
+}
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-		wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(gc_ate.id)];
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+/* A copy interrupted by a power loss leaves its data, possibly only the first
+ * blocks of it, between data_wra and gc.torn_end. The resumed collection
+ * copies the same entry first, so when what is in flash matches the start of
+ * its data, the copy is completed in place instead of leaving that space
+ * unused. That way, repeated power losses during the same copy don't use up
+ * the room kept for the collection. On return, done holds the number of bytes
+ * of the entry already in place.
+ */
+static int nvs_gc_torn_reuse(struct nvs_fs *fs, uint32_t data_addr, size_t len,
+			     size_t *done)
+{
+	int rc;
+	uint8_t buf[NVS_BLOCK_SIZE];
+	size_t torn_len, cmp_len, bytes_to_cmp;
+	uint32_t offs;
 
-		if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
-			wlk_addr = fs->ate_wra;
-		}
-#else
-		wlk_addr = fs->ate_wra;
-#endif
-		do {
-			wlk_prev_addr = wlk_addr;
-			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+	*done = 0U;
+	if (fs->gc.torn_end <= fs->data_wra) {
+		return 0;
+	}
+
+	torn_len = fs->gc.torn_end - fs->data_wra;
+	fs->gc.torn_end = 0U;
+
+	/* the padding of the last write block is not compared */
+	cmp_len = MIN(torn_len, len);
+	offs = 0U;
+	if (torn_len <= nvs_al_size(fs, len)) {
+		for (; offs < cmp_len; offs += bytes_to_cmp) {
+			bytes_to_cmp = MIN(sizeof(buf), cmp_len - offs);
+			rc = nvs_flash_rd(fs, data_addr + offs, buf, bytes_to_cmp);
 			if (rc) {
 				return rc;
 			}
-			/* if ate with same id is reached we might need to copy.
-			 * only consider valid wlk_ate's. Something wrong might
-			 * have been written that has the same ate but is
-			 * invalid, don't consider these as a match.
-			 */
-			if ((wlk_ate.id == gc_ate.id) &&
-			    (nvs_ate_valid(fs, &wlk_ate))) {
+
+			rc = nvs_flash_block_cmp(fs, fs->data_wra + offs, buf,
+						 bytes_to_cmp);
+			if (rc < 0) {
+				return rc;
+			}
+			if (rc) {
 				break;
 			}
-		} while (wlk_addr != fs->ate_wra);
+		}
+	}
+
+	if ((torn_len > nvs_al_size(fs, len)) || (offs < cmp_len)) {
+		/* not the start of this entry, skip it */
+		fs->data_wra += torn_len;
+		return 0;
+	}
+
+	LOG_DBG("Completing interrupted copy, %zu bytes in place", torn_len);
+	*done = torn_len;
+
+	return 0;
+}
+#endif
+
+/* copy the entry at gc_addr if it is the most recent one of its id */
+static int nvs_gc_copy(struct nvs_fs *fs, uint32_t gc_addr, struct nvs_ate *gc_ate)
+{
+	int rc;
+	struct nvs_ate wlk_ate;
+	uint32_t wlk_addr, wlk_prev_addr, data_addr;
+	size_t done = 0U;
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	wlk_addr = fs->lookup_cache[nvs_lookup_cache_pos(gc_ate->id)];
 
-		/* if walk has reached the same address as gc_addr copy is
-		 * needed unless it is a deleted item.
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		wlk_addr = fs->ate_wra;
+	}
+#else
+	wlk_addr = fs->ate_wra;
+#endif
+	do {
+		wlk_prev_addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+		if (rc) {
+			return rc;
+		}
+		/* if ate with same id is reached we might need to copy.
+		 * only consider valid wlk_ate's. Something wrong might
+		 * have been written that has the same ate but is
+		 * invalid, don't consider these as a match.
 		 */
-		if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
-			/* copy needed */
-			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
+		if ((wlk_ate.id == gc_ate->id) &&
+		    (nvs_ate_valid(fs, &wlk_ate))) {
+			break;
+		}
+	} while (wlk_addr != fs->ate_wra);
 
-			data_addr = (gc_prev_addr & ADDR_SECT_MASK);
-			data_addr += gc_ate.offset;
+	/* if walk has reached the same address as gc_addr copy is
+	 * needed unless it is a deleted item.
+	 */
+	if ((wlk_prev_addr != gc_addr) || !gc_ate->len) {
+		return 0;
+	}
 
-			gc_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
-			nvs_ate_crc8_update(&gc_ate);
+	/* copy needed */
+	LOG_DBG("Moving %d, len %d", gc_ate->id, gc_ate->len);
 
-			rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
-			if (rc) {
-				return rc;
-			}
+	data_addr = (gc_addr & ADDR_SECT_MASK);
+	data_addr += gc_ate->offset;
 
-			rc = nvs_flash_ate_wrt(fs, &gc_ate);
-			if (rc) {
-				return rc;
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	rc = nvs_gc_torn_reuse(fs, data_addr, gc_ate->len, &done);
+	if (rc) {
+		return rc;
+	}
+
+	/* Only copies made again after an interrupted one may not fit */
+	if (fs->ate_wra < (fs->data_wra + nvs_al_size(fs, gc_ate->len) +
+			   nvs_al_size(fs, sizeof(struct nvs_ate)))) {
+		return -ENOSPC;
+	}
+#endif
+
+	gc_ate->offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+	nvs_ate_crc8_update(gc_ate);
+
+	fs->data_wra += done;
+	if (done < gc_ate->len) {
+		rc = nvs_flash_block_move(fs, data_addr + done, gc_ate->len - done);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return nvs_flash_ate_wrt(fs, gc_ate);
+}
+
+static int nvs_gc_next(struct nvs_fs *fs, struct nvs_gc_state *gc)
+{
+	int rc;
+	struct nvs_ate gc_ate;
+	uint32_t gc_prev_addr;
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	if (gc->phase == NVS_GC_COPY) {
+		gc_prev_addr = gc->addr;
+		rc = nvs_prev_ate(fs, &gc->addr, &gc_ate);
+		if (!rc && nvs_ate_valid(fs, &gc_ate)) {
+			rc = nvs_gc_copy(fs, gc_prev_addr, &gc_ate);
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+			if (!rc && gc_ate.len) {
+				gc->need -= nvs_al_size(fs, gc_ate.len) + ate_size;
 			}
+#endif
+		}
+
+		if (rc) {
+			/* retry this entry next time */
+			gc->addr = gc_prev_addr;
+			return rc;
+		}
+
+		if (gc_prev_addr == gc->stop_addr) {
+			gc->phase = NVS_GC_ERASE;
 		}
-	} while (gc_prev_addr != stop_addr);
 
-gc_done:
+		return 0;
+	}
 
 	/* Make it possible to detect that gc has finished by writing a
 	 * gc done ate to the sector. In the field we might have nvs systems
@@ -740,16 +928,144 @@ gc_done:
 	}
 
 	/* Erase the gc'ed sector */
-	rc = nvs_flash_erase_sector(fs, sec_addr);
+	rc = nvs_flash_erase_sector(fs, gc->sec_addr);
+	if (rc) {
+		return rc;
+	}
+
+	gc->phase = NVS_GC_IDLE;
+
+	return 0;
+}
+
+/* garbage collection of the whole sector at once */
+static int nvs_gc(struct nvs_fs *fs)
+{
+	int rc;
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	struct nvs_gc_state *gc = &fs->gc;
+#else
+	struct nvs_gc_state gc_state;
+	struct nvs_gc_state *gc = &gc_state;
+#endif
+
+	rc = nvs_gc_start(fs, gc);
+
+	while (!rc && (gc->phase != NVS_GC_IDLE)) {
+		rc = nvs_gc_next(fs, gc);
+	}
+
+	return rc;
+}
+
+/* Space the pending garbage collection may still need in the write sector */
+static inline size_t nvs_gc_reserve(struct nvs_fs *fs)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	if (fs->gc.phase == NVS_GC_COPY) {
+		return fs->gc.need + fs->gc.slack;
+	}
+#endif
+
+	return 0;
+}
+
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+/* Run up to CONFIG_NVS_GC_SLICE copies, or the erase of the sector */
+static int nvs_gc_slice(struct nvs_fs *fs)
+{
+	int rc;
+
+	if (fs->gc.phase != NVS_GC_COPY) {
+		return nvs_gc_next(fs, &fs->gc);
+	}
+
+	for (int i = 0; (i < CONFIG_NVS_GC_SLICE) && (fs->gc.phase == NVS_GC_COPY); i++) {
+		rc = nvs_gc_next(fs, &fs->gc);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_NVS_GC_WORKQUEUE
+static void nvs_gc_work_handler(struct k_work *work)
+{
+	struct nvs_fs *fs = CONTAINER_OF(work, struct nvs_fs, gc_work);
+	int rc;
+
+	rc = nvs_gc_step(fs);
+	if (rc > 0) {
+		/* Let other work items run between slices */
+		(void)k_work_submit(work);
+	} else if (rc < 0) {
+		LOG_ERR("Garbage collection failed: %d", rc);
+	}
+}
+#endif
+
+/* Entries may have been written while the gc was running, so resume it
+ * rather than restarting it from an erased write sector.
+ */
+static int nvs_gc_resume(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t data_wra = fs->data_wra;
+
+	/* Keep what a write interrupted by the power loss left, the first
+	 * copy may complete it (see nvs_gc_torn_reuse()).
+	 */
+	rc = nvs_data_wra_recover(fs);
+	if (rc) {
+		return rc;
+	}
+
+	fs->gc.torn_end = fs->data_wra;
+	fs->data_wra = data_wra;
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	/* The lookup cache is not built yet, see the restart below */
+	for (int i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
+		fs->lookup_cache[i] = fs->ate_wra;
+	}
+#endif
+
+	rc = nvs_gc(fs);
+
+	/* Nothing was left to copy, or the interrupted write was not a copy */
+	fs->data_wra = MAX(fs->data_wra, fs->gc.torn_end);
+	fs->gc.torn_end = 0U;
 
 	return rc;
 }
+#endif /* CONFIG_NVS_GC_INCREMENTAL */
+
+/* start the garbage collection of the sector after a new write sector */
+static int nvs_gc_begin(struct nvs_fs *fs)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	int rc;
+
+	rc = nvs_gc_start(fs, &fs->gc);
+#ifdef CONFIG_NVS_GC_WORKQUEUE
+	if (!rc) {
+		(void)k_work_submit(&fs->gc_work);
+	}
+#endif
+
+	return rc;
+#else
+	return nvs_gc(fs);
+#endif
+}
 
 static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
 	struct nvs_ate last_ate;
-	size_t ate_size, empty_len;
+	size_t ate_size;
 	/* Initialize addr to 0 for the case fs->sector_count == 0. This
 	 * should never happen as this is verified in nvs_mount() but both
 	 * Coverity and GCC believe the contrary.
@@ -760,6 +1076,10 @@ static int nvs_startup(struct nvs_fs *fs)
 
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	fs->gc.phase = NVS_GC_IDLE;
+	fs->gc.torn_end = 0U;
+#endif
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 	/* step through the sectors to find a open sector following
 	 * a closed sector, this is where NVS can write.
@@ -909,6 +1229,20 @@ static int nvs_startup(struct nvs_fs *fs)
 			rc = nvs_flash_erase_sector(fs, addr);
 			goto end;
 		}
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+		/* Restarting the gc from an erased write sector would lose the
+		 * entries written during the gc. An interrupted copy is
+		 * completed in place, but a copy torn inside a write block has
+		 * to be made again: the room kept for that only allows one, so
+		 * fail if several power losses used it up.
+		 */
+		LOG_INF("No GC Done marker found: resuming gc");
+		rc = nvs_gc_resume(fs);
+		if (rc == -ENOSPC) {
+			LOG_ERR("No space left to resume gc");
+		}
+		goto end;
+#else
 		LOG_INF("No GC Done marker found: restarting gc");
 		rc = nvs_flash_erase_sector(fs, fs->ate_wra);
 		if (rc) {
@@ -929,22 +1263,12 @@ static int nvs_startup(struct nvs_fs *fs)
 #endif
 		rc = nvs_gc(fs);
 		goto end;
+#endif
 	}
 
-	/* possible data write after last ate write, update data_wra */
-	while (fs->ate_wra > fs->data_wra) {
-		empty_len = fs->ate_wra - fs->data_wra;
-
-		rc = nvs_flash_cmp_const(fs, fs->data_wra, erase_value,
-				empty_len);
-		if (rc < 0) {
-			goto end;
-		}
-		if (!rc) {
-			break;
-		}
-
-		fs->data_wra += fs->flash_parameters->write_block_size;
+	rc = nvs_data_wra_recover(fs);
+	if (rc) {
+		goto end;
 	}
 
 	/* If the ate_wra is pointing to the first ate write location in a
@@ -989,6 +1313,15 @@ int nvs_clear(struct nvs_fs *fs)
 		return -EACCES;
 	}
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+#ifdef CONFIG_NVS_GC_WORKQUEUE
+	struct k_work_sync sync;
+
+	(void)k_work_cancel_sync(&fs->gc_work, &sync);
+#endif
+	fs->gc.phase = NVS_GC_IDLE;
+#endif
+
 	for (uint16_t i = 0; i < fs->sector_count; i++) {
 		addr = i << ADDR_SECT_SHIFT;
 		rc = nvs_flash_erase_sector(fs, addr);
@@ -1009,6 +1342,13 @@ int nvs_mount(struct nvs_fs *fs)
 	struct flash_pages_info info;
 	size_t write_block_size;
 
+#ifdef CONFIG_NVS_GC_WORKQUEUE
+	struct k_work_sync sync;
+
+	/* The garbage collection of a previous mount may still be queued */
+	(void)k_work_cancel_sync(&fs->gc_work, &sync);
+	k_work_init(&fs->gc_work, nvs_gc_work_handler);
+#endif
 	k_mutex_init(&fs->nvs_lock);
 
 	fs->flash_parameters = flash_get_parameters(fs->flash_device);
@@ -1166,7 +1506,7 @@ no_cached_entry:
 			goto end;
 		}
 
-		if (fs->ate_wra >= (fs->data_wra + required_space)) {
+		if (fs->ate_wra >= (fs->data_wra + required_space + nvs_gc_reserve(fs))) {
 
 			rc = nvs_flash_wrt_entry(fs, id, data, len);
 			if (rc) {
@@ -1175,13 +1515,26 @@ no_cached_entry:
 			break;
 		}
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+		if (fs->gc.phase != NVS_GC_IDLE) {
+			/* The sector cannot be closed before the pending gc is
+			 * done, collect until the entry fits beside the copies
+			 * left to make.
+			 */
+			rc = nvs_gc_next(fs, &fs->gc);
+			if (rc) {
+				goto end;
+			}
+			continue;
+		}
+#endif
 
 		rc = nvs_sector_close(fs);
 		if (rc) {
 			goto end;
 		}
 
-		rc = nvs_gc(fs);
+		rc = nvs_gc_begin(fs);
 		if (rc) {
 			goto end;
 		}
@@ -1198,6 +1551,49 @@ int nvs_delete(struct nvs_fs *fs, uint16_t id)
 	return nvs_write(fs, id, NULL, 0);
 }
 
+/* Read the data of the entry described by the ATE at ate_addr */
+static ssize_t nvs_ate_data_rd(struct nvs_fs *fs, uint32_t ate_addr,
+			       const struct nvs_ate *ate, void *data, size_t len)
+{
+	int rc;
+	uint32_t rd_addr;
+#ifdef CONFIG_NVS_DATA_CRC
+	uint32_t read_data_crc, computed_data_crc;
+
+	/* When data CRC is enabled, there should be at least the CRC stored in the data field */
+	if (ate->len < NVS_DATA_CRC_SIZE) {
+		return -ENOENT;
+	}
+#endif
+
+	rd_addr = ate_addr & ADDR_SECT_MASK;
+	rd_addr += ate->offset;
+	rc = nvs_flash_rd(fs, rd_addr, data, MIN(len, ate->len - NVS_DATA_CRC_SIZE));
+	if (rc) {
+		return rc;
+	}
+
+	/* Check data CRC (only if the whole element data has been read) */
+#ifdef CONFIG_NVS_DATA_CRC
+	if (len >= (ate->len - NVS_DATA_CRC_SIZE)) {
+		rd_addr += ate->len - NVS_DATA_CRC_SIZE;
+		rc = nvs_flash_rd(fs, rd_addr, &read_data_crc, sizeof(read_data_crc));
+		if (rc) {
+			return rc;
+		}
+
+		computed_data_crc = crc32_ieee(data, ate->len - NVS_DATA_CRC_SIZE);
+		if (read_data_crc != computed_data_crc) {
+			LOG_ERR("Invalid data CRC: read_data_crc=0x%08X, computed_data_crc=0x%08X",
+				read_data_crc, computed_data_crc);
+			return -EIO;
+		}
+	}
+#endif
+
+	return ate->len - NVS_DATA_CRC_SIZE;
+}
+
 ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 		      uint16_t cnt)
 {
@@ -1206,9 +1602,6 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 	uint16_t cnt_his;
 	struct nvs_ate wlk_ate;
 	size_t ate_size;
-#ifdef CONFIG_NVS_DATA_CRC
-	uint32_t read_data_crc, computed_data_crc;
-#endif
 
 	if (!fs->ready) {
 		LOG_ERR("NVS not initialized");
@@ -1249,56 +1642,93 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 		}
 	}
 
-	if (((wlk_addr == fs->ate_wra) && (wlk_ate.id != id)) ||
+	if (((wlk_addr == fs->ate_wra) &&
+	     ((wlk_ate.id != id) || !nvs_ate_valid(fs, &wlk_ate))) ||
 	    (wlk_ate.len == 0U) || (cnt_his < cnt)) {
 		return -ENOENT;
 	}
 
-#ifdef CONFIG_NVS_DATA_CRC
-	/* When data CRC is enabled, there should be at least the CRC stored in the data field */
-	if (wlk_ate.len < NVS_DATA_CRC_SIZE) {
-		return -ENOENT;
-	}
-#endif
+	return nvs_ate_data_rd(fs, rd_addr, &wlk_ate, data, len);
 
-	rd_addr &= ADDR_SECT_MASK;
-	rd_addr += wlk_ate.offset;
-	rc = nvs_flash_rd(fs, rd_addr, data, MIN(len, wlk_ate.len - NVS_DATA_CRC_SIZE));
-	if (rc) {
-		goto err;
+err:
+	return rc;
+}
+
+ssize_t nvs_read(struct nvs_fs *fs, uint16_t id, void *data, size_t len)
+{
+	int rc;
+
+	rc = nvs_read_hist(fs, id, data, len, 0);
+	return rc;
+}
+
+int nvs_walk(struct nvs_fs *fs, nvs_walk_cb_t cb, void *arg)
+{
+	int rc;
+	uint32_t addr, ate_addr;
+	struct nvs_ate ate;
+	size_t len;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
 	}
 
-	/* Check data CRC (only if the whole element data has been read) */
-#ifdef CONFIG_NVS_DATA_CRC
-	if (len >= (wlk_ate.len - NVS_DATA_CRC_SIZE)) {
-		rd_addr += wlk_ate.len - NVS_DATA_CRC_SIZE;
-		rc = nvs_flash_rd(fs, rd_addr, &read_data_crc, sizeof(read_data_crc));
+	addr = fs->ate_wra;
+
+	while (true) {
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
 		if (rc) {
-			goto err;
+			return rc;
 		}
 
-		computed_data_crc = crc32_ieee(data, wlk_ate.len - NVS_DATA_CRC_SIZE);
-		if (read_data_crc != computed_data_crc) {
-			LOG_ERR("Invalid data CRC: read_data_crc=0x%08X, computed_data_crc=0x%08X",
-				read_data_crc, computed_data_crc);
-			rc = -EIO;
-			goto err;
+		if ((ate.id != 0xFFFF) && nvs_ate_valid(fs, &ate)) {
+			/* Entries too short to hold their data CRC read as deleted */
+			len = (ate.len >= NVS_DATA_CRC_SIZE) ? (ate.len - NVS_DATA_CRC_SIZE) : 0;
+
+			rc = cb(ate.id, len, ate_addr, arg);
+			if (rc) {
+				return rc;
+			}
 		}
-	}
-#endif
 
-	return wlk_ate.len - NVS_DATA_CRC_SIZE;
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
 
-err:
-	return rc;
+	return 0;
 }
 
-ssize_t nvs_read(struct nvs_fs *fs, uint16_t id, void *data, size_t len)
+ssize_t nvs_read_addr(struct nvs_fs *fs, uint16_t id, uint32_t addr, void *data,
+		      size_t len)
 {
 	int rc;
+	struct nvs_ate ate;
+	size_t ate_size;
 
-	rc = nvs_read_hist(fs, id, data, len, 0);
-	return rc;
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	if (len > (fs->sector_size - 2 * ate_size)) {
+		return -EINVAL;
+	}
+
+	rc = nvs_flash_ate_rd(fs, addr, &ate);
+	if (rc) {
+		return rc;
+	}
+
+	if ((ate.id != id) || !nvs_ate_valid(fs, &ate) || (ate.len == 0U)) {
+		return -ENOENT;
+	}
+
+	return nvs_ate_data_rd(fs, addr, &ate, data, len);
 }
 
 ssize_t nvs_calc_free_space(struct nvs_fs *fs)
@@ -1389,14 +1819,50 @@ int nvs_sector_use_next(struct nvs_fs *fs)
 
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	/* The sector to collect next must be erased before */
+	while (fs->gc.phase != NVS_GC_IDLE) {
+		ret = nvs_gc_next(fs, &fs->gc);
+		if (ret != 0) {
+			goto end;
+		}
+	}
+#endif
+
 	ret = nvs_sector_close(fs);
 	if (ret != 0) {
 		goto end;
 	}
 
-	ret = nvs_gc(fs);
+	ret = nvs_gc_begin(fs);
 
 end:
 	k_mutex_unlock(&fs->nvs_lock);
 	return ret;
 }
+
+int nvs_gc_step(struct nvs_fs *fs)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	int rc;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	rc = nvs_gc_slice(fs);
+	if (!rc) {
+		rc = (fs->gc.phase != NVS_GC_IDLE) ? 1 : 0;
+	}
+
+	k_mutex_unlock(&fs->nvs_lock);
+	return rc;
+#else
+	ARG_UNUSED(fs);
+
+	return -ENOTSUP;
+#endif
+}
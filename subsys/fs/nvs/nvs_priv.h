@@ -30,6 +30,13 @@ extern "C" {
 
 #define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
 
+/*
+ * Garbage collection steps
+ */
+#define NVS_GC_IDLE  0
+#define NVS_GC_COPY  1
+#define NVS_GC_ERASE 2
+
 /*
  * Allow to use the NVS_DATA_CRC_SIZE macro in computations whether data CRC is enabled or not
  */
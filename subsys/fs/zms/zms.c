@@ -17,15 +17,14 @@ LOG_MODULE_REGISTER(fs_zms, CONFIG_ZMS_LOG_LEVEL);
 
 static int zms_prev_ate(struct zms_fs *fs, uint64_t *addr, struct zms_ate *ate);
 static int zms_ate_valid(struct zms_fs *fs, const struct zms_ate *entry);
+static int zms_ate_crc8_check(const struct zms_ate *entry);
 static int zms_get_sector_cycle(struct zms_fs *fs, uint64_t addr, uint8_t *cycle_cnt);
 static int zms_get_sector_header(struct zms_fs *fs, uint64_t addr, struct zms_ate *empty_ate,
 				 struct zms_ate *close_ate);
 static int zms_ate_valid_different_sector(struct zms_fs *fs, const struct zms_ate *entry,
 					  uint8_t cycle_cnt);
 
-#ifdef CONFIG_ZMS_LOOKUP_CACHE
-
-static inline size_t zms_lookup_cache_pos(uint32_t id)
+static inline uint32_t zms_id_hash(uint32_t id)
 {
 	uint32_t hash;
 
@@ -37,7 +36,14 @@ static inline size_t zms_lookup_cache_pos(uint32_t id)
 	hash *= 0x846ca68bU;
 	hash ^= hash >> 16;
 
-	return hash % CONFIG_ZMS_LOOKUP_CACHE_SIZE;
+	return hash;
+}
+
+#ifdef CONFIG_ZMS_LOOKUP_CACHE
+
+static inline size_t zms_lookup_cache_pos(uint32_t id)
+{
+	return zms_id_hash(id) % CONFIG_ZMS_LOOKUP_CACHE_SIZE;
 }
 
 static int zms_lookup_cache_rebuild(struct zms_fs *fs)
@@ -106,6 +112,233 @@ static void zms_lookup_cache_invalidate(struct zms_fs *fs, uint32_t sector)
 
 #endif /* CONFIG_ZMS_LOOKUP_CACHE */
 
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+
+/* The lookup index is a hash table with linear probing holding the address
+ * of the most recent ATE of each ID, ZMS_HEAD_ID marking the free slots.
+ * A quarter of the slots stay free to keep the probe sequences short.
+ */
+#define ZMS_INDEX_MAX_USED (CONFIG_ZMS_LOOKUP_INDEX_SIZE * 3 / 4)
+
+static inline size_t zms_index_home(uint32_t id)
+{
+	return zms_id_hash(id) % CONFIG_ZMS_LOOKUP_INDEX_SIZE;
+}
+
+/* Returns true and the slot of id if it is in the index, false and the free
+ * slot where it would go otherwise.
+ */
+static bool zms_index_find(struct zms_fs *fs, uint32_t id, size_t *pos)
+{
+	size_t i = zms_index_home(id);
+
+	while (fs->index_id[i] != ZMS_HEAD_ID) {
+		if (fs->index_id[i] == id) {
+			*pos = i;
+			return true;
+		}
+
+		i = (i + 1) % CONFIG_ZMS_LOOKUP_INDEX_SIZE;
+	}
+
+	*pos = i;
+
+	return false;
+}
+
+static void zms_index_set(struct zms_fs *fs, uint32_t id, uint64_t addr)
+{
+	size_t pos;
+
+	if (zms_index_find(fs, id, &pos)) {
+		fs->index_addr[pos] = addr;
+		return;
+	}
+
+	if (fs->index_used >= ZMS_INDEX_MAX_USED) {
+		/* IDs missing from the index may now be stored all the same */
+		if (fs->index_complete) {
+			LOG_WRN("Lookup index full, searching for the IDs left out");
+			fs->index_complete = false;
+		}
+
+		return;
+	}
+
+	fs->index_id[pos] = id;
+	fs->index_addr[pos] = addr;
+	fs->index_used++;
+}
+
+static void zms_index_remove_at(struct zms_fs *fs, size_t pos)
+{
+	size_t next = pos;
+	size_t home;
+
+	/* Move back the following entries of the probe sequence which would
+	 * not be found anymore past the freed slot.
+	 */
+	while (true) {
+		next = (next + 1) % CONFIG_ZMS_LOOKUP_INDEX_SIZE;
+		if (fs->index_id[next] == ZMS_HEAD_ID) {
+			break;
+		}
+
+		home = zms_index_home(fs->index_id[next]);
+		if ((next > pos) ? ((home <= pos) || (home > next)) :
+				   ((home <= pos) && (home > next))) {
+			fs->index_id[pos] = fs->index_id[next];
+			fs->index_addr[pos] = fs->index_addr[next];
+			pos = next;
+		}
+	}
+
+	fs->index_id[pos] = ZMS_HEAD_ID;
+	fs->index_used--;
+}
+
+static void zms_index_remove(struct zms_fs *fs, uint32_t id)
+{
+	size_t pos;
+
+	if (zms_index_find(fs, id, &pos)) {
+		zms_index_remove_at(fs, pos);
+	}
+}
+
+/* Drop the entries without an address */
+static void zms_index_purge(struct zms_fs *fs)
+{
+	for (size_t i = 0; i < CONFIG_ZMS_LOOKUP_INDEX_SIZE; i++) {
+		/* Removing may move another entry to this slot */
+		while ((fs->index_id[i] != ZMS_HEAD_ID) &&
+		       (fs->index_addr[i] == ZMS_LOOKUP_CACHE_NO_ADDR)) {
+			zms_index_remove_at(fs, i);
+		}
+	}
+}
+
+static void zms_index_reset(struct zms_fs *fs)
+{
+	memset(fs->index_id, 0xff, sizeof(fs->index_id));
+	fs->index_used = 0;
+	fs->index_complete = false;
+}
+
+static int zms_index_rebuild(struct zms_fs *fs)
+{
+	int rc;
+	int previous_sector_num = ZMS_INVALID_SECTOR_NUM;
+	uint64_t addr;
+	uint64_t ate_addr;
+	uint8_t current_cycle;
+	struct zms_ate ate;
+	size_t pos;
+
+	zms_index_reset(fs);
+	fs->index_complete = true;
+	addr = fs->ate_wra;
+
+	while (true) {
+		/* Make a copy of 'addr' as it will be advanced by zms_prev_ate() */
+		ate_addr = addr;
+		rc = zms_prev_ate(fs, &addr, &ate);
+		if (rc) {
+			fs->index_complete = false;
+			return rc;
+		}
+
+		if (ate.id != ZMS_HEAD_ID && !zms_index_find(fs, ate.id, &pos)) {
+			/* read the ate cycle only when we change the sector
+			 * or if it is the first read
+			 */
+			if (SECTOR_NUM(ate_addr) != previous_sector_num) {
+				rc = zms_get_sector_cycle(fs, ate_addr, &current_cycle);
+				if (rc == -ENOENT) {
+					/* sector never used */
+					current_cycle = 0;
+				} else if (rc) {
+					/* bad flash read */
+					fs->index_complete = false;
+					return rc;
+				}
+			}
+			/* Deleted IDs are kept until the end so that their older
+			 * ATEs are not taken for the most recent ones.
+			 */
+			if (zms_ate_valid_different_sector(fs, &ate, current_cycle)) {
+				zms_index_set(fs, ate.id,
+					      ate.len ? ate_addr : ZMS_LOOKUP_CACHE_NO_ADDR);
+			}
+			previous_sector_num = SECTOR_NUM(ate_addr);
+		}
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	zms_index_purge(fs);
+
+	return 0;
+}
+
+static void zms_index_invalidate(struct zms_fs *fs, uint32_t sector)
+{
+	for (size_t i = 0; i < CONFIG_ZMS_LOOKUP_INDEX_SIZE; i++) {
+		if ((fs->index_id[i] != ZMS_HEAD_ID) && (SECTOR_NUM(fs->index_addr[i]) == sector)) {
+			fs->index_addr[i] = ZMS_LOOKUP_CACHE_NO_ADDR;
+		}
+	}
+
+	zms_index_purge(fs);
+}
+
+#endif /* CONFIG_ZMS_LOOKUP_INDEX */
+
+/* Address from which to search for any ATE of id without the lookup index,
+ * which only knows about the IDs currently stored.
+ */
+static uint64_t zms_lookup_scan_addr(struct zms_fs *fs, uint32_t id)
+{
+#ifdef CONFIG_ZMS_LOOKUP_CACHE
+	return fs->lookup_cache[zms_lookup_cache_pos(id)];
+#else
+	ARG_UNUSED(id);
+
+	return fs->ate_wra;
+#endif
+}
+
+/* Address from which to search for the most recent ATE of id, or
+ * ZMS_LOOKUP_CACHE_NO_ADDR if id is known not to be stored.
+ */
+static uint64_t zms_lookup_start_addr(struct zms_fs *fs, uint32_t id)
+{
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+	uint64_t addr = ZMS_LOOKUP_CACHE_NO_ADDR;
+	bool known = true;
+	size_t pos;
+
+	/* Removals move entries to earlier slots, so probing the index
+	 * while it is being written to could miss an ID which is stored.
+	 * The garbage collector calls this with the lock already held.
+	 */
+	k_mutex_lock(&fs->zms_lock, K_FOREVER);
+	if (zms_index_find(fs, id, &pos)) {
+		addr = fs->index_addr[pos];
+	} else if (!fs->index_complete) {
+		known = false;
+	}
+	k_mutex_unlock(&fs->zms_lock);
+
+	if (known) {
+		return addr;
+	}
+#endif
+	return zms_lookup_scan_addr(fs, id);
+}
+
 /* Helper to compute offset given the address */
 static inline off_t zms_addr_to_offset(struct zms_fs *fs, uint64_t addr)
 {
@@ -213,6 +446,16 @@ static int zms_flash_ate_wrt(struct zms_fs *fs, const struct zms_ate *entry)
 	if (entry->id != ZMS_HEAD_ID) {
 		fs->lookup_cache[zms_lookup_cache_pos(entry->id)] = fs->ate_wra;
 	}
+#endif
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+	/* The garbage ATEs filling a closed sector fail the CRC check */
+	if ((entry->id != ZMS_HEAD_ID) && !zms_ate_crc8_check(entry)) {
+		if (entry->len) {
+			zms_index_set(fs, entry->id, fs->ate_wra);
+		} else {
+			zms_index_remove(fs, entry->id);
+		}
+	}
 #endif
 	fs->ate_wra -= zms_al_size(fs, sizeof(struct zms_ate));
 end:
@@ -347,6 +590,9 @@ static int zms_flash_erase_sector(struct zms_fs *fs, uint64_t addr)
 
 #ifdef CONFIG_ZMS_LOOKUP_CACHE
 	zms_lookup_cache_invalidate(fs, SECTOR_NUM(addr));
+#endif
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+	zms_index_invalidate(fs, SECTOR_NUM(addr));
 #endif
 	rc = flash_erase(fs->flash_device, offset, fs->sector_size);
 
@@ -950,15 +1196,11 @@ static int zms_gc(struct zms_fs *fs)
 			continue;
 		}
 
-#ifdef CONFIG_ZMS_LOOKUP_CACHE
-		wlk_addr = fs->lookup_cache[zms_lookup_cache_pos(gc_ate.id)];
+		wlk_addr = zms_lookup_start_addr(fs, gc_ate.id);
 
 		if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
 			wlk_addr = fs->ate_wra;
 		}
-#else
-		wlk_addr = fs->ate_wra;
-#endif
 
 		/* Initialize the wlk_prev_addr as if no previous ID will be found */
 		wlk_prev_addr = gc_prev_addr;
@@ -1022,6 +1264,9 @@ gc_done:
 
 #ifdef CONFIG_ZMS_LOOKUP_CACHE
 	zms_lookup_cache_invalidate(fs, sec_addr >> ADDR_SECT_SHIFT);
+#endif
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+	zms_index_invalidate(fs, sec_addr >> ADDR_SECT_SHIFT);
 #endif
 	rc = zms_add_empty_ate(fs, sec_addr);
 
@@ -1076,6 +1321,11 @@ static int zms_init(struct zms_fs *fs)
 
 	k_mutex_lock(&fs->zms_lock, K_FOREVER);
 
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+	/* Not built yet, lookups fall back to searching */
+	zms_index_reset(fs);
+#endif
+
 	/* step through the sectors to find a open sector following
 	 * a closed sector, this is where zms can write.
 	 */
@@ -1308,6 +1558,11 @@ end:
 	if (!rc) {
 		rc = zms_lookup_cache_rebuild(fs);
 	}
+#endif
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+	if (!rc) {
+		rc = zms_index_rebuild(fs);
+	}
 #endif
 	/* If the sector is empty add a gc done ate to avoid having insufficient
 	 * space when doing gc.
@@ -1415,15 +1670,11 @@ ssize_t zms_write(struct zms_fs *fs, uint32_t id, const void *data, size_t len)
 	}
 
 	/* find latest entry with same id */
-#ifdef CONFIG_ZMS_LOOKUP_CACHE
-	wlk_addr = fs->lookup_cache[zms_lookup_cache_pos(id)];
+	wlk_addr = zms_lookup_start_addr(fs, id);
 
 	if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
 		goto no_cached_entry;
 	}
-#else
-	wlk_addr = fs->ate_wra;
-#endif
 	rd_addr = wlk_addr;
 
 #ifdef CONFIG_ZMS_NO_DOUBLE_WRITE
@@ -1472,9 +1723,7 @@ ssize_t zms_write(struct zms_fs *fs, uint32_t id, const void *data, size_t len)
 	}
 #endif
 
-#ifdef CONFIG_ZMS_LOOKUP_CACHE
 no_cached_entry:
-#endif
 	/* calculate required space if the entry contains data */
 	if (data_size) {
 		/* Leave space for delete ate */
@@ -1555,16 +1804,15 @@ ssize_t zms_read_hist(struct zms_fs *fs, uint32_t id, void *data, size_t len, ui
 
 	cnt_his = 0U;
 
-#ifdef CONFIG_ZMS_LOOKUP_CACHE
-	wlk_addr = fs->lookup_cache[zms_lookup_cache_pos(id)];
+	/* The lookup index drops deleted IDs, whose older versions may
+	 * still be read from the history.
+	 */
+	wlk_addr = (cnt == 0U) ? zms_lookup_start_addr(fs, id) : zms_lookup_scan_addr(fs, id);
 
 	if (wlk_addr == ZMS_LOOKUP_CACHE_NO_ADDR) {
 		rc = -ENOENT;
 		goto err;
 	}
-#else
-	wlk_addr = fs->ate_wra;
-#endif
 
 	while (cnt_his <= cnt) {
 		wlk_prev_addr = wlk_addr;
@@ -227,8 +227,8 @@ const struct log_backend_api log_backend_uart_api = {
 
 #define LBU_DEFINE(node_id, ...)                                                                   \
 	static uint8_t lbu_buffer##__VA_ARGS__[CONFIG_LOG_BACKEND_UART_BUFFER_SIZE];               \
-	LOG_OUTPUT_DEFINE(lbu_output##__VA_ARGS__, char_out, lbu_buffer##__VA_ARGS__,              \
-			  CONFIG_LOG_BACKEND_UART_BUFFER_SIZE);                                    \
+	LOG_OUTPUT_DICT_DEFINE(lbu_output##__VA_ARGS__, char_out, lbu_buffer##__VA_ARGS__,         \
+			       CONFIG_LOG_BACKEND_UART_BUFFER_SIZE);                               \
                                                                                                    \
 	static struct lbu_data lbu_data##__VA_ARGS__ = {                                           \
 		.log_format_current = CONFIG_LOG_BACKEND_UART_OUTPUT_DEFAULT,                      \
@@ -27,6 +27,10 @@
 #include <zephyr/posix/time.h>
 #endif
 
+#ifdef CONFIG_SYS_PANIC_FLUSH
+#include <zephyr/sys/panic_flush.h>
+#endif
+
 LOG_MODULE_REGISTER(log);
 
 #ifndef CONFIG_LOG_PROCESS_THREAD_SLEEP_MS
@@ -104,6 +108,9 @@ static bool panic_mode;
 static bool backend_attached;
 static atomic_t buffered_cnt;
 static atomic_t dropped_cnt;
+#ifdef CONFIG_LOG_CPU_BUFFERS
+static atomic_t cpu_dropped_cnt[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 static k_tid_t proc_tid;
 static struct k_timer log_process_thread_timer;
 
@@ -137,6 +144,16 @@ static const struct mpsc_pbuf_buffer_config mpsc_config = {
 		 (IS_ENABLED(CONFIG_LOG_MEM_UTILIZATION) ?
 		  MPSC_PBUF_MAX_UTILIZATION : 0)
 };
+
+#ifdef CONFIG_LOG_CPU_BUFFERS
+/* CPU 0 uses log_buffer, each other CPU has one of these. */
+static uint32_t __aligned(Z_LOG_MSG_ALIGNMENT)
+	cpu_buf32[CONFIG_MP_MAX_NUM_CPUS - 1][CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
+static struct mpsc_pbuf_buffer cpu_log_buffer[CONFIG_MP_MAX_NUM_CPUS - 1];
+
+/* Message claimed from each CPU buffer and waiting for its turn. */
+static union log_msg_generic *cpu_msg[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 #endif
 
 /* Check that default tag can fit in tag buffer. */
@@ -253,6 +270,11 @@ void log_core_init(void)
 	panic_mode = false;
 	dropped_cnt = 0;
 	buffered_cnt = 0;
+#ifdef CONFIG_LOG_CPU_BUFFERS
+	for (int i = 0; i < ARRAY_SIZE(cpu_dropped_cnt); i++) {
+		cpu_dropped_cnt[i] = 0;
+	}
+#endif
 
 	if (IS_ENABLED(CONFIG_LOG_FRONTEND)) {
 		log_frontend_init();
@@ -427,6 +449,11 @@ void z_impl_log_panic(void)
 		return;
 	}
 
+#ifdef CONFIG_SYS_PANIC_FLUSH
+	/* Data kept in RAM would be lost if the system goes down */
+	sys_panic_flush_run(K_NO_WAIT);
+#endif
+
 	/* If panic happened early logger might not be initialized.
 	 * Forcing initialization of the logger and auto-starting backends.
 	 */
@@ -615,6 +642,9 @@ uint32_t z_vrfy_log_buffered_cnt(void)
 void z_log_dropped(bool buffered)
 {
 	atomic_inc(&dropped_cnt);
+#ifdef CONFIG_LOG_CPU_BUFFERS
+	atomic_inc(&cpu_dropped_cnt[arch_curr_cpu()->id]);
+#endif
 	if (buffered) {
 		atomic_dec(&buffered_cnt);
 	}
@@ -635,12 +665,64 @@ bool z_log_dropped_pending(void)
 	return dropped_cnt > 0;
 }
 
+int log_dropped_cpu_get(unsigned int cpu, uint32_t *cnt)
+{
+	__ASSERT_NO_MSG(cnt != NULL);
+
+#ifdef CONFIG_LOG_CPU_BUFFERS
+	if (cpu >= arch_num_cpus()) {
+		return -EINVAL;
+	}
+
+	*cnt = atomic_get(&cpu_dropped_cnt[cpu]);
+
+	return 0;
+#else
+	ARG_UNUSED(cpu);
+
+	return -ENOTSUP;
+#endif
+}
+
+#ifdef CONFIG_LOG_CPU_BUFFERS
+static struct mpsc_pbuf_buffer *cpu_buffer_get(unsigned int cpu)
+{
+	return (cpu == 0U) ? &log_buffer : &cpu_log_buffer[cpu - 1U];
+}
+
+/* A thread may move to another CPU between allocating and committing a
+ * message, so find the buffer from the message address.
+ */
+static struct mpsc_pbuf_buffer *msg_buffer_get(struct log_msg *msg)
+{
+	uintptr_t offset = (uintptr_t)msg - (uintptr_t)cpu_buf32;
+
+	if (offset < sizeof(cpu_buf32)) {
+		return &cpu_log_buffer[offset / sizeof(cpu_buf32[0])];
+	}
+
+	return &log_buffer;
+}
+#endif
+
 void z_log_msg_init(void)
 {
 #ifdef CONFIG_MPSC_PBUF
 	mpsc_pbuf_init(&log_buffer, &mpsc_config);
 	curr_log_buffer = &log_buffer;
 #endif
+#ifdef CONFIG_LOG_CPU_BUFFERS
+	for (int i = 0; i < ARRAY_SIZE(cpu_log_buffer); i++) {
+		struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+		config.buf = cpu_buf32[i];
+		mpsc_pbuf_init(&cpu_log_buffer[i], &config);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(cpu_msg); i++) {
+		cpu_msg[i] = NULL;
+	}
+#endif
 }
 
 static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
@@ -658,7 +740,14 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
+#ifdef CONFIG_LOG_CPU_BUFFERS
+	/* If the thread moves to another CPU meanwhile it just shares that
+	 * buffer for one message.
+	 */
+	return msg_alloc(cpu_buffer_get(arch_curr_cpu()->id), wlen);
+#else
 	return msg_alloc(&log_buffer, wlen);
+#endif
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -690,7 +779,11 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 void z_log_msg_commit(struct log_msg *msg)
 {
 	msg->hdr.timestamp = timestamp_func();
+#ifdef CONFIG_LOG_CPU_BUFFERS
+	msg_commit(msg_buffer_get(msg), msg);
+#else
 	msg_commit(&log_buffer, msg);
+#endif
 }
 
 union log_msg_generic *z_log_msg_local_claim(void)
@@ -770,10 +863,52 @@ union log_msg_generic *z_log_msg_claim_oldest(k_timeout_t *backoff)
 	return msg;
 }
 
+#ifdef CONFIG_LOG_CPU_BUFFERS
+/* Claim the oldest of the messages pending in the CPU buffers, keeping the
+ * others claimed so that they are not compared again on the next call.
+ */
+static union log_msg_generic *cpu_msg_claim_oldest(void)
+{
+	union log_msg_generic *msg = NULL;
+	log_timestamp_t t_min = 0;
+	unsigned int chosen = 0;
+
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		if (cpu_msg[cpu] == NULL) {
+			cpu_msg[cpu] = (union log_msg_generic *)mpsc_pbuf_claim(
+				cpu_buffer_get(cpu));
+		}
+
+		if (cpu_msg[cpu]) {
+			log_timestamp_t t = log_msg_get_timestamp(&cpu_msg[cpu]->log);
+
+			if ((msg == NULL) || (t < t_min)) {
+				t_min = t;
+				msg = cpu_msg[cpu];
+				chosen = cpu;
+			}
+		}
+	}
+
+	if (msg) {
+		cpu_msg[chosen] = NULL;
+		curr_log_buffer = cpu_buffer_get(chosen);
+	}
+
+	return msg;
+}
+#endif
+
 union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 {
 	size_t len;
 
+#ifdef CONFIG_LOG_CPU_BUFFERS
+	ARG_UNUSED(backoff);
+
+	return cpu_msg_claim_oldest();
+#endif
+
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	/* Use only one buffer if others are not registered. */
@@ -810,6 +945,16 @@ bool z_log_msg_pending(void)
 	size_t len;
 	int i = 0;
 
+#ifdef CONFIG_LOG_CPU_BUFFERS
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		if (cpu_msg[cpu] || msg_pending(cpu_buffer_get(cpu))) {
+			return true;
+		}
+	}
+
+	return false;
+#endif
+
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) {
@@ -894,6 +1039,17 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 
 	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
 
+#ifdef CONFIG_LOG_CPU_BUFFERS
+	for (int i = 0; i < ARRAY_SIZE(cpu_log_buffer); i++) {
+		uint32_t cpu_size;
+		uint32_t cpu_usage;
+
+		mpsc_pbuf_get_utilization(&cpu_log_buffer[i], &cpu_size, &cpu_usage);
+		*buf_size += cpu_size;
+		*usage += cpu_usage;
+	}
+#endif
+
 	return 0;
 }
 
@@ -905,7 +1061,28 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_LOG_CPU_BUFFERS
+	/* Peaks of the CPU buffers need not coincide, their sum is an upper
+	 * bound of the total.
+	 */
+	uint32_t total;
+	int err = mpsc_pbuf_get_max_utilization(&log_buffer, &total);
+
+	for (int i = 0; (err == 0) && (i < ARRAY_SIZE(cpu_log_buffer)); i++) {
+		uint32_t cpu_max;
+
+		err = mpsc_pbuf_get_max_utilization(&cpu_log_buffer[i], &cpu_max);
+		total += cpu_max;
+	}
+
+	if (err == 0) {
+		*max = total;
+	}
+
+	return err;
+#else
 	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+#endif
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
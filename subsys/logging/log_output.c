@@ -12,7 +12,9 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/sys/cbprintf.h>
+#include <zephyr/sys/util.h>
 #include <ctype.h>
+#include <string.h>
 #include <time.h>
 #include <stdio.h>
 #include <stdbool.h>
@@ -90,32 +92,54 @@ static int level_to_rfc5424_severity(uint32_t level)
 	return ret;
 }
 
+/* An output instance is only used by one context at a time (see
+ * log_output_process()), so the offset is a plain size_t.
+ */
 static int out_func(int c, void *ctx)
 {
 	const struct log_output *out_ctx = (const struct log_output *)ctx;
-	int idx;
-
-	if (IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE)) {
-		/* Backend must be thread safe in synchronous operation. */
-		/* Need that step for big endian */
-		char x = (char)c;
-
-		out_ctx->func((uint8_t *)&x, 1, out_ctx->control_block->ctx);
-		return 0;
-	}
+	struct log_output_control_block *control_block = out_ctx->control_block;
 
-	if (out_ctx->control_block->offset == out_ctx->size) {
+	if (control_block->offset == out_ctx->size) {
 		log_output_flush(out_ctx);
 	}
 
-	idx = atomic_inc(&out_ctx->control_block->offset);
-	out_ctx->buf[idx] = (uint8_t)c;
+	out_ctx->buf[control_block->offset++] = (uint8_t)c;
 
-	__ASSERT_NO_MSG(out_ctx->control_block->offset <= out_ctx->size);
+	__ASSERT_NO_MSG(control_block->offset <= out_ctx->size);
 
 	return 0;
 }
 
+/* Copy a whole span to the buffer instead of going through out_func(). */
+static void out_write(const struct log_output *output, const char *data, size_t len)
+{
+	struct log_output_control_block *control_block = output->control_block;
+
+	while (len > 0) {
+		size_t chunk;
+
+		if (control_block->offset == output->size) {
+			log_output_flush(output);
+		}
+
+		chunk = MIN(len, output->size - control_block->offset);
+		memcpy(&output->buf[control_block->offset], data, chunk);
+		control_block->offset += chunk;
+		data += chunk;
+		len -= chunk;
+	}
+}
+
+static int out_str(const struct log_output *output, const char *str)
+{
+	size_t len = strlen(str);
+
+	out_write(output, str, len);
+
+	return (int)len;
+}
+
 static int cr_out_func(int c, void *ctx)
 {
 	if (c == '\n') {
@@ -277,7 +301,7 @@ static void color_print(const struct log_output *output,
 	if (color) {
 		const char *log_color = start && (colors[level] != NULL) ?
 				colors[level] : LOG_COLOR_CODE_DEFAULT;
-		print_formatted(output, "%s", log_color);
+		out_str(output, log_color);
 	}
 }
 
@@ -306,7 +330,9 @@ static int ids_print(const struct log_output *output,
 	int total = 0;
 
 	if (level_on) {
-		total += print_formatted(output, "<%s> ", severity[level]);
+		total += out_str(output, "<");
+		total += out_str(output, severity[level]);
+		total += out_str(output, "> ");
 	}
 
 	if (IS_ENABLED(CONFIG_LOG_THREAD_ID_PREFIX) && thread_on) {
@@ -319,15 +345,16 @@ static int ids_print(const struct log_output *output,
 	}
 
 	if (domain) {
-		total += print_formatted(output, "%s/", domain);
+		total += out_str(output, domain);
+		total += out_str(output, "/");
 	}
 
 	if (source) {
-		total += print_formatted(output,
+		total += out_str(output, source);
+		total += out_str(output,
 				(func_on &&
 				((1 << level) & LOG_FUNCTION_PREFIX_MASK)) ?
-				"%s." : "%s: ",
-				source);
+				"." : ": ");
 	}
 
 	return total;
@@ -345,9 +372,9 @@ static void newline_print(const struct log_output *ctx, uint32_t flags)
 	}
 
 	if ((flags & LOG_OUTPUT_FLAG_CRLF_LFONLY) != 0U) {
-		print_formatted(ctx, "\n");
+		out_str(ctx, "\n");
 	} else {
-		print_formatted(ctx, "\r\n");
+		out_str(ctx, "\r\n");
 	}
 }
 
@@ -355,40 +382,49 @@ static void hexdump_line_print(const struct log_output *output,
 			       const uint8_t *data, uint32_t length,
 			       int prefix_offset, uint32_t flags)
 {
+	/* Hex bytes, separator and characters, with a space every 8 bytes */
+	char line[HEXDUMP_BYTES_IN_LINE * 4 + 3];
+	size_t pos = 0;
+
 	newline_print(output, flags);
 
 	for (int i = 0; i < prefix_offset; i++) {
-		print_formatted(output, " ");
+		out_write(output, " ", 1);
 	}
 
 	for (int i = 0; i < HEXDUMP_BYTES_IN_LINE; i++) {
 		if (i > 0 && !(i % 8)) {
-			print_formatted(output, " ");
+			line[pos++] = ' ';
 		}
 
 		if (i < length) {
-			print_formatted(output, "%02x ", data[i]);
+			(void)hex2char(data[i] >> 4, &line[pos++]);
+			(void)hex2char(data[i] & 0x0F, &line[pos++]);
 		} else {
-			print_formatted(output, "   ");
+			line[pos++] = ' ';
+			line[pos++] = ' ';
 		}
+
+		line[pos++] = ' ';
 	}
 
-	print_formatted(output, "|");
+	line[pos++] = '|';
 
 	for (int i = 0; i < HEXDUMP_BYTES_IN_LINE; i++) {
 		if (i > 0 && !(i % 8)) {
-			print_formatted(output, " ");
+			line[pos++] = ' ';
 		}
 
 		if (i < length) {
 			unsigned char c = (unsigned char)data[i];
 
-			print_formatted(output, "%c",
-			      isprint((int)c) != 0 ? c : '.');
+			line[pos++] = isprint((int)c) != 0 ? c : '.';
 		} else {
-			print_formatted(output, " ");
+			line[pos++] = ' ';
 		}
 	}
+
+	out_write(output, line, pos);
 }
 
 static void log_msg_hexdump(const struct log_output *output,
@@ -652,6 +688,25 @@ void log_output_process(const struct log_output *output,
 	uint32_t prefix_offset;
 	cbprintf_cb cb;
 
+#ifdef CONFIG_LOG_MODE_IMMEDIATE
+	/* Several contexts may log at once, so each formats on its own stack
+	 * rather than in the buffer of the instance.
+	 */
+	uint8_t buf[CONFIG_LOG_IMMEDIATE_OUTPUT_BUF_SIZE];
+	struct log_output_control_block control_block = {
+		.ctx = output->control_block->ctx,
+		.hostname = output->control_block->hostname,
+	};
+	const struct log_output stack_output = {
+		.func = output->func,
+		.control_block = &control_block,
+		.buf = buf,
+		.size = sizeof(buf),
+	};
+
+	output = &stack_output;
+#endif
+
 	if (!raw_string) {
 		prefix_offset = prefix_print(output, flags, 0, timestamp,
 					     domain, source, tid, level);
@@ -11,6 +11,315 @@
 #include <zephyr/logging/log_output_dict.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/sys/util.h>
+#include <string.h>
+
+#ifdef CONFIG_LOG_DICTIONARY_COMPACT
+
+#define VARINT_MAX_LEN 10
+
+/* Shortest match worth a back reference and the nibble value for longer
+ * literal runs or matches, see log_output_dict.h.
+ */
+#define LZ_MIN_MATCH 3
+#define LZ_LEN_EXT   15
+
+/* Staging buffer of a message, or the output itself if buf is NULL */
+struct dict_sink {
+	const struct log_output *output;
+	uint8_t *buf;
+	size_t len;
+	size_t size;
+};
+
+static void dict_write(const struct log_output *output, const uint8_t *data, size_t len)
+{
+	struct log_output_control_block *control_block = output->control_block;
+
+	/* Contexts logging at once in immediate mode must not share the buffer */
+	if (IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE)) {
+		log_output_write(output->func, (uint8_t *)data, len, control_block->ctx);
+		return;
+	}
+
+	while (len > 0) {
+		size_t chunk;
+
+		if (control_block->offset == output->size) {
+			log_output_flush(output);
+		}
+
+		chunk = MIN(len, output->size - control_block->offset);
+		memcpy(&output->buf[control_block->offset], data, chunk);
+		control_block->offset += chunk;
+		data += chunk;
+		len -= chunk;
+	}
+}
+
+static bool sink_put(struct dict_sink *sink, const uint8_t *data, size_t len)
+{
+	if (len == 0) {
+		return true;
+	}
+
+	if (sink->buf == NULL) {
+		dict_write(sink->output, data, len);
+		return true;
+	}
+
+	if (len > (sink->size - sink->len)) {
+		return false;
+	}
+
+	memcpy(&sink->buf[sink->len], data, len);
+	sink->len += len;
+
+	return true;
+}
+
+static size_t varint_put(uint8_t *buf, uint64_t value)
+{
+	size_t len = 0;
+
+	do {
+		buf[len] = value & 0x7F;
+		value >>= 7;
+		buf[len++] |= (value != 0) ? 0x80 : 0;
+	} while (value != 0);
+
+	return len;
+}
+
+static inline uint32_t zigzag32(uint32_t value)
+{
+	return (value << 1) ^ (uint32_t)((int32_t)value >> 31);
+}
+
+static inline uint64_t zigzag_timestamp(log_timestamp_t delta)
+{
+#ifdef CONFIG_LOG_TIMESTAMP_64BIT
+	return (delta << 1) ^ (uint64_t)((int64_t)delta >> 63);
+#else
+	return zigzag32(delta);
+#endif
+}
+
+static bool compact_msg_put(struct dict_sink *sink, struct log_msg *msg,
+			    log_timestamp_t delta)
+{
+	void *source = (void *)log_msg_get_source(msg);
+	uint8_t hdr[1 + 4 * VARINT_MAX_LEN];
+	uint8_t word_buf[VARINT_MAX_LEN];
+	size_t pkg_len;
+	size_t data_len;
+	uint8_t *package = log_msg_get_package(msg, &pkg_len);
+	uint8_t *data = log_msg_get_data(msg, &data_len);
+	size_t words = 0;
+	size_t pos = 0;
+
+	hdr[pos++] = (msg->hdr.desc.level << 4) | (msg->hdr.desc.domain & 0x0F);
+	pos += varint_put(&hdr[pos], (source != NULL) ? log_source_id(source) : 0U);
+	pos += varint_put(&hdr[pos], zigzag_timestamp(delta));
+	pos += varint_put(&hdr[pos], pkg_len);
+	pos += varint_put(&hdr[pos], data_len);
+
+	if (!sink_put(sink, hdr, pos)) {
+		return false;
+	}
+
+	if (pkg_len >= sizeof(uint32_t)) {
+		/* First byte of the header is the length of the arguments */
+		words = CLAMP(package[0], 1, pkg_len / sizeof(uint32_t));
+	}
+
+	for (size_t i = 0; i < words; i++) {
+		uint32_t word;
+
+		memcpy(&word, &package[i * sizeof(word)], sizeof(word));
+		pos = varint_put(word_buf, zigzag32(word));
+
+		if (!sink_put(sink, word_buf, pos)) {
+			return false;
+		}
+	}
+
+	words *= sizeof(uint32_t);
+
+	return sink_put(sink, &package[words], pkg_len - words) &&
+	       sink_put(sink, data, data_len);
+}
+
+#ifdef CONFIG_LOG_DICTIONARY_COMPRESS
+static bool lz_seq_put(struct dict_sink *out, const uint8_t *lit, size_t lit_len,
+		       size_t distance, size_t match_len)
+{
+	size_t match_code = (match_len != 0) ? (match_len - LZ_MIN_MATCH) : 0;
+	uint8_t seq[1 + 2 * VARINT_MAX_LEN];
+	size_t pos = 1;
+
+	seq[0] = (MIN(lit_len, LZ_LEN_EXT) << 4) | MIN(match_code, LZ_LEN_EXT);
+	if (lit_len >= LZ_LEN_EXT) {
+		pos += varint_put(&seq[pos], lit_len - LZ_LEN_EXT);
+	}
+
+	if (!sink_put(out, seq, pos) || !sink_put(out, lit, lit_len)) {
+		return false;
+	}
+
+	if (match_len == 0) {
+		return true;
+	}
+
+	pos = varint_put(seq, distance);
+	if (match_code >= LZ_LEN_EXT) {
+		pos += varint_put(&seq[pos], match_code - LZ_LEN_EXT);
+	}
+
+	return sink_put(out, seq, pos);
+}
+
+/* Greedy LZ77 of the message following the history in buf, taking the
+ * nearest of the longest matches. Matches may run into the message itself.
+ */
+static bool lz_compress(const uint8_t *buf, size_t history_len, size_t len,
+			struct dict_sink *out)
+{
+	const uint8_t *msg = &buf[history_len];
+	size_t lit_start = 0;
+	size_t pos = 0;
+
+	while ((pos + LZ_MIN_MATCH) <= len) {
+		size_t cur = history_len + pos;
+		size_t first = (cur > CONFIG_LOG_DICTIONARY_COMPRESS_WINDOW) ?
+			       (cur - CONFIG_LOG_DICTIONARY_COMPRESS_WINDOW) : 0;
+		size_t best_len = 0;
+		size_t best_distance = 0;
+
+		for (size_t start = cur; (start-- > first) && ((pos + best_len) < len);) {
+			size_t match_len = 0;
+
+			while (((pos + match_len) < len) &&
+			       (buf[start + match_len] == msg[pos + match_len])) {
+				match_len++;
+			}
+
+			if (match_len > best_len) {
+				best_len = match_len;
+				best_distance = cur - start;
+			}
+		}
+
+		if (best_len < LZ_MIN_MATCH) {
+			pos++;
+			continue;
+		}
+
+		if (!lz_seq_put(out, &msg[lit_start], pos - lit_start, best_distance,
+				best_len)) {
+			return false;
+		}
+
+		pos += best_len;
+		lit_start = pos;
+	}
+
+	return (lit_start == len) ||
+	       lz_seq_put(out, &msg[lit_start], len - lit_start, 0, 0);
+}
+
+/* Compress the message when it fits in the staging buffer, returns false
+ * if it has to be sent uncompressed.
+ */
+static bool compact_msg_compress(const struct log_output *output,
+				 struct log_dict_output_state *state,
+				 struct log_msg *msg, log_timestamp_t delta)
+{
+	struct dict_sink staging = {
+		.buf = &state->buf[state->history_len],
+		.size = CONFIG_LOG_DICTIONARY_COMPRESS_MAX_MSG,
+	};
+	struct dict_sink compressed = {
+		.buf = state->out,
+		.size = sizeof(state->out),
+	};
+	uint8_t hdr[1 + VARINT_MAX_LEN];
+	size_t total;
+	size_t keep;
+
+	if (!compact_msg_put(&staging, msg, delta) ||
+	    !lz_compress(state->buf, state->history_len, staging.len, &compressed)) {
+		return false;
+	}
+
+	hdr[0] = MSG_COMPACT_LZ;
+	dict_write(output, hdr, 1 + varint_put(&hdr[1], staging.len));
+	dict_write(output, compressed.buf, compressed.len);
+
+	/* Keep the latest part of the stream as history */
+	total = state->history_len + staging.len;
+	keep = MIN(total, CONFIG_LOG_DICTIONARY_COMPRESS_WINDOW);
+	memmove(state->buf, &state->buf[total - keep], keep);
+	state->history_len = keep;
+
+	return true;
+}
+#endif /* CONFIG_LOG_DICTIONARY_COMPRESS */
+
+/* Reset record, from which the parser can decode the stream */
+static void compact_sync_put(const struct log_output *output,
+			     struct log_dict_output_state *state,
+			     log_timestamp_t timestamp)
+{
+	static const uint8_t sync[] = LOG_DICT_COMPACT_SYNC;
+	uint8_t rec[1 + sizeof(sync) + VARINT_MAX_LEN];
+
+	rec[0] = MSG_COMPACT_RESET;
+	memcpy(&rec[1], sync, sizeof(sync));
+	dict_write(output, rec, 1 + sizeof(sync) +
+		   varint_put(&rec[1 + sizeof(sync)], timestamp));
+
+	state->timestamp = timestamp;
+	state->since_sync = 0;
+	state->started = true;
+#ifdef CONFIG_LOG_DICTIONARY_COMPRESS
+	state->history_len = 0;
+#endif
+}
+
+static void compact_msg_process(const struct log_output *output, struct log_msg *msg)
+{
+	struct log_dict_output_state *state = output->dict_state;
+	log_timestamp_t timestamp = log_msg_get_timestamp(msg);
+	log_timestamp_t delta;
+	struct dict_sink direct = {
+		.output = output,
+	};
+	uint8_t type;
+
+	if (!state->started ||
+	    ((CONFIG_LOG_DICTIONARY_COMPACT_SYNC_INTERVAL > 0) &&
+	     (state->since_sync >= CONFIG_LOG_DICTIONARY_COMPACT_SYNC_INTERVAL))) {
+		compact_sync_put(output, state, timestamp);
+	}
+
+	delta = timestamp - state->timestamp;
+	state->timestamp = timestamp;
+	state->since_sync++;
+
+#ifdef CONFIG_LOG_DICTIONARY_COMPRESS
+	if (compact_msg_compress(output, state, msg, delta)) {
+		log_output_flush(output);
+		return;
+	}
+#endif
+
+	type = MSG_COMPACT;
+	dict_write(output, &type, sizeof(type));
+	(void)compact_msg_put(&direct, msg, delta);
+
+	log_output_flush(output);
+}
+#endif /* CONFIG_LOG_DICTIONARY_COMPACT */
 
 void log_dict_output_msg_process(const struct log_output *output,
 				 struct log_msg *msg, uint32_t flags)
@@ -18,6 +327,13 @@ void log_dict_output_msg_process(const struct log_output *output,
 	struct log_dict_output_normal_msg_hdr_t output_hdr;
 	void *source = (void *)log_msg_get_source(msg);
 
+#ifdef CONFIG_LOG_DICTIONARY_COMPACT
+	if (output->dict_state != NULL) {
+		compact_msg_process(output, msg);
+		return;
+	}
+#endif
+
 	/* Keep sync with header in struct log_msg */
 	output_hdr.type = MSG_NORMAL;
 	output_hdr.domain = msg->hdr.desc.domain;
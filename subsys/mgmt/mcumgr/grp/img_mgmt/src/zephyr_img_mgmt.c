@@ -405,6 +405,9 @@ int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned in
 	}
 
 	if (flash_img_buffered_write(ctx, data, num_bytes, last) != 0) {
+#ifdef CONFIG_IMG_WRITE_BEHIND
+		(void)stream_flash_write_behind_stop(&ctx->stream);
+#endif
 		rc = IMG_MGMT_ERR_FLASH_WRITE_FAILED;
 		goto out;
 	}
@@ -422,11 +425,23 @@ int img_mgmt_write_image_data(unsigned int offset, const void *data, unsigned in
 			      bool last)
 {
 	static struct flash_img_context ctx;
+#ifdef CONFIG_IMG_WRITE_BEHIND
+	static bool ctx_initialized;
+#endif
 
 	if (offset == 0) {
+#ifdef CONFIG_IMG_WRITE_BEHIND
+		/* Drop what is left of an upload that was restarted */
+		if (ctx_initialized) {
+			(void)stream_flash_write_behind_stop(&ctx.stream);
+		}
+#endif
 		if (flash_img_init_id(&ctx, g_img_mgmt_state.area_id) != 0) {
 			return IMG_MGMT_ERR_FLASH_OPEN_FAILED;
 		}
+#ifdef CONFIG_IMG_WRITE_BEHIND
+		ctx_initialized = true;
+#endif
 	}
 
 	if (flash_img_buffered_write(&ctx, data, num_bytes, last) != 0) {
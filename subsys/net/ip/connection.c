@@ -116,6 +116,112 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+#if defined(CONFIG_NET_CONN_HASH)
+/* Connected TCP/UDP handlers, keyed on the protocol, local port, remote
+ * port and remote address.
+ */
+static sys_slist_t conn_hash_connected[CONFIG_NET_CONN_HASH_SIZE];
+
+/* TCP/UDP handlers bound to a local port only, keyed on the protocol and
+ * the local port.
+ */
+static sys_slist_t conn_hash_bound[CONFIG_NET_CONN_HASH_SIZE];
+
+/* TCP/UDP handlers without a local port, matching any packet */
+static sys_slist_t conn_hash_wildcard;
+
+static inline uint32_t conn_hash_mix(uint32_t hash, uint32_t val)
+{
+	hash ^= val;
+	hash *= 0x9e3779b1U;
+
+	return hash ^ (hash >> 16);
+}
+
+static uint32_t conn_hash_addr(uint32_t hash, const uint8_t *addr, size_t len)
+{
+	uint32_t word;
+
+	for (size_t i = 0; i < len; i += sizeof(word)) {
+		memcpy(&word, &addr[i], sizeof(word));
+		hash = conn_hash_mix(hash, word);
+	}
+
+	return hash;
+}
+
+/* Pick the list a handler goes to. Only values that net_conn_input()
+ * checks against the packet are used, so that the handler is always
+ * found in the list the packet hashes to.
+ */
+static sys_slist_t *conn_hash_list(struct net_conn *conn)
+{
+	uint16_t local_port = net_sin(&conn->local_addr)->sin_port;
+	uint16_t remote_port = net_sin(&conn->remote_addr)->sin_port;
+	const uint8_t *addr;
+	uint32_t hash;
+	size_t len;
+
+	if (conn->family != AF_INET && conn->family != AF_INET6 &&
+	    conn->family != AF_UNSPEC) {
+		return NULL;
+	}
+
+	if (conn->proto != IPPROTO_UDP && conn->proto != IPPROTO_TCP) {
+		return NULL;
+	}
+
+	if (local_port == 0U) {
+		return &conn_hash_wildcard;
+	}
+
+	hash = conn_hash_mix(conn->proto, local_port);
+
+	if (remote_port == 0U || !(conn->flags & NET_CONN_REMOTE_ADDR_SET)) {
+		return &conn_hash_bound[hash % CONFIG_NET_CONN_HASH_SIZE];
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) &&
+	    conn->remote_addr.sa_family == AF_INET6 &&
+	    !net_ipv6_is_addr_unspecified(&net_sin6(&conn->remote_addr)->sin6_addr)) {
+		addr = net_sin6(&conn->remote_addr)->sin6_addr.s6_addr;
+		len = sizeof(struct in6_addr);
+	} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		   conn->remote_addr.sa_family == AF_INET &&
+		   net_sin(&conn->remote_addr)->sin_addr.s_addr) {
+		addr = net_sin(&conn->remote_addr)->sin_addr.s4_addr;
+		len = sizeof(struct in_addr);
+	} else {
+		return &conn_hash_bound[hash % CONFIG_NET_CONN_HASH_SIZE];
+	}
+
+	hash = conn_hash_addr(conn_hash_mix(hash, remote_port), addr, len);
+
+	return &conn_hash_connected[hash % CONFIG_NET_CONN_HASH_SIZE];
+}
+
+/* Must be called with conn_lock held */
+static void conn_hash_add(struct net_conn *conn)
+{
+	conn->hash_list = conn_hash_list(conn);
+	if (conn->hash_list) {
+		sys_slist_prepend(conn->hash_list, &conn->hash_node);
+	}
+}
+
+/* Must be called with conn_lock held */
+static void conn_hash_remove(struct net_conn *conn)
+{
+	if (conn->hash_list) {
+		sys_slist_find_and_remove(conn->hash_list, &conn->hash_node);
+		conn->hash_list = NULL;
+	}
+}
+#else
+#define conn_hash_add(...)
+#define conn_hash_remove(...)
+#endif /* CONFIG_NET_CONN_HASH */
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -141,6 +247,7 @@ static void conn_set_used(struct net_conn *conn)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+	conn_hash_add(conn);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -452,6 +559,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	conn_hash_remove(conn);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -478,7 +586,12 @@ int net_conn_update(struct net_conn_handle *handle,
 
 	net_conn_change_callback(conn, cb, user_data);
 
+	/* The remote end is part of the hash key */
+	k_mutex_lock(&conn_lock, K_FOREVER);
+	conn_hash_remove(conn);
 	ret = net_conn_change_remote(conn, remote_addr, remote_port);
+	conn_hash_add(conn);
+	k_mutex_unlock(&conn_lock);
 
 	return ret;
 }
@@ -634,6 +747,177 @@ static enum net_verdict conn_raw_socket(struct net_pkt *pkt,
 	return NET_OK;
 }
 
+/* State of the handler lookup for a received packet */
+struct conn_lookup {
+	struct net_conn *best_match;
+	int16_t best_rank;
+	bool is_mcast_pkt;
+	bool mcast_pkt_delivered;
+};
+
+/* Check a TCP/UDP connection handler against the packet. The best ranked
+ * match is recorded in the lookup, except for multicast packets which are
+ * delivered to every matching handler right away. Returns false if the
+ * packet has to be dropped.
+ */
+static bool conn_ip_input(struct net_conn *conn, struct net_pkt *pkt,
+			  union net_ip_header *ip_hdr, uint8_t proto,
+			  union net_proto_header *proto_hdr,
+			  uint16_t src_port, uint16_t dst_port,
+			  struct conn_lookup *lookup)
+{
+	struct net_if *pkt_iface = net_pkt_iface(pkt);
+	uint8_t pkt_family = net_pkt_family(pkt);
+
+	/* Is the candidate connection matching the packet's TCP/UDP
+	 * address and port?
+	 */
+	if (net_sin(&conn->remote_addr)->sin_port &&
+	    net_sin(&conn->remote_addr)->sin_port != src_port) {
+		return true; /* wrong remote port */
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port &&
+	    net_sin(&conn->local_addr)->sin_port != dst_port) {
+		return true; /* wrong local port */
+	}
+
+	if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+		return true; /* wrong remote address */
+	}
+
+	if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+
+		/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
+		 * has no IPV6_V6ONLY option set and if the local IPV6 address
+		 * is unspecified, then we could accept a connection from IPv4
+		 * address by mapping it to IPv6 address.
+		 */
+		if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+			if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
+			      !conn->v6only &&
+			      net_ipv6_is_addr_unspecified(
+				      &net_sin6(&conn->local_addr)->sin6_addr))) {
+				return true; /* wrong local address */
+			}
+		} else {
+			return true; /* wrong local address */
+		}
+
+		/* We might have a match for v4-to-v6 mapping,
+		 * continue with rank checking.
+		 */
+	}
+
+	if (lookup->best_rank < NET_CONN_RANK(conn->flags)) {
+		struct net_pkt *mcast_pkt;
+
+		if (!lookup->is_mcast_pkt) {
+			lookup->best_rank = NET_CONN_RANK(conn->flags);
+			lookup->best_match = conn;
+
+			return true; /* found a match - but maybe not yet the best */
+		}
+
+		/* If we have a multicast packet, and we found
+		 * a match, then deliver the packet immediately
+		 * to the handler. As there might be several
+		 * sockets interested about these, we need to
+		 * clone the received pkt.
+		 */
+
+		NET_DBG("[%p] mcast match found cb %p ud %p", conn, conn->cb,
+			conn->user_data);
+
+		mcast_pkt = net_pkt_clone(pkt, CLONE_TIMEOUT);
+		if (!mcast_pkt) {
+			return false;
+		}
+
+		if (conn->cb(conn, mcast_pkt, ip_hdr, proto_hdr, conn->user_data) ==
+		    NET_DROP) {
+			net_stats_update_per_proto_drop(pkt_iface, proto);
+			net_pkt_unref(mcast_pkt);
+		} else {
+			net_stats_update_per_proto_recv(pkt_iface, proto);
+		}
+
+		lookup->mcast_pkt_delivered = true;
+	}
+
+	return true;
+}
+
+#if defined(CONFIG_NET_CONN_HASH)
+/* Look the TCP/UDP packet up in the connection hash tables. Every handler
+ * that could match the packet is either on the connected or the bound
+ * list the packet hashes to, or on the wildcard list. A packet matches
+ * handlers from at most one bucket of each, and handlers of the same rank
+ * are always on the same list, so the result is the same as when going
+ * through all connections. Returns false if the packet has to be dropped.
+ */
+static bool conn_hash_input(struct net_pkt *pkt, union net_ip_header *ip_hdr,
+			    uint8_t proto, union net_proto_header *proto_hdr,
+			    uint16_t src_port, uint16_t dst_port,
+			    struct conn_lookup *lookup)
+{
+	uint8_t pkt_family = net_pkt_family(pkt);
+	sys_slist_t *lists[3];
+	struct net_conn *conn;
+	const uint8_t *addr;
+	uint32_t hash;
+	size_t len;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && pkt_family == AF_INET6) {
+		addr = ip_hdr->ipv6->src;
+		len = sizeof(struct in6_addr);
+	} else {
+		addr = ip_hdr->ipv4->src;
+		len = sizeof(struct in_addr);
+	}
+
+	hash = conn_hash_mix(proto, dst_port);
+	lists[1] = &conn_hash_bound[hash % CONFIG_NET_CONN_HASH_SIZE];
+
+	hash = conn_hash_addr(conn_hash_mix(hash, src_port), addr, len);
+	lists[0] = &conn_hash_connected[hash % CONFIG_NET_CONN_HASH_SIZE];
+
+	lists[2] = &conn_hash_wildcard;
+
+	ARRAY_FOR_EACH(lists, i) {
+		SYS_SLIST_FOR_EACH_CONTAINER(lists[i], conn, hash_node) {
+			if (conn->context != NULL &&
+			    net_context_is_bound_to_iface(conn->context) &&
+			    net_pkt_iface(pkt) != net_context_get_iface(conn->context)) {
+				continue; /* wrong interface */
+			}
+
+			if (conn->family != AF_UNSPEC &&
+			    conn->family != pkt_family) {
+				if (!IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6) ||
+				    !(conn->family == AF_INET6 && pkt_family == AF_INET &&
+				      !conn->v6only)) {
+					continue; /* wrong protocol family */
+				}
+			}
+
+			if (conn->proto != proto) {
+				continue; /* wrong protocol */
+			}
+
+			if (!conn_ip_input(conn, pkt, ip_hdr, proto, proto_hdr,
+					   src_port, dst_port, lookup)) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
 enum net_verdict net_conn_input(struct net_pkt *pkt,
 				union net_ip_header *ip_hdr,
 				uint8_t proto,
@@ -681,10 +965,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		ntohs(src_port), ntohs(dst_port), net_pkt_family(pkt));
 
 
-	struct net_conn *best_match = NULL;
-	int16_t best_rank = -1;
-	bool is_mcast_pkt = false;
-	bool mcast_pkt_delivered = false;
+	struct conn_lookup lookup = {
+		.best_rank = -1,
+	};
 	bool is_bcast_pkt = false;
 	bool raw_pkt_delivered = false;
 	bool raw_pkt_continue = false;
@@ -698,18 +981,32 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		 */
 		if (IS_ENABLED(CONFIG_NET_IPV4) && pkt_family == AF_INET) {
 			if (net_ipv4_is_addr_mcast((struct in_addr *)ip_hdr->ipv4->dst)) {
-				is_mcast_pkt = true;
+				lookup.is_mcast_pkt = true;
 			} else if (net_if_ipv4_is_addr_bcast(pkt_iface,
 							     (struct in_addr *)ip_hdr->ipv4->dst)) {
 				is_bcast_pkt = true;
 			}
 		} else if (IS_ENABLED(CONFIG_NET_IPV6) && pkt_family == AF_INET6) {
-			is_mcast_pkt = net_ipv6_is_addr_mcast((struct in6_addr *)ip_hdr->ipv6->dst);
+			lookup.is_mcast_pkt =
+				net_ipv6_is_addr_mcast((struct in6_addr *)ip_hdr->ipv6->dst);
 		}
 	}
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	if ((pkt_family == AF_INET || pkt_family == AF_INET6) &&
+	    (proto == IPPROTO_UDP || proto == IPPROTO_TCP)) {
+		if (!conn_hash_input(pkt, ip_hdr, proto, proto_hdr,
+				     src_port, dst_port, &lookup)) {
+			k_mutex_unlock(&conn_lock);
+			goto drop;
+		}
+
+		goto done;
+	}
+#endif /* CONFIG_NET_CONN_HASH */
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
 		/* Is the candidate connection matching the packet's interface? */
 		if (conn->context != NULL &&
@@ -795,92 +1092,22 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		} else if ((IS_ENABLED(CONFIG_NET_UDP) || IS_ENABLED(CONFIG_NET_TCP)) &&
 			   (conn_family == AF_INET || conn_family == AF_INET6 ||
 			    conn_family == AF_UNSPEC)) {
-			/* Is the candidate connection matching the packet's TCP/UDP
-			 * address and port?
-			 */
-			if (net_sin(&conn->remote_addr)->sin_port &&
-			    net_sin(&conn->remote_addr)->sin_port != src_port) {
-				continue; /* wrong remote port */
-			}
-
-			if (net_sin(&conn->local_addr)->sin_port &&
-			    net_sin(&conn->local_addr)->sin_port != dst_port) {
-				continue; /* wrong local port */
-			}
-
-			if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
-				continue; /* wrong remote address */
-			}
-
-			if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
-
-				/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
-				 * has no IPV6_V6ONLY option set and if the local IPV6 address
-				 * is unspecified, then we could accept a connection from IPv4
-				 * address by mapping it to IPv6 address.
-				 */
-				if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-					if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
-					      !conn->v6only &&
-					      net_ipv6_is_addr_unspecified(
-						      &net_sin6(&conn->local_addr)->sin6_addr))) {
-						continue; /* wrong local address */
-					}
-				} else {
-					continue; /* wrong local address */
-				}
-
-				/* We might have a match for v4-to-v6 mapping,
-				 * continue with rank checking.
-				 */
-			}
-
-			if (best_rank < NET_CONN_RANK(conn->flags)) {
-				struct net_pkt *mcast_pkt;
-
-				if (!is_mcast_pkt) {
-					best_rank = NET_CONN_RANK(conn->flags);
-					best_match = conn;
-
-					continue; /* found a match - but maybe not yet the best */
-				}
-
-				/* If we have a multicast packet, and we found
-				 * a match, then deliver the packet immediately
-				 * to the handler. As there might be several
-				 * sockets interested about these, we need to
-				 * clone the received pkt.
-				 */
-
-				NET_DBG("[%p] mcast match found cb %p ud %p", conn, conn->cb,
-					conn->user_data);
-
-				mcast_pkt = net_pkt_clone(pkt, CLONE_TIMEOUT);
-				if (!mcast_pkt) {
-					k_mutex_unlock(&conn_lock);
-					goto drop;
-				}
-
-				if (conn->cb(conn, mcast_pkt, ip_hdr, proto_hdr, conn->user_data) ==
-				    NET_DROP) {
-					net_stats_update_per_proto_drop(pkt_iface, proto);
-					net_pkt_unref(mcast_pkt);
-				} else {
-					net_stats_update_per_proto_recv(pkt_iface, proto);
-				}
-
-				mcast_pkt_delivered = true;
+			if (!conn_ip_input(conn, pkt, ip_hdr, proto, proto_hdr,
+					   src_port, dst_port, &lookup)) {
+				k_mutex_unlock(&conn_lock);
+				goto drop;
 			}
 		} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) && conn_family == AF_CAN) {
-			best_match = conn;
+			lookup.best_match = conn;
 		}
 	} /* loop end */
 
-	if (best_match) {
-		cb = best_match->cb;
-		user_data = best_match->user_data;
+#if defined(CONFIG_NET_CONN_HASH)
+done:
+#endif
+	if (lookup.best_match) {
+		cb = lookup.best_match->cb;
+		user_data = lookup.best_match->user_data;
 	}
 
 	k_mutex_unlock(&conn_lock);
@@ -903,7 +1130,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
-	if (IS_ENABLED(CONFIG_NET_IP) && is_mcast_pkt && mcast_pkt_delivered) {
+	if (IS_ENABLED(CONFIG_NET_IP) && lookup.is_mcast_pkt && lookup.mcast_pkt_delivered) {
 		/* As one or more multicast packets
 		 * have already been delivered in the loop above,
 		 * we shall not call the callback again here.
@@ -913,10 +1140,10 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	}
 
 	if (cb) {
-		NET_DBG("[%p] match found cb %p ud %p rank 0x%02x", best_match, cb,
-			user_data, NET_CONN_RANK(best_match->flags));
+		NET_DBG("[%p] match found cb %p ud %p rank 0x%02x", lookup.best_match, cb,
+			user_data, NET_CONN_RANK(lookup.best_match->flags));
 
-		if (cb(best_match, pkt, ip_hdr, proto_hdr, user_data)
+		if (cb(lookup.best_match, pkt, ip_hdr, proto_hdr, user_data)
 				== NET_DROP) {
 			goto drop;
 		}
@@ -929,7 +1156,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	NET_DBG("No match found.");
 
 	if (IS_ENABLED(CONFIG_NET_IP) && (pkt_family == AF_INET || pkt_family == AF_INET6) &&
-	    !(is_mcast_pkt || is_bcast_pkt)) {
+	    !(lookup.is_mcast_pkt || is_bcast_pkt)) {
 		if (IS_ENABLED(CONFIG_NET_TCP) && proto == IPPROTO_TCP &&
 		    IS_ENABLED(CONFIG_NET_TCP_REJECT_CONN_WITH_RST)) {
 			net_tcp_reply_rst(pkt);
@@ -965,6 +1192,15 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	for (i = 0; i < CONFIG_NET_CONN_HASH_SIZE; i++) {
+		sys_slist_init(&conn_hash_connected[i]);
+		sys_slist_init(&conn_hash_bound[i]);
+	}
+
+	sys_slist_init(&conn_hash_wildcard);
+#endif
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
@@ -35,6 +35,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include "net_private.h"
 #include "ipv4.h"
 #include "ipv6.h"
+#include "tcp_internal.h"
 
 #include "net_stats.h"
 
@@ -449,6 +450,51 @@ static inline void init_iface(struct net_if *iface)
 }
 
 #if defined(CONFIG_NET_NATIVE)
+#if defined(CONFIG_NET_TCP_GSO)
+static bool net_if_tso_supported(struct net_if *iface)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (IS_ENABLED(CONFIG_NET_VLAN) && net_eth_is_vlan_interface(iface)) {
+		iface = net_eth_get_vlan_main(iface);
+	}
+
+	return iface != NULL && net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET) &&
+	       (net_eth_get_hw_capabilities(iface) & ETHERNET_HW_TX_TSO);
+#else
+	ARG_UNUSED(iface);
+
+	return false;
+#endif
+}
+
+/* Send the segments of a TCP packet the interface cannot segment itself */
+static enum net_verdict net_if_send_gso_segments(struct net_if *iface,
+						 struct net_pkt *pkt)
+{
+	sys_slist_t segs;
+	sys_snode_t *node;
+	int ret;
+
+	ret = net_tcp_gso_segment(pkt, &segs);
+	if (ret < 0) {
+		NET_DBG("Cannot segment pkt %p (%d)", pkt, ret);
+		return NET_DROP;
+	}
+
+	while ((node = sys_slist_get(&segs)) != NULL) {
+		struct net_pkt *seg = CONTAINER_OF(node, struct net_pkt, next);
+
+		if (net_if_send_data(iface, seg) == NET_DROP) {
+			net_pkt_unref(seg);
+		}
+	}
+
+	net_pkt_unref(pkt);
+
+	return NET_OK;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 enum net_verdict net_if_send_data(struct net_if *iface, struct net_pkt *pkt)
 {
 	const struct net_l2 *l2;
@@ -486,6 +532,19 @@ enum net_verdict net_if_send_data(struct net_if *iface, struct net_pkt *pkt)
 		}
 	}
 
+#if defined(CONFIG_NET_TCP_GSO)
+	if (net_pkt_gso_size(pkt) > 0 && !net_if_tso_supported(iface)) {
+		verdict = net_if_send_gso_segments(iface, pkt);
+		if (verdict == NET_OK) {
+			/* Consumed, the segments went through here instead */
+			return verdict;
+		}
+
+		status = -ENOBUFS;
+		goto done;
+	}
+#endif
+
 	/* If the ll address is not set at all, then we must set
 	 * it here.
 	 * Workaround Linux bug, see:
@@ -73,6 +73,12 @@ static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
 static K_MUTEX_DEFINE(tcp_lock);
 
+#if defined(CONFIG_NET_TCP_GRO)
+/* Connections holding received segments for coalescing */
+static sys_slist_t tcp_gro_conns = SYS_SLIST_STATIC_INIT(&tcp_gro_conns);
+static struct k_spinlock tcp_gro_lock;
+#endif
+
 K_MEM_SLAB_DEFINE_STATIC(tcp_conns_slab, sizeof(struct tcp),
 				CONFIG_NET_MAX_CONTEXTS, 4);
 
@@ -443,20 +449,39 @@ static void tcp_derive_rto(struct tcp *conn)
 
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
+/* Growing the window past what the send window can hold is pointless */
+static uint32_t tcp_ca_cwnd_max(struct tcp *conn)
+{
+	return MAX(conn->send_win_max, UINT16_MAX);
+}
+
+static void tcp_ca_initial_window(struct tcp *conn)
+{
+	uint32_t mss = conn_mss(conn);
+
+#ifdef CONFIG_NET_TCP_CONGESTION_LARGE_IW
+	/* RFC 6928 ch 2, and RFC 5681 ch 3.1 for the slow start threshold */
+	conn->ca.cwnd = MIN(10 * mss, MAX(2 * mss, 14600));
+	conn->ca.ssthresh = tcp_ca_cwnd_max(conn);
+#else
+	conn->ca.cwnd = mss * TCP_CONGESTION_INITIAL_WIN;
+	conn->ca.ssthresh = mss * TCP_CONGESTION_INITIAL_SSTHRESH;
+#endif
+	conn->ca.pending_fast_retransmit_bytes = 0;
+}
+
 /* Implementation according to RFC6582 */
 
 static void tcp_new_reno_log(struct tcp *conn, char *step)
 {
-	NET_DBG("conn: %p, ca %s, cwnd=%d, ssthres=%d, fast_pend=%i",
+	NET_DBG("conn: %p, ca %s, cwnd=%u, ssthres=%u, fast_pend=%u",
 		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
 		conn->ca.pending_fast_retransmit_bytes);
 }
 
 static void tcp_new_reno_init(struct tcp *conn)
 {
-	conn->ca.cwnd = conn_mss(conn) * TCP_CONGESTION_INITIAL_WIN;
-	conn->ca.ssthresh = conn_mss(conn) * TCP_CONGESTION_INITIAL_SSTHRESH;
-	conn->ca.pending_fast_retransmit_bytes = 0;
+	tcp_ca_initial_window(conn);
 	tcp_new_reno_log(conn, "init");
 }
 
@@ -481,17 +506,17 @@ static void tcp_new_reno_timeout(struct tcp *conn)
 /* For every duplicate ack increment the cwnd by mss */
 static void tcp_new_reno_dup_ack(struct tcp *conn)
 {
-	int32_t new_win = conn->ca.cwnd;
+	uint32_t new_win = conn->ca.cwnd;
 
 	new_win += conn_mss(conn);
-	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+	conn->ca.cwnd = MIN(new_win, tcp_ca_cwnd_max(conn));
 	tcp_new_reno_log(conn, "dup_ack");
 }
 
 static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	int32_t new_win = conn->ca.cwnd;
-	int32_t win_inc = MIN(acked_len, conn_mss(conn));
+	uint32_t new_win = conn->ca.cwnd;
+	uint32_t win_inc = MIN(acked_len, conn_mss(conn));
 
 	if (conn->ca.pending_fast_retransmit_bytes == 0) {
 		if (conn->ca.cwnd < conn->ca.ssthresh) {
@@ -500,7 +525,7 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 			/* Implement a div_ceil	to avoid rounding to 0 */
 			new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
 		}
-		conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+		conn->ca.cwnd = MIN(new_win, tcp_ca_cwnd_max(conn));
 	} else {
 		/* Check if it is still in fast recovery mode */
 		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
@@ -508,35 +533,207 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 			conn->ca.cwnd = conn->ca.ssthresh;
 		} else {
 			conn->ca.pending_fast_retransmit_bytes -= acked_len;
-			conn->ca.cwnd -= acked_len;
+			/* Deflate the window, without wrapping around */
+			conn->ca.cwnd = MAX(conn->ca.cwnd - MIN(acked_len, conn->ca.cwnd),
+					    conn_mss(conn));
 		}
 	}
 	tcp_new_reno_log(conn, "pkts_acked");
 }
 
+static const struct tcp_ca_ops tcp_ca_new_reno = {
+	.name = "reno",
+	.init = tcp_new_reno_init,
+	.fast_retransmit = tcp_new_reno_fast_retransmit,
+	.timeout = tcp_new_reno_timeout,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.pkts_acked = tcp_new_reno_pkts_acked,
+};
+
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+
+/* Implementation according to RFC9438, with C = 0.4 and beta = 0.7.
+ * Windows are in bytes, the cubic function works in conn_mss() sized
+ * segments and in milliseconds. Slow start and fast recovery are shared
+ * with New Reno. As the RTT is not sampled, the window is aimed at the
+ * cubic function value for the current time rather than one RTT later.
+ */
+#define CUBIC_BETA_NUM 7
+#define CUBIC_BETA_DEN 10
+/* Time is clamped so that its cube fits comfortably in 64 bits */
+#define CUBIC_MAX_T_MS 100000
+
+static uint32_t tcp_cubic_cbrt(uint64_t x)
+{
+	uint32_t root = 0;
+
+	for (int bit = 21; bit >= 0; bit--) {
+		uint64_t next = root | BIT(bit);
+
+		/* next^3 <= x, without overflowing */
+		if (next <= x / (next * next)) {
+			root = next;
+		}
+	}
+
+	return root;
+}
+
+static void tcp_cubic_log(struct tcp *conn, char *step)
+{
+	NET_DBG("conn: %p, ca %s, cwnd=%u, ssthres=%u, w_max=%u, K=%u",
+		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
+		conn->ca.cubic.w_max, conn->ca.cubic.k);
+}
+
+static void tcp_cubic_init(struct tcp *conn)
+{
+	tcp_ca_initial_window(conn);
+	memset(&conn->ca.cubic, 0, sizeof(conn->ca.cubic));
+	tcp_cubic_log(conn, "init");
+}
+
+/* Congestion event, remember where it happened and lower the threshold */
+static void tcp_cubic_reduce(struct tcp *conn)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint32_t cwnd = conn->ca.cwnd;
+
+	/* Fast convergence, the window shrank since the previous event so
+	 * leave some room to competing flows. w_max still holds the window
+	 * of that event here, no separate copy of it is needed.
+	 */
+	if (cwnd < cubic->w_max) {
+		cubic->w_max = (uint64_t)cwnd * (CUBIC_BETA_DEN + CUBIC_BETA_NUM) /
+			       (2 * CUBIC_BETA_DEN);
+	} else {
+		cubic->w_max = cwnd;
+	}
+
+	cubic->epoch_start = 0;
+	conn->ca.ssthresh = MAX(conn_mss(conn) * 2,
+				(uint64_t)conn->unacked_len * CUBIC_BETA_NUM /
+				CUBIC_BETA_DEN);
+}
+
+static void tcp_cubic_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		tcp_cubic_reduce(conn);
+		/* Account for the lost segments */
+		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		tcp_cubic_log(conn, "fast_retransmit");
+	}
+}
+
+static void tcp_cubic_timeout(struct tcp *conn)
+{
+	tcp_cubic_reduce(conn);
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_cubic_log(conn, "timeout");
+}
+
+static void tcp_cubic_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t mss = conn_mss(conn);
+	uint32_t now = k_uptime_get_32();
+	uint64_t new_win;
+	int64_t target;
+	int64_t t;
+
+	if (conn->ca.pending_fast_retransmit_bytes != 0 ||
+	    cwnd < conn->ca.ssthresh) {
+		tcp_new_reno_pkts_acked(conn, acked_len);
+		return;
+	}
+
+	if (cubic->epoch_start == 0) {
+		/* 0 means no epoch, so skip it on uptime wrap */
+		cubic->epoch_start = (now == 0) ? 1 : now;
+		cubic->w_est = cwnd;
+
+		if (cwnd < cubic->w_max) {
+			/* K = cbrt((w_max - cwnd) / C), in ms */
+			cubic->k = tcp_cubic_cbrt((uint64_t)(cubic->w_max - cwnd) *
+						  2500000000ULL / mss);
+			cubic->origin = cubic->w_max;
+		} else {
+			cubic->k = 0;
+			cubic->origin = cwnd;
+		}
+	}
+
+	t = (int64_t)MIN(now - cubic->epoch_start, CUBIC_MAX_T_MS) - cubic->k;
+	t = CLAMP(t, -CUBIC_MAX_T_MS, CUBIC_MAX_T_MS);
+
+	/* W_cubic(t) = C * (t - K)^3 + origin */
+	target = (int64_t)cubic->origin + t * t * t / 1000 * 4 * mss / 10000000;
+
+	/* Reno friendly estimate, alpha = 3 * (1 - beta) / (1 + beta) */
+	cubic->w_est += (uint64_t)mss * acked_len *
+			(3 * (CUBIC_BETA_DEN - CUBIC_BETA_NUM)) /
+			((uint64_t)(CUBIC_BETA_DEN + CUBIC_BETA_NUM) * cwnd);
+
+	if (target < cubic->w_est) {
+		new_win = MAX(cubic->w_est, cwnd);
+	} else {
+		target = CLAMP(target, cwnd, cwnd + cwnd / 2);
+		new_win = cwnd + (uint64_t)(target - cwnd) * acked_len / cwnd;
+	}
+
+	conn->ca.cwnd = MIN(new_win, tcp_ca_cwnd_max(conn));
+	tcp_cubic_log(conn, "pkts_acked");
+}
+
+static const struct tcp_ca_ops tcp_ca_cubic = {
+	.name = "cubic",
+	.init = tcp_cubic_init,
+	.fast_retransmit = tcp_cubic_fast_retransmit,
+	.timeout = tcp_cubic_timeout,
+	.dup_ack = tcp_new_reno_dup_ack,
+	.pkts_acked = tcp_cubic_pkts_acked,
+};
+#endif /* CONFIG_NET_TCP_CONGESTION_CUBIC */
+
+static const struct tcp_ca_ops *const tcp_ca_algorithms[] = {
+	&tcp_ca_new_reno,
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+	&tcp_ca_cubic,
+#endif
+};
+
+#ifdef CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC
+#define TCP_CA_DEFAULT (&tcp_ca_cubic)
+#else
+#define TCP_CA_DEFAULT (&tcp_ca_new_reno)
+#endif
+
 static void tcp_ca_init(struct tcp *conn)
 {
-	tcp_new_reno_init(conn);
+	conn->ca.ops->init(conn);
 }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	conn->ca.ops->fast_retransmit(conn);
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	conn->ca.ops->timeout(conn);
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	conn->ca.ops->dup_ack(conn);
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	conn->ca.ops->pkts_acked(conn, acked_len);
 }
 #else
 
@@ -1087,7 +1284,7 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 }
 
 static bool tcp_options_check(struct tcp_options *recv_options,
-			      struct net_pkt *pkt, ssize_t len)
+			      struct net_pkt *pkt, ssize_t len, bool syn)
 {
 	uint8_t options_buf[40]; /* TCP header max options size is 40 */
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
@@ -1097,8 +1294,20 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	/* MSS and window scale are only meaningful in a SYN, keep the
+	 * negotiated values when later segments carry other options.
+	 */
+	if (syn) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+#if defined(CONFIG_NET_TCP_SACK)
+		recv_options->sack_permitted = false;
+#endif
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	recv_options->sack_cnt = 0;
+#endif
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -1133,6 +1342,10 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
+			if (!syn) {
+				break;
+			}
+
 			recv_options->mss =
 				ntohs(UNALIGNED_GET((uint16_t *)(options + 2)));
 			recv_options->mss_found = true;
@@ -1144,9 +1357,46 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			if (!syn) {
+				break;
+			}
+
+			/* RFC 7323 ch 2.3, larger shifts are used as 14 */
+			recv_options->window = MIN(options[2],
+						   NET_TCP_MAX_WINDOW_SCALE);
 			recv_options->wnd_found = true;
+			NET_DBG("WSCALE=%hu", recv_options->window);
+			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_permitted = syn;
 			break;
+		case NET_TCP_SACK_OPT:
+			/* The options are at most 40 bytes, which is enough
+			 * for NET_TCP_MAX_SACK_BLOCKS blocks at most.
+			 */
+			if (opt_len < 2 + NET_TCP_SACK_BLOCK_SIZE ||
+			    ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) != 0) {
+				result = false;
+				goto end;
+			}
+
+			for (uint8_t *block = options + 2; block < options + opt_len;
+			     block += NET_TCP_SACK_BLOCK_SIZE) {
+				struct tcp_sack_block *sack =
+					&recv_options->sack[recv_options->sack_cnt++];
+
+				sack->left = ntohl(UNALIGNED_GET((uint32_t *)block));
+				sack->right = ntohl(UNALIGNED_GET((uint32_t *)(block + 4)));
+				NET_DBG("SACK %u-%u", sack->left, sack->right);
+			}
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -1337,6 +1587,124 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+/* Smallest shift that lets the maximum receive window be advertised */
+static uint8_t tcp_wscale_offer(struct tcp *conn)
+{
+	uint8_t shift = 0;
+
+	while (shift < NET_TCP_MAX_WINDOW_SCALE &&
+	       (conn->recv_win_max >> shift) > UINT16_MAX) {
+		shift++;
+	}
+
+	return shift;
+}
+#endif
+
+/* Stop sending the SYN only options once the SYN has been queued */
+static void tcp_syn_options_clear(struct tcp *conn)
+{
+	conn->send_options.mss_found = false;
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	conn->send_options.wnd_found = false;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->send_options.sack_permitted = false;
+#endif
+}
+
+/* Settle the options negotiated by the SYN exchange, recv_options holds
+ * the options of the SYN received from the peer.
+ */
+static void tcp_syn_options_negotiate(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	if (conn->recv_options.wnd_found) {
+		conn->send_wscale = conn->recv_options.window;
+		conn->recv_wscale = tcp_wscale_offer(conn);
+	} else {
+		conn->send_wscale = 0;
+		conn->recv_wscale = 0;
+	}
+
+	NET_DBG("conn: %p wscale send %u recv %u", conn, conn->send_wscale,
+		conn->recv_wscale);
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	conn->sack_ok = conn->recv_options.sack_permitted;
+	NET_DBG("conn: %p SACK %s", conn, conn->sack_ok ? "on" : "off");
+#else
+	ARG_UNUSED(conn);
+#endif
+}
+
+/* Window field to send, the window in a SYN is never scaled
+ * (RFC 7323 ch 2.2).
+ */
+static uint16_t tcp_adv_win(struct tcp *conn, uint8_t flags)
+{
+	uint32_t win = conn->recv_win;
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	if (!(flags & SYN)) {
+		win >>= conn->recv_wscale;
+	}
+#else
+	ARG_UNUSED(flags);
+#endif
+
+	return MIN(win, UINT16_MAX);
+}
+
+/* Whether a SACK block describing the out-of-order receive queue should be
+ * added to the segment. The queue holds a single contiguous range of data,
+ * so one block is all there is to report.
+ */
+static bool tcp_sack_pending(struct tcp *conn, uint8_t flags)
+{
+#if defined(CONFIG_NET_TCP_SACK)
+	return CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT && conn->sack_ok &&
+		(flags & (ACK | SYN)) == ACK &&
+		conn->queue_recv_data != NULL &&
+		!net_pkt_is_empty(conn->queue_recv_data) &&
+		net_tcp_seq_greater(tcp_get_seq(conn->queue_recv_data->buffer),
+				    conn->ack);
+#else
+	ARG_UNUSED(conn);
+	ARG_UNUSED(flags);
+
+	return false;
+#endif
+}
+
+/* Length of the options added by tcp_options_add(), a multiple of 4 */
+static size_t tcp_options_len(struct tcp *conn, uint8_t flags)
+{
+	size_t len = 0;
+
+	if (conn->send_options.mss_found) {
+		len += NET_TCP_MSS_SIZE;
+	}
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	if (conn->send_options.wnd_found) {
+		len += NET_TCP_NOP_SIZE + NET_TCP_WINDOW_SCALE_SIZE;
+	}
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	if (conn->send_options.sack_permitted) {
+		len += 2 * NET_TCP_NOP_SIZE + NET_TCP_SACK_PERM_SIZE;
+	}
+#endif
+
+	if (tcp_sack_pending(conn, flags)) {
+		len += 2 * NET_TCP_NOP_SIZE + 2 + NET_TCP_SACK_BLOCK_SIZE;
+	}
+
+	return len;
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 			  uint32_t seq)
 {
@@ -1352,14 +1720,10 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
-
-	if (conn->send_options.mss_found) {
-		th->th_off++;
-	}
+	th->th_off = 5 + tcp_options_len(conn, flags) / 4;
 
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
+	UNALIGNED_PUT(htons(tcp_adv_win(conn, flags)), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
 
 	if (ACK & flags) {
@@ -1417,6 +1781,57 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, size_t *len)
 	return 0;
 }
 
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	char name[TCP_CA_NAME_MAX];
+
+	if (len == 0) {
+		return -EINVAL;
+	}
+
+	/* The name does not need to be terminated within len */
+	len = MIN(len, sizeof(name) - 1);
+	memcpy(name, value, len);
+	name[len] = '\0';
+
+	ARRAY_FOR_EACH(tcp_ca_algorithms, i) {
+		if (strcmp(name, tcp_ca_algorithms[i]->name) != 0) {
+			continue;
+		}
+
+		if (conn->ca.ops != tcp_ca_algorithms[i]) {
+			/* The window is kept, only the algorithm state
+			 * starts over.
+			 */
+			conn->ca.ops = tcp_ca_algorithms[i];
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+			memset(&conn->ca.cubic, 0, sizeof(conn->ca.cubic));
+#endif
+		}
+
+		return 0;
+	}
+
+	return -ENOENT;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	size_t name_len = strlen(conn->ca.ops->name) + 1;
+
+	if (len == NULL || *len == 0) {
+		return -EINVAL;
+	}
+
+	name_len = MIN(name_len, *len);
+	memcpy(value, conn->ca.ops->name, name_len);
+	*len = name_len;
+
+	return 0;
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_AVOIDANCE */
+
 static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
@@ -1436,6 +1851,70 @@ static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
 	return net_pkt_set_data(pkt, &mss_opt_access);
 }
 
+static int tcp_options_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags)
+{
+	int ret = 0;
+
+	if (conn->send_options.mss_found) {
+		ret = net_tcp_set_mss_opt(conn, pkt);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	if (conn->send_options.wnd_found) {
+		uint8_t wscale_opt[] = {
+			NET_TCP_NOP_OPT, NET_TCP_WINDOW_SCALE_OPT,
+			NET_TCP_WINDOW_SCALE_SIZE, tcp_wscale_offer(conn),
+		};
+
+		ret = net_pkt_write(pkt, wscale_opt, sizeof(wscale_opt));
+		if (ret < 0) {
+			return ret;
+		}
+	}
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	if (conn->send_options.sack_permitted) {
+		uint8_t sack_perm_opt[] = {
+			NET_TCP_NOP_OPT, NET_TCP_NOP_OPT,
+			NET_TCP_SACK_PERM_OPT, NET_TCP_SACK_PERM_SIZE,
+		};
+
+		ret = net_pkt_write(pkt, sack_perm_opt, sizeof(sack_perm_opt));
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	if (tcp_sack_pending(conn, flags)) {
+		uint8_t sack_opt[] = {
+			NET_TCP_NOP_OPT, NET_TCP_NOP_OPT,
+			NET_TCP_SACK_OPT, 2 + NET_TCP_SACK_BLOCK_SIZE,
+		};
+		uint32_t left = tcp_get_seq(conn->queue_recv_data->buffer);
+
+		ret = net_pkt_write(pkt, sack_opt, sizeof(sack_opt));
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = net_pkt_write_be32(pkt, left);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = net_pkt_write_be32(pkt, left +
+					 net_pkt_get_len(conn->queue_recv_data));
+	}
+#else
+	ARG_UNUSED(flags);
+#endif
+
+	return ret;
+}
+
 static bool is_destination_local(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
@@ -1540,14 +2019,10 @@ err:
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	size_t alloc_len = sizeof(struct tcphdr) + tcp_options_len(conn, flags);
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
-
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1555,6 +2030,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 	}
 
 	if (data) {
+#if defined(CONFIG_NET_TCP_GSO)
+		size_t gso_size = tcp_gso_size(conn);
+
+		/* Split into segments by the interface or its driver */
+		if (net_pkt_get_len(data) > gso_size) {
+			net_pkt_set_gso_size(pkt, gso_size);
+		}
+#endif
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
@@ -1572,12 +2055,10 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	if (conn->send_options.mss_found) {
-		ret = net_tcp_set_mss_opt(conn, pkt);
-		if (ret < 0) {
-			tcp_pkt_unref(pkt);
-			goto out;
-		}
+	ret = tcp_options_add(conn, pkt, flags);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		goto out;
 	}
 
 	ret = tcp_finalize_pkt(pkt);
@@ -1640,157 +2121,558 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 	net_pkt_cursor_init(to);
 	net_pkt_cursor_init(from);
 
-	if (pos) {
-		net_pkt_set_overwrite(from, true);
-		net_pkt_skip(from, pos);
+	if (pos) {
+		net_pkt_set_overwrite(from, true);
+		net_pkt_skip(from, pos);
+	}
+
+	return net_pkt_copy(to, from, len);
+}
+
+static int tcp_pkt_append(struct net_pkt *pkt, const uint8_t *data, size_t len)
+{
+	size_t alloc_len = len;
+	struct net_buf *buf = NULL;
+	int ret = 0;
+
+	if (pkt->buffer) {
+		buf = net_buf_frag_last(pkt->buffer);
+
+		if (len > net_buf_tailroom(buf)) {
+			alloc_len -= net_buf_tailroom(buf);
+		} else {
+			alloc_len = 0;
+		}
+	}
+
+	if (alloc_len > 0) {
+		ret = net_pkt_alloc_buffer_raw(pkt, alloc_len,
+					       TCP_PKT_ALLOC_TIMEOUT);
+		if (ret < 0) {
+			return -ENOBUFS;
+		}
+	}
+
+	if (buf == NULL) {
+		buf = pkt->buffer;
+	}
+
+	while (buf != NULL && len > 0) {
+		size_t write_len = MIN(len, net_buf_tailroom(buf));
+
+		net_buf_add_mem(buf, data, write_len);
+
+		data += write_len;
+		len -= write_len;
+		buf = buf->frags;
+	}
+
+	NET_ASSERT(len == 0, "Not all bytes written");
+
+	return ret;
+}
+
+static bool tcp_window_full(struct tcp *conn)
+{
+	bool window_full = (conn->send_data_total >= conn->send_win);
+
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	window_full = window_full || (conn->send_data_total >= conn->ca.cwnd);
+#endif
+
+	if (window_full) {
+		NET_DBG("conn: %p TX window_full", conn);
+	}
+
+	return window_full;
+}
+
+static int tcp_unsent_len(struct tcp *conn)
+{
+	int unsent_len;
+
+	if (conn->unacked_len > conn->send_data_total) {
+		NET_ERR("total=%zu, unacked_len=%d",
+			conn->send_data_total, conn->unacked_len);
+		unsent_len = -ERANGE;
+		goto out;
+	}
+
+	unsent_len = conn->send_data_total - conn->unacked_len;
+	if (conn->unacked_len >= conn->send_win) {
+		unsent_len = 0;
+	} else {
+		unsent_len = MIN(unsent_len, conn->send_win - conn->unacked_len);
+
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+		if (conn->unacked_len >= conn->ca.cwnd) {
+			unsent_len = 0;
+		} else {
+			unsent_len = MIN(unsent_len, conn->ca.cwnd - conn->unacked_len);
+		}
+#endif
+	}
+ out:
+	return unsent_len;
+}
+
+#if defined(CONFIG_NET_TCP_GSO)
+/* Payload of the segments a GSO packet is split into */
+static size_t tcp_gso_size(struct tcp *conn)
+{
+	return conn_mss(conn) - tcp_options_len(conn, PSH | ACK);
+}
+
+/* Data a GSO packet carries: up to NET_TCP_GSO_MAX_SEGS segments, as long
+ * as the packet length fits in the 16-bit length field of the IP header,
+ * which covers the IPv4 header but not the IPv6 one.
+ */
+static size_t tcp_gso_max_len(struct tcp *conn)
+{
+	size_t hdr_len = NET_TCPH_LEN + tcp_options_len(conn, PSH | ACK);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) &&
+	    net_context_get_family(conn->context) == AF_INET) {
+		hdr_len += NET_IPV4H_LEN;
+	}
+
+	return MIN(tcp_gso_size(conn) * CONFIG_NET_TCP_GSO_MAX_SEGS,
+		   UINT16_MAX - hdr_len);
+}
+
+/* Buffers of a GSO packet are not limited to the MTU, unlike the ones
+ * tcp_pkt_alloc() gets.
+ */
+static struct net_pkt *tcp_data_pkt_alloc(struct tcp *conn, size_t len)
+{
+	struct net_pkt *pkt;
+
+	if (len <= conn_mss(conn)) {
+		return tcp_pkt_alloc(conn, len);
+	}
+
+	pkt = tcp_pkt_alloc(conn, 0);
+	if (pkt == NULL) {
+		return NULL;
+	}
+
+	if (net_pkt_alloc_buffer_raw(pkt, len, TCP_PKT_ALLOC_TIMEOUT) < 0) {
+		tcp_pkt_unref(pkt);
+		return NULL;
+	}
+
+	return pkt;
+}
+#else
+#define tcp_data_pkt_alloc(_conn, _len) tcp_pkt_alloc(_conn, _len)
+#endif
+
+/* Send len bytes of the send_data queue, starting at offset */
+static int tcp_send_segment(struct tcp *conn, int offset, int len)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = tcp_data_pkt_alloc(conn, len);
+	if (!pkt) {
+		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
+		return -ENOBUFS;
+	}
+
+	ret = tcp_pkt_peek(pkt, conn->send_data, offset, len);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		return -ENOBUFS;
+	}
+
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + offset);
+
+	/* The data we want to send, has been moved to the send queue so we
+	 * can unref the head net_pkt. If there was an error, we need to remove
+	 * the packet anyway.
+	 */
+	tcp_pkt_unref(pkt);
+
+	return ret;
+}
+
+static int tcp_send_data(struct tcp *conn)
+{
+	int ret = 0;
+	int len;
+
+#if defined(CONFIG_NET_TCP_GSO)
+	len = MIN(tcp_unsent_len(conn), (int)tcp_gso_max_len(conn));
+#else
+	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
+#endif
+	if (len < 0) {
+		ret = len;
+		goto out;
+	}
+	if (len == 0) {
+		NET_DBG("conn: %p no data to send", conn);
+		ret = -ENODATA;
+		goto out;
+	}
+
+	ret = tcp_send_segment(conn, conn->unacked_len, len);
+	if (ret == 0) {
+		conn->unacked_len += len;
+
+		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+			net_stats_update_tcp_resent(conn->iface, len);
+			net_stats_update_tcp_seg_rexmit(conn->iface);
+		} else {
+			net_stats_update_tcp_sent(conn->iface, len);
+			net_stats_update_tcp_seg_sent(conn->iface);
+		}
+	}
+
+	conn_send_data_dump(conn);
+
+ out:
+	return ret;
+}
+
+#if defined(CONFIG_NET_TCP_GSO)
+/* Copy the headers of @a pkt and @a len bytes of its data, starting at
+ * @a offset, into a new segment.
+ */
+static struct net_pkt *tcp_gso_segment_get(struct net_pkt *pkt, size_t hdr_len,
+					   size_t offset, size_t len,
+					   bool last)
+{
+	struct net_pkt *seg;
+	struct tcphdr *th;
+	uint8_t flags;
+
+	seg = tcp_pkt_alloc_no_conn(net_pkt_iface(pkt), net_pkt_family(pkt),
+				    hdr_len + len);
+	if (seg == NULL) {
+		return NULL;
+	}
+
+	net_pkt_set_context(seg, net_pkt_context(pkt));
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_ip_dscp(seg, net_pkt_ip_dscp(pkt));
+	net_pkt_set_ip_ecn(seg, net_pkt_ip_ecn(pkt));
+	net_pkt_set_vlan_tag(seg, net_pkt_vlan_tag(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		net_pkt_set_ipv4_ttl(seg, net_pkt_ipv4_ttl(pkt));
+		net_pkt_set_ipv4_opts_len(seg, net_pkt_ipv4_opts_len(pkt));
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		net_pkt_set_ipv6_hop_limit(seg, net_pkt_ipv6_hop_limit(pkt));
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+		net_pkt_set_ipv6_next_hdr(seg, net_pkt_ipv6_next_hdr(pkt));
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_copy(seg, pkt, hdr_len) < 0 ||
+	    net_pkt_skip(pkt, offset) < 0 ||
+	    net_pkt_copy(seg, pkt, len) < 0) {
+		goto fail;
+	}
+
+	th = th_get(seg);
+	if (th == NULL) {
+		goto fail;
+	}
+
+	flags = th_flags(th);
+	if (!last) {
+		flags &= ~(PSH | FIN);
+	}
+
+	UNALIGNED_PUT(htonl(th_seq(th) + offset), &th->th_seq);
+	UNALIGNED_PUT(flags, &th->th_flags);
+
+	/* Recalculated by tcp_finalize_pkt(), which expects it cleared */
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		NET_IPV4_HDR(seg)->chksum = 0U;
+	}
+
+	if (tcp_finalize_pkt(seg) < 0) {
+		goto fail;
+	}
+
+	return seg;
+
+fail:
+	tcp_pkt_unref(seg);
+
+	return NULL;
+}
+
+int net_tcp_gso_segment(struct net_pkt *pkt, sys_slist_t *segs)
+{
+	size_t gso_size = net_pkt_gso_size(pkt);
+	struct net_pkt *seg;
+	sys_snode_t *node;
+	struct tcphdr *th;
+	size_t hdr_len;
+	size_t len;
+
+	sys_slist_init(segs);
+
+	th = th_get(pkt);
+	if (th == NULL || gso_size == 0U) {
+		return -EINVAL;
+	}
+
+	hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+		  th_off(th) * 4U;
+	len = net_pkt_get_len(pkt) - hdr_len;
+
+	for (size_t offset = 0; offset < len; offset += gso_size) {
+		size_t seg_len = MIN(gso_size, len - offset);
+
+		seg = tcp_gso_segment_get(pkt, hdr_len, offset, seg_len,
+					  offset + seg_len == len);
+		if (seg == NULL) {
+			goto fail;
+		}
+
+		sys_slist_append(segs, &seg->next);
 	}
 
-	return net_pkt_copy(to, from, len);
+	return 0;
+
+fail:
+	while ((node = sys_slist_get(segs)) != NULL) {
+		tcp_pkt_unref(CONTAINER_OF(node, struct net_pkt, next));
+	}
+
+	return -ENOBUFS;
 }
+#endif /* CONFIG_NET_TCP_GSO */
 
-static int tcp_pkt_append(struct net_pkt *pkt, const uint8_t *data, size_t len)
+#if defined(CONFIG_NET_TCP_SACK)
+
+/* Scoreboard handling according to RFC 2018, the blocks are kept sorted
+ * and merged so that the holes between them are the data to resend.
+ */
+
+static void tcp_sack_board_add(struct tcp *conn, uint32_t left, uint32_t right)
 {
-	size_t alloc_len = len;
-	struct net_buf *buf = NULL;
-	int ret = 0;
+	struct tcp_sack_block *board = conn->sack_board;
+	int cnt = conn->sack_board_cnt;
+	int first = 0;
+	int last;
 
-	if (pkt->buffer) {
-		buf = net_buf_frag_last(pkt->buffer);
+	/* Skip the blocks entirely before the new one */
+	while (first < cnt && net_tcp_seq_cmp(board[first].right, left) < 0) {
+		first++;
+	}
 
-		if (len > net_buf_tailroom(buf)) {
-			alloc_len -= net_buf_tailroom(buf);
-		} else {
-			alloc_len = 0;
+	/* Absorb the blocks overlapping or touching the new one */
+	for (last = first;
+	     last < cnt && net_tcp_seq_cmp(board[last].left, right) <= 0;
+	     last++) {
+		if (net_tcp_seq_cmp(board[last].left, left) < 0) {
+			left = board[last].left;
 		}
-	}
 
-	if (alloc_len > 0) {
-		ret = net_pkt_alloc_buffer_raw(pkt, alloc_len,
-					       TCP_PKT_ALLOC_TIMEOUT);
-		if (ret < 0) {
-			return -ENOBUFS;
+		if (net_tcp_seq_greater(board[last].right, right)) {
+			right = board[last].right;
 		}
 	}
 
-	if (buf == NULL) {
-		buf = pkt->buffer;
+	if (first == last) {
+		if (cnt == CONFIG_NET_TCP_SACK_SCOREBOARD_SIZE) {
+			if (first == cnt) {
+				/* The new block is the furthest one */
+				return;
+			}
+
+			/* Forget the furthest block */
+			cnt--;
+		}
+
+		memmove(&board[first + 1], &board[first],
+			(cnt - first) * sizeof(*board));
+		cnt++;
+	} else {
+		memmove(&board[first + 1], &board[last],
+			(cnt - last) * sizeof(*board));
+		cnt -= last - first - 1;
 	}
 
-	while (buf != NULL && len > 0) {
-		size_t write_len = MIN(len, net_buf_tailroom(buf));
+	board[first].left = left;
+	board[first].right = right;
+	conn->sack_board_cnt = cnt;
+}
 
-		net_buf_add_mem(buf, data, write_len);
+/* Record the SACK blocks carried by the segment being processed */
+static void tcp_sack_update(struct tcp *conn)
+{
+	uint32_t end = conn->seq + conn->unacked_len;
 
-		data += write_len;
-		len -= write_len;
-		buf = buf->frags;
+	if (!conn->sack_ok) {
+		return;
 	}
 
-	NET_ASSERT(len == 0, "Not all bytes written");
+	for (int i = 0; i < conn->recv_options.sack_cnt; i++) {
+		struct tcp_sack_block *sack = &conn->recv_options.sack[i];
 
-	return ret;
+		/* Ignore D-SACK and bogus blocks, see RFC 2883 and 2018 */
+		if (!net_tcp_seq_greater(sack->right, sack->left) ||
+		    !net_tcp_seq_greater(sack->right, conn->seq) ||
+		    net_tcp_seq_greater(sack->right, end)) {
+			continue;
+		}
+
+		tcp_sack_board_add(conn,
+				   net_tcp_seq_greater(sack->left, conn->seq) ?
+				   sack->left : conn->seq,
+				   sack->right);
+	}
+
+	/* Segments without options do not go through tcp_options_check() */
+	conn->recv_options.sack_cnt = 0;
 }
 
-static bool tcp_window_full(struct tcp *conn)
+/* Drop what the cumulative acknowledgement now covers */
+static void tcp_sack_acked(struct tcp *conn)
 {
-	bool window_full = (conn->send_data_total >= conn->send_win);
+	struct tcp_sack_block *board = conn->sack_board;
+	int drop = 0;
 
-#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-	window_full = window_full || (conn->send_data_total >= conn->ca.cwnd);
-#endif
+	while (drop < conn->sack_board_cnt &&
+	       net_tcp_seq_cmp(board[drop].right, conn->seq) <= 0) {
+		drop++;
+	}
 
-	if (window_full) {
-		NET_DBG("conn: %p TX window_full", conn);
+	conn->sack_board_cnt -= drop;
+	memmove(&board[0], &board[drop], conn->sack_board_cnt * sizeof(*board));
+
+	if (conn->sack_board_cnt > 0 &&
+	    net_tcp_seq_cmp(board[0].left, conn->seq) < 0) {
+		board[0].left = conn->seq;
 	}
+}
 
-	return window_full;
+/* The receiver may discard SACKed data, so the scoreboard must not be
+ * trusted after a retransmission timeout (RFC 2018 ch 8).
+ */
+static void tcp_sack_reset(struct tcp *conn)
+{
+	conn->sack_board_cnt = 0;
 }
 
-static int tcp_unsent_len(struct tcp *conn)
+/* Estimate of the data in the network, the pipe of RFC 6675 ch 4: the
+ * holes below the highest SACKed block are taken as lost unless they were
+ * resent during this recovery, the data above it is still in flight.
+ */
+static uint32_t tcp_sack_pipe(struct tcp *conn)
 {
-	int unsent_len;
+	uint32_t high = conn->seq + conn->unacked_len;
+	uint32_t hole = conn->seq;
+	uint32_t pipe = 0;
 
-	if (conn->unacked_len > conn->send_data_total) {
-		NET_ERR("total=%zu, unacked_len=%d",
-			conn->send_data_total, conn->unacked_len);
-		unsent_len = -ERANGE;
-		goto out;
+	for (int i = 0; i < conn->sack_board_cnt; i++) {
+		struct tcp_sack_block *block = &conn->sack_board[i];
+
+		if (net_tcp_seq_greater(conn->sack_high_rxt, hole)) {
+			pipe += (net_tcp_seq_cmp(conn->sack_high_rxt, block->left) < 0 ?
+				 conn->sack_high_rxt : block->left) - hole;
+		}
+
+		hole = block->right;
 	}
 
-	unsent_len = conn->send_data_total - conn->unacked_len;
-	if (conn->unacked_len >= conn->send_win) {
-		unsent_len = 0;
-	} else {
-		unsent_len = MIN(unsent_len, conn->send_win - conn->unacked_len);
+	if (net_tcp_seq_greater(high, hole)) {
+		pipe += high - hole;
+	}
+
+	return pipe;
+}
 
+static uint32_t tcp_sack_cwnd(struct tcp *conn)
+{
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-		if (conn->unacked_len >= conn->ca.cwnd) {
-			unsent_len = 0;
-		} else {
-			unsent_len = MIN(unsent_len, conn->ca.cwnd - conn->unacked_len);
-		}
+	return conn->ca.cwnd;
+#else
+	return conn->send_win;
 #endif
-	}
- out:
-	return unsent_len;
 }
 
-static int tcp_send_data(struct tcp *conn)
+/* Resend the holes between SACKed blocks that have not been resent yet
+ * during this recovery, as long as the pipe stays below the congestion
+ * window. The first hole is resent when the recovery starts in any case.
+ * Data above the highest SACKed block is not known to be lost, so it is
+ * left alone.
+ *
+ * Return false if the scoreboard is empty and nothing was sent.
+ */
+static bool tcp_sack_retransmit(struct tcp *conn, bool recovery_start)
 {
-	int ret = 0;
-	int len;
-	struct net_pkt *pkt;
+	uint32_t cwnd = tcp_sack_cwnd(conn);
+	uint32_t hole = conn->seq;
+	uint32_t pipe;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
-	if (len < 0) {
-		ret = len;
-		goto out;
-	}
-	if (len == 0) {
-		NET_DBG("conn: %p no data to send", conn);
-		ret = -ENODATA;
-		goto out;
+	if (conn->sack_board_cnt == 0) {
+		return false;
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
-	if (!pkt) {
-		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+	if (recovery_start) {
+		conn->sack_high_rxt = conn->seq;
 	}
 
-	ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
-	if (ret < 0) {
-		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
-		goto out;
-	}
+	pipe = tcp_sack_pipe(conn);
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
-	if (ret == 0) {
-		conn->unacked_len += len;
+	for (int i = 0; i < conn->sack_board_cnt; i++) {
+		struct tcp_sack_block *block = &conn->sack_board[i];
+
+		if (net_tcp_seq_greater(conn->sack_high_rxt, hole)) {
+			hole = conn->sack_high_rxt;
+		}
+
+		while (net_tcp_seq_greater(block->left, hole)) {
+			int len = MIN(block->left - hole, conn_mss(conn));
+
+			if (pipe >= cwnd && !recovery_start) {
+				return true;
+			}
+
+			if (tcp_send_segment(conn, hole - conn->seq, len) < 0) {
+				return true;
+			}
 
-		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
 			net_stats_update_tcp_resent(conn->iface, len);
 			net_stats_update_tcp_seg_rexmit(conn->iface);
-		} else {
-			net_stats_update_tcp_sent(conn->iface, len);
-			net_stats_update_tcp_seg_sent(conn->iface);
+
+			hole += len;
+			conn->sack_high_rxt = hole;
+			pipe += len;
+			recovery_start = false;
 		}
+
+		hole = block->right;
 	}
 
-	/* The data we want to send, has been moved to the send queue so we
-	 * can unref the head net_pkt. If there was an error, we need to remove
-	 * the packet anyway.
-	 */
-	tcp_pkt_unref(pkt);
+	return true;
+}
+#else
 
-	conn_send_data_dump(conn);
+static void tcp_sack_update(struct tcp *conn) { }
 
- out:
-	return ret;
+static void tcp_sack_acked(struct tcp *conn) { }
+
+static void tcp_sack_reset(struct tcp *conn) { }
+
+static bool tcp_sack_retransmit(struct tcp *conn, bool recovery_start)
+{
+	return false;
 }
 
+#endif
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1874,6 +2756,8 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+	tcp_sack_reset(conn);
+
 	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE) &&
 	    (conn->send_data_retries == 0)) {
 		tcp_ca_timeout(conn);
@@ -2139,6 +3023,7 @@ static struct tcp *tcp_conn_alloc(void)
 	 * is available as soon as the connection is established
 	 */
 	conn->ca.cwnd = UINT16_MAX;
+	conn->ca.ops = TCP_CA_DEFAULT;
 #endif
 
 	/* The ISN value will be set when we get the connection attempt or
@@ -2236,6 +3121,169 @@ static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 
 static struct tcp *tcp_conn_new(struct net_pkt *pkt);
 
+#if defined(CONFIG_NET_TCP_GRO)
+/* Hold @a pkt, or append its data to the segments already held, if it
+ * continues them. @a th is the TCP header of @a pkt, which the packet
+ * cursor points to, @a rcv_nxt the next sequence number the connection
+ * expects, as read under its lock. Called with tcp_gro_lock held.
+ */
+static bool tcp_gro_merge(struct tcp *conn, struct net_pkt *pkt,
+			  struct tcphdr *th, uint32_t rcv_nxt)
+{
+	struct tcphdr *held_th = conn->gro_th;
+	struct net_buf *frags;
+	size_t len;
+
+	/* Only plain data segments, anything else may change the state */
+	if (th == NULL || (th_flags(th) & ~PSH) != ACK || th_off(th) != 5) {
+		return false;
+	}
+
+	len = tcp_data_len(pkt);
+	if (len == 0) {
+		return false;
+	}
+
+	if (conn->gro_pkt == NULL) {
+		if (th_seq(th) != rcv_nxt) {
+			return false;
+		}
+
+		/* Only data is appended, so the header does not move */
+		conn->gro_pkt = pkt;
+		conn->gro_th = th;
+		conn->gro_seq_next = th_seq(th) + len;
+		conn->gro_len = len;
+
+		/* Keep the connection until the segments are flushed */
+		tcp_conn_ref(conn);
+		sys_slist_append(&tcp_gro_conns, &conn->gro_node);
+
+		return true;
+	}
+
+	if (th_seq(th) != conn->gro_seq_next ||
+	    conn->gro_len + len > CONFIG_NET_TCP_GRO_MAX_SIZE) {
+		return false;
+	}
+
+	/* The latest segment carries the most recent ACK and window */
+	UNALIGNED_PUT(UNALIGNED_GET(&th->th_ack), &held_th->th_ack);
+	UNALIGNED_PUT(th_win(th), &held_th->th_win);
+	UNALIGNED_PUT(th_flags(held_th) | th_flags(th), &held_th->th_flags);
+
+	/* Move the payload over, leaving the headers behind */
+	net_pkt_skip(pkt, sizeof(*th));
+
+	frags = pkt->buffer;
+	while (frags != pkt->cursor.buf) {
+		frags = net_buf_frag_del(NULL, frags);
+	}
+
+	net_buf_pull(frags, pkt->cursor.pos - frags->data);
+	pkt->buffer = NULL;
+	net_pkt_unref(pkt);
+
+	net_pkt_append_buffer(conn->gro_pkt, frags);
+	conn->gro_seq_next += len;
+	conn->gro_len += len;
+
+	return true;
+}
+
+/* Take the held segments of @a conn. Called with tcp_gro_lock held. */
+static struct net_pkt *tcp_gro_take(struct tcp *conn)
+{
+	struct net_pkt *pkt = conn->gro_pkt;
+
+	if (pkt != NULL) {
+		sys_slist_find_and_remove(&tcp_gro_conns, &conn->gro_node);
+		conn->gro_pkt = NULL;
+		conn->gro_th = NULL;
+		conn->gro_len = 0;
+	}
+
+	return pkt;
+}
+
+static void tcp_gro_deliver(struct tcp *conn, struct net_pkt *pkt)
+{
+	if (tcp_in(conn, pkt) == NET_DROP) {
+		tcp_pkt_unref(pkt);
+	}
+
+	tcp_conn_unref(conn);
+}
+
+static enum net_verdict tcp_gro_input(struct tcp *conn, struct net_pkt *pkt)
+{
+	/* Might need to linearize the header, so not under the lock */
+	struct tcphdr *th = th_get(pkt);
+	struct net_pkt *held;
+	k_spinlock_key_t key;
+	bool established;
+	uint32_t rcv_nxt;
+	uint16_t mss;
+
+	/* The state machine updates these under conn->lock, which cannot
+	 * be taken with the spinlock held.
+	 */
+	k_mutex_lock(&conn->lock, K_FOREVER);
+	established = (conn->state == TCP_ESTABLISHED);
+	rcv_nxt = conn->ack;
+	mss = conn_mss(conn);
+	k_mutex_unlock(&conn->lock);
+
+	key = k_spin_lock(&tcp_gro_lock);
+
+	if (established && tcp_gro_merge(conn, pkt, th, rcv_nxt)) {
+		if (conn->gro_len + mss <= CONFIG_NET_TCP_GRO_MAX_SIZE) {
+			k_spin_unlock(&tcp_gro_lock, key);
+			return NET_OK;
+		}
+
+		/* No room for another segment, pass them on now */
+		pkt = NULL;
+	}
+
+	held = tcp_gro_take(conn);
+
+	k_spin_unlock(&tcp_gro_lock, key);
+
+	/* Keep the order: the held data precedes the new segment */
+	if (held != NULL) {
+		tcp_gro_deliver(conn, held);
+	}
+
+	return (pkt != NULL) ? tcp_in(conn, pkt) : NET_OK;
+}
+
+void net_tcp_gro_flush(void)
+{
+	struct net_pkt *pkt;
+	k_spinlock_key_t key;
+	sys_snode_t *node;
+	struct tcp *conn;
+
+	while (true) {
+		key = k_spin_lock(&tcp_gro_lock);
+
+		node = sys_slist_peek_head(&tcp_gro_conns);
+		if (node == NULL) {
+			k_spin_unlock(&tcp_gro_lock, key);
+			break;
+		}
+
+		conn = CONTAINER_OF(node, struct tcp, gro_node);
+		pkt = tcp_gro_take(conn);
+
+		k_spin_unlock(&tcp_gro_lock, key);
+
+		tcp_gro_deliver(conn, pkt);
+	}
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
 static enum net_verdict tcp_recv(struct net_conn *net_conn,
 				 struct net_pkt *pkt,
 				 union net_ip_header *ip,
@@ -2269,7 +3317,11 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 	}
 in:
 	if (conn) {
+#if defined(CONFIG_NET_TCP_GRO)
+		verdict = tcp_gro_input(conn, pkt);
+#else
 		verdict = tcp_in(conn, pkt);
+#endif
 	} else {
 		net_tcp_reply_rst(pkt);
 	}
@@ -2869,7 +3921,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	}
 
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
-						  tcp_options_len)) {
+						  tcp_options_len,
+						  (fl & SYN) != 0)) {
 		NET_DBG("DROP: Invalid TCP option list");
 		tcp_out(conn, RST);
 		do_close = true;
@@ -2894,6 +3947,12 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 	if (th) {
 		conn->send_win = ntohs(th_win(th));
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+		/* The window in a SYN is never scaled (RFC 7323 ch 2.2) */
+		if (!(th_flags(th) & SYN)) {
+			conn->send_win <<= conn->send_wscale;
+		}
+#endif
 		if (conn->send_win > conn->send_win_max) {
 			NET_DBG("Lowering send window from %u to %u",
 				conn->send_win, conn->send_win_max);
@@ -2925,11 +3984,21 @@ next_state:
 	switch (conn->state) {
 	case TCP_LISTEN:
 		if (FL(&fl, ==, SYN)) {
-			/* Make sure our MSS is also sent in the ACK */
+			tcp_syn_options_negotiate(conn);
+
+			/* Make sure our MSS is also sent in the ACK, along with
+			 * the options the peer offered and we support.
+			 */
 			conn->send_options.mss_found = true;
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+			conn->send_options.wnd_found = conn->recv_options.wnd_found;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+			conn->send_options.sack_permitted = conn->sack_ok;
+#endif
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
 			tcp_out(conn, SYN | ACK);
-			conn->send_options.mss_found = false;
+			tcp_syn_options_clear(conn);
 			conn_seq(conn, + 1);
 			next = TCP_SYN_RECEIVED;
 
@@ -2941,12 +4010,18 @@ next_state:
 			verdict = NET_OK;
 		} else {
 			conn->send_options.mss_found = true;
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+			conn->send_options.wnd_found = true;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+			conn->send_options.sack_permitted = true;
+#endif
 			ret = tcp_out_ext(conn, SYN, NULL /* no data */, conn->seq);
 			if (ret < 0) {
 				do_close = true;
 				close_status = ret;
 			} else {
-				conn->send_options.mss_found = false;
+				tcp_syn_options_clear(conn);
 				conn_seq(conn, + 1);
 				next = TCP_SYN_SENT;
 				tcp_conn_ref(conn);
@@ -2963,6 +4038,9 @@ next_state:
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+				conn->ca.ops = conn->accepted_conn->ca.ops;
+#endif
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
@@ -3052,6 +4130,7 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+			tcp_syn_options_negotiate(conn);
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -3135,6 +4214,10 @@ next_state:
 		 */
 		keep_alive_timer_restart(conn);
 
+		if (th) {
+			tcp_sack_update(conn);
+		}
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (th && (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0)) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -3155,20 +4238,33 @@ next_state:
 			/* Only do fast retransmit when not already in a resend state */
 			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
 			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
-				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
+				/* Apply a fast retransmit, of the holes in the
+				 * SACK scoreboard if the peer reported any. The
+				 * window is reduced first, it limits the holes
+				 * resent at once.
+				 */
+				tcp_ca_fast_retransmit(conn);
 
-				conn->unacked_len = 0;
+				if (!tcp_sack_retransmit(conn, true)) {
+					int temp_unacked_len = conn->unacked_len;
 
-				(void)tcp_send_data(conn);
+					conn->unacked_len = 0;
 
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+					(void)tcp_send_data(conn);
+
+					/* Restore the current transmission */
+					conn->unacked_len = temp_unacked_len;
+				}
 
-				tcp_ca_fast_retransmit(conn);
 				if (tcp_window_full(conn)) {
 					(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 				}
+			} else if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
+				   (conn->dup_ack_cnt > DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
+				/* Later duplicate ACKs may SACK more data and
+				 * uncover further holes.
+				 */
+				(void)tcp_sack_retransmit(conn, false);
 			}
 		}
 #endif
@@ -3213,6 +4309,7 @@ next_state:
 			}
 
 			conn_seq(conn, + len_acked);
+			tcp_sack_acked(conn);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
 			/* Receipt of an acknowledgment that covers a sequence number
@@ -4553,6 +5650,13 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+		ret = set_tcp_congestion(conn, value, len);
+#else
+		ret = -ENOPROTOOPT;
+#endif
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4590,6 +5694,13 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+		ret = get_tcp_congestion(conn, value, len);
+#else
+		ret = -ENOPROTOOPT;
+#endif
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -36,6 +36,7 @@ enum tcp_conn_option {
 	TCP_OPT_KEEPIDLE = 3,
 	TCP_OPT_KEEPINTVL = 4,
 	TCP_OPT_KEEPCNT = 5,
+	TCP_OPT_CONGESTION = 6,
 };
 
 /**
@@ -286,6 +287,44 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 }
 #endif
 
+/**
+ * @brief Split a TCP packet sent with generic segmentation offload
+ *
+ * The packet is left untouched, the segments each get a copy of its
+ * headers, with the sequence number, flags, lengths and checksums updated,
+ * and at most net_pkt_gso_size() bytes of its data.
+ *
+ * @param pkt Network packet, having a non-zero net_pkt_gso_size()
+ * @param segs List the segments are appended to, through their next field
+ *
+ * @return 0 on success, negative errno otherwise, in which case @a segs
+ *         is empty.
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_segment(struct net_pkt *pkt, sys_slist_t *segs);
+#else
+static inline int net_tcp_gso_segment(struct net_pkt *pkt, sys_slist_t *segs)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(segs);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Pass the TCP segments coalesced by generic receive offload up
+ *
+ * Called by the RX traffic class thread once its queue is empty.
+ */
+#if defined(CONFIG_NET_TCP_GRO)
+void net_tcp_gro_flush(void);
+#else
+static inline void net_tcp_gro_flush(void)
+{
+}
+#endif
+
 /**
  * @brief Enqueue data for transmission
  *
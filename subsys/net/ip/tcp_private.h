@@ -146,7 +146,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("conn: %p total=%zd, unacked_len=%d, "                 \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                               \
 			(_conn), net_pkt_get_len((_conn)->send_data),          \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -227,30 +227,85 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+
+/* Largest shift allowed by RFC 7323 ch 2.3 */
+#define NET_TCP_MAX_WINDOW_SCALE 14
+
+/* Room left by the TCP header for SACK blocks, after NOP, NOP, kind, len */
+#define NET_TCP_MAX_SACK_BLOCKS 4
+
+struct tcp_sack_block {
+	uint32_t left;
+	uint32_t right;
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+#if defined(CONFIG_NET_TCP_SACK)
+	/* SACK blocks carried by the last received segment */
+	struct tcp_sack_block sack[NET_TCP_MAX_SACK_BLOCKS];
+	uint8_t sack_cnt;
+	bool sack_permitted : 1;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
 };
 
+struct tcp;
+
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
-struct tcp_collision_avoidance_reno {
-	uint16_t cwnd;
-	uint16_t ssthresh;
-	uint16_t pending_fast_retransmit_bytes;
+/* Longest congestion control algorithm name, including the terminator */
+#define TCP_CA_NAME_MAX 16
+
+/** Congestion control algorithm, called with the connection locked */
+struct tcp_ca_ops {
+	/** Name used to select the algorithm with TCP_CONGESTION */
+	const char *name;
+	/** Connection established, set up the initial window */
+	void (*init)(struct tcp *conn);
+	/** Third duplicate ACK received, entering fast recovery */
+	void (*fast_retransmit)(struct tcp *conn);
+	/** Retransmission timer expired */
+	void (*timeout)(struct tcp *conn);
+	/** Duplicate ACK received */
+	void (*dup_ack)(struct tcp *conn);
+	/** New data acknowledged */
+	void (*pkts_acked)(struct tcp *conn, uint32_t acked_len);
+};
+
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+struct tcp_ca_cubic {
+	uint32_t w_max;        /* Window before the last reduction */
+	uint32_t w_est;        /* Reno friendly window estimate */
+	uint32_t origin;       /* Plateau of the cubic function */
+	uint32_t k;            /* Time to reach the plateau, in ms */
+	uint32_t epoch_start;  /* Start of the epoch in ms, 0 if none */
+};
+#endif
+
+struct tcp_collision_avoidance {
+	const struct tcp_ca_ops *ops;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t pending_fast_retransmit_bytes;
+#ifdef CONFIG_NET_TCP_CONGESTION_CUBIC
+	struct tcp_ca_cubic cubic;
+#endif
 };
 #endif
 
-struct tcp;
 typedef void (*net_tcp_closed_cb_t)(struct tcp *conn, void *user_data);
 
 struct tcp { /* TCP connection */
@@ -314,22 +369,33 @@ struct tcp { /* TCP connection */
 	uint32_t keep_cnt;
 	uint32_t keep_cur;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
-	uint16_t recv_win_sent;
-	uint16_t recv_win_max;
-	uint16_t recv_win;
-	uint16_t send_win_max;
-	uint16_t send_win;
+	uint32_t recv_win_sent;
+	uint32_t recv_win_max;
+	uint32_t recv_win;
+	uint32_t send_win_max;
+	uint32_t send_win;
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Blocks SACKed by the peer above seq, sorted and non overlapping */
+	struct tcp_sack_block sack_board[CONFIG_NET_TCP_SACK_SCOREBOARD_SIZE];
+	/* Highest sequence retransmitted from the scoreboard */
+	uint32_t sack_high_rxt;
+	uint8_t sack_board_cnt;
+#endif
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
 	uint16_t rto;
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
-	struct tcp_collision_avoidance_reno ca;
+	struct tcp_collision_avoidance ca;
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	uint8_t dup_ack_cnt;
 #endif
 	uint8_t zwp_retries;
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+	uint8_t send_wscale; /* Shift applied to the peer's window */
+	uint8_t recv_wscale; /* Shift applied to our advertised window */
+#endif
 	bool in_retransmission : 1;
 	bool in_connect : 1;
 	bool in_close : 1;
@@ -338,6 +404,17 @@ struct tcp { /* TCP connection */
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
 	bool tcp_nodelay : 1;
 	bool addr_ref_done : 1;
+#if defined(CONFIG_NET_TCP_SACK)
+	bool sack_ok : 1;
+#endif
+#if defined(CONFIG_NET_TCP_GRO)
+	/* In-order data segments held for coalescing, see tcp_gro_merge() */
+	struct net_pkt *gro_pkt;
+	struct tcphdr *gro_th;
+	sys_snode_t gro_node;
+	uint32_t gro_seq_next;
+	size_t gro_len;
+#endif
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
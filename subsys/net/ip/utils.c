@@ -520,6 +520,90 @@ static uint16_t offset_based_swap8(const uint8_t *data)
 	}
 }
 
+#if defined(CONFIG_NET_IP_CHKSUM_WIDE) && defined(CONFIG_64BIT)
+static inline uint64_t chksum_add64(uint64_t sum, uint64_t word)
+{
+	sum += word;
+
+	/* End-around carry, 2^64 is congruent to 1 modulo 0xffff */
+	return sum + (sum < word);
+}
+
+/* Sum the 32-bit aligned @a data in 64-bit words, leaving less than
+ * 32 bytes for the caller.
+ */
+static uint64_t chksum_wide(uint64_t sum, const uint8_t **data, size_t *pending)
+{
+	const uint64_t *p;
+	uint64_t sum_b = 0;
+	size_t left = *pending;
+
+	if ((((uintptr_t)*data & 0x04) != 0) && (left >= sizeof(uint32_t))) {
+		sum += *((const uint32_t *)*data);
+		*data += sizeof(uint32_t);
+		left -= sizeof(uint32_t);
+	}
+
+	p = (const uint64_t *)*data;
+
+	/* Two accumulators, so that the carry chains can run in parallel */
+	while (left >= sizeof(uint64_t) * 4) {
+		sum = chksum_add64(sum, p[0]);
+		sum_b = chksum_add64(sum_b, p[1]);
+		sum = chksum_add64(sum, p[2]);
+		sum_b = chksum_add64(sum_b, p[3]);
+		p += 4;
+		left -= sizeof(uint64_t) * 4;
+	}
+
+	*data = (const uint8_t *)p;
+	*pending = left;
+
+	sum = chksum_add64(sum, sum_b);
+
+	/* Fold to 33 bits, so that the caller can add the tail without
+	 * losing a carry out of bit 63.
+	 */
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	sum = (sum & 0xffffffff) + (sum >> 32);
+
+	return sum;
+}
+#elif defined(CONFIG_NET_IP_CHKSUM_WIDE) && defined(CONFIG_ARM) && \
+	!defined(CONFIG_ARMV6_M_ARMV8_M_BASELINE)
+/* Sum the 32-bit aligned @a data with an add-with-carry chain, leaving
+ * less than 16 bytes for the caller.
+ */
+static uint64_t chksum_wide(uint64_t sum, const uint8_t **data, size_t *pending)
+{
+	const uint32_t *p = (const uint32_t *)*data;
+	size_t left = *pending;
+	uint32_t lo = 0;
+	uint32_t hi = 0;
+
+	/* Carries inside the chain are added back as 1, which is congruent
+	 * to 2^32 modulo 0xffff, the last one is counted in hi.
+	 */
+	while (left >= sizeof(uint32_t) * 4) {
+		__asm__ ("adds %0, %0, %2\n\t"
+			 "adcs %0, %0, %3\n\t"
+			 "adcs %0, %0, %4\n\t"
+			 "adcs %0, %0, %5\n\t"
+			 "adc %1, %1, #0"
+			 : "+r" (lo), "+r" (hi)
+			 : "r" (p[0]), "r" (p[1]), "r" (p[2]), "r" (p[3])
+			 : "cc");
+		p += 4;
+		left -= sizeof(uint32_t) * 4;
+	}
+
+	*data = (const uint8_t *)p;
+	*pending = left;
+
+	return sum + (((uint64_t)hi << 32) | lo);
+}
+#endif
+
 /* Word based checksum calculation based on:
  * https://blogs.igalia.com/dpino/2018/06/14/fast-checksum-computation/
  * It’s not necessary to add octets as 16-bit words. Due to the associative property of addition,
@@ -555,6 +639,11 @@ uint16_t calc_chksum(uint16_t sum_in, const uint8_t *data, size_t len)
 		sum = sum + *((uint16_t *)data);
 		data += sizeof(uint16_t);
 	}
+#if defined(CONFIG_NET_IP_CHKSUM_WIDE) && \
+	(defined(CONFIG_64BIT) || \
+	 (defined(CONFIG_ARM) && !defined(CONFIG_ARMV6_M_ARMV8_M_BASELINE)))
+	sum = chksum_wide(sum, &data, &pending);
+#endif
 	p = (uint32_t *)data;
 
 	/* Do loop unrolling for the very large data sets */
@@ -611,8 +700,12 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 	while (cur->buf) {
 		sum = calc_chksum(sum, cur->pos, len);
 
-		cur->buf = cur->buf->frags;
-		if (!cur->buf || !cur->buf->len) {
+		/* Empty fragments do not end the data, skip over them */
+		do {
+			cur->buf = cur->buf->frags;
+		} while (cur->buf && !cur->buf->len);
+
+		if (!cur->buf) {
 			break;
 		}
 
@@ -11,9 +11,11 @@
 LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #include <zephyr/kernel.h>
+#include <zephyr/net_buf.h>
 #include <zephyr/tracing/tracing.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/internal/syscall_handler.h>
+#include <zephyr/sys/math_extras.h>
 
 #include "sockets_internal.h"
 
@@ -369,107 +371,200 @@ ssize_t z_vrfy_zsock_sendto(int sock, const void *buf, size_t len, int flags,
 #include <zephyr/syscalls/zsock_sendto_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
-ssize_t z_impl_zsock_sendmsg(int sock, const struct msghdr *msg, int flags)
+#ifdef CONFIG_USERSPACE
+static void msghdr_copy_free(struct msghdr *msg_copy, size_t iovlen)
 {
-	int bytes_sent;
-
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(socket, sendmsg, sock, msg, flags);
-
-	bytes_sent = VTABLE_CALL(sendmsg, sock, msg, flags);
-
-	SYS_PORT_TRACING_OBJ_FUNC_EXIT(socket, sendmsg, sock,
-				       bytes_sent < 0 ? -errno : bytes_sent);
+	k_free(msg_copy->msg_name);
+	k_free(msg_copy->msg_control);
 
-	sock_obj_core_update_send_stats(sock, bytes_sent);
+	if (msg_copy->msg_iov != NULL) {
+		for (size_t i = 0; i < iovlen; i++) {
+			k_free(msg_copy->msg_iov[i].iov_base);
+		}
 
-	return bytes_sent;
+		k_free(msg_copy->msg_iov);
+	}
 }
 
-#ifdef CONFIG_USERSPACE
-static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
-					   const struct msghdr *msg,
-					   int flags)
+/* Copy a message header and all the buffers it points to from user space
+ * into kernel heap buffers, to be released with msghdr_copy_free().
+ *
+ * Return 0 on success, -1 with errno set if a buffer cannot be copied, or
+ * -EFAULT if @a msg itself cannot be read. In the latter case nothing is
+ * allocated, the caller is expected to K_OOPS() once it released what it
+ * holds.
+ */
+static int msghdr_copy_from_user(struct msghdr *msg_copy,
+				 const struct msghdr *msg)
 {
-	struct msghdr msg_copy;
-	size_t i;
-	int ret;
+	struct iovec *iov;
+	void *name;
+	void *control;
+	size_t i = 0;
+
+	if (k_usermode_from_copy(msg_copy, (void *)msg, sizeof(*msg_copy)) != 0) {
+		return -EFAULT;
+	}
 
-	K_OOPS(k_usermode_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+	iov = msg_copy->msg_iov;
+	name = msg_copy->msg_name;
+	control = msg_copy->msg_control;
 
-	msg_copy.msg_name = NULL;
-	msg_copy.msg_control = NULL;
+	msg_copy->msg_iov = NULL;
+	msg_copy->msg_name = NULL;
+	msg_copy->msg_control = NULL;
 
-	msg_copy.msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
-				       msg->msg_iovlen * sizeof(struct iovec));
-	if (!msg_copy.msg_iov) {
-		errno = ENOMEM;
-		goto fail;
+	/* A message without data has no iovec array */
+	if (msg_copy->msg_iovlen > 0) {
+		if (iov == NULL) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		msg_copy->msg_iov = k_usermode_alloc_from_copy(iov,
+					msg_copy->msg_iovlen * sizeof(struct iovec));
+		if (!msg_copy->msg_iov) {
+			errno = ENOMEM;
+			return -1;
+		}
 	}
 
-	for (i = 0; i < msg->msg_iovlen; i++) {
-		msg_copy.msg_iov[i].iov_base =
-			k_usermode_alloc_from_copy(msg->msg_iov[i].iov_base,
-					       msg->msg_iov[i].iov_len);
-		if (!msg_copy.msg_iov[i].iov_base) {
+	for (i = 0; i < msg_copy->msg_iovlen; i++) {
+		msg_copy->msg_iov[i].iov_base =
+			k_usermode_alloc_from_copy(msg_copy->msg_iov[i].iov_base,
+						   msg_copy->msg_iov[i].iov_len);
+		if (!msg_copy->msg_iov[i].iov_base) {
 			errno = ENOMEM;
 			goto fail;
 		}
-
-		msg_copy.msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
 	}
 
-	if (msg->msg_namelen > 0) {
-		msg_copy.msg_name = k_usermode_alloc_from_copy(msg->msg_name,
-							   msg->msg_namelen);
-		if (!msg_copy.msg_name) {
+	if (msg_copy->msg_namelen > 0) {
+		if (name == NULL) {
+			errno = EINVAL;
+			goto fail;
+		}
+
+		msg_copy->msg_name = k_usermode_alloc_from_copy(name,
+							msg_copy->msg_namelen);
+		if (msg_copy->msg_name == NULL) {
 			errno = ENOMEM;
 			goto fail;
 		}
 	}
 
-	if (msg->msg_controllen > 0) {
-		msg_copy.msg_control = k_usermode_alloc_from_copy(msg->msg_control,
-							  msg->msg_controllen);
-		if (!msg_copy.msg_control) {
+	if (msg_copy->msg_controllen > 0) {
+		if (control == NULL) {
+			errno = EINVAL;
+			goto fail;
+		}
+
+		msg_copy->msg_control =
+			k_usermode_alloc_from_copy(control,
+						   msg_copy->msg_controllen);
+		if (msg_copy->msg_control == NULL) {
 			errno = ENOMEM;
 			goto fail;
 		}
 	}
 
-	ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
-				   flags);
+	return 0;
 
-	k_free(msg_copy.msg_name);
-	k_free(msg_copy.msg_control);
-
-	for (i = 0; i < msg_copy.msg_iovlen; i++) {
-		k_free(msg_copy.msg_iov[i].iov_base);
-	}
+fail:
+	msghdr_copy_free(msg_copy, i);
 
-	k_free(msg_copy.msg_iov);
+	return -1;
+}
 
-	return ret;
+/* Copy a received message back to user space. The msghdr_copy_from_user()
+ * copy of @a msg is passed in @a msg_copy, @a iovlen is the original
+ * number of its vectors.
+ */
+static void msghdr_copy_to_user(struct msghdr *msg,
+				const struct msghdr *msg_copy, size_t iovlen)
+{
+	size_t i;
 
-fail:
-	if (msg_copy.msg_name) {
-		k_free(msg_copy.msg_name);
+	if (msg->msg_namelen > 0 && msg->msg_name != NULL) {
+		K_OOPS(k_usermode_to_copy(msg->msg_name,
+					  msg_copy->msg_name,
+					  msg_copy->msg_namelen));
 	}
 
-	if (msg_copy.msg_control) {
-		k_free(msg_copy.msg_control);
+	if (msg->msg_controllen > 0 &&
+	    msg->msg_control != NULL) {
+		K_OOPS(k_usermode_to_copy(msg->msg_control,
+					  msg_copy->msg_control,
+					  msg_copy->msg_controllen));
+
+		msg->msg_controllen = msg_copy->msg_controllen;
+	} else {
+		msg->msg_controllen = 0U;
 	}
 
-	if (msg_copy.msg_iov) {
-		for (i = 0; i < msg_copy.msg_iovlen; i++) {
-			if (msg_copy.msg_iov[i].iov_base) {
-				k_free(msg_copy.msg_iov[i].iov_base);
-			}
+	k_usermode_to_copy(&msg->msg_iovlen,
+			   &msg_copy->msg_iovlen,
+			   sizeof(msg->msg_iovlen));
+
+	/* The new iovlen cannot be bigger than the original one */
+	NET_ASSERT(msg_copy->msg_iovlen <= iovlen);
+
+	for (i = 0; i < iovlen; i++) {
+		if (i < msg_copy->msg_iovlen) {
+			K_OOPS(k_usermode_to_copy(msg->msg_iov[i].iov_base,
+						  msg_copy->msg_iov[i].iov_base,
+						  msg_copy->msg_iov[i].iov_len));
+			K_OOPS(k_usermode_to_copy(&msg->msg_iov[i].iov_len,
+						  &msg_copy->msg_iov[i].iov_len,
+						  sizeof(msg->msg_iov[i].iov_len)));
+		} else {
+			/* Clear out those vectors that we could not populate */
+			msg->msg_iov[i].iov_len = 0;
 		}
+	}
+
+	k_usermode_to_copy(&msg->msg_flags,
+			   &msg_copy->msg_flags,
+			   sizeof(msg->msg_flags));
+}
+#endif /* CONFIG_USERSPACE */
+
+ssize_t z_impl_zsock_sendmsg(int sock, const struct msghdr *msg, int flags)
+{
+	int bytes_sent;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(socket, sendmsg, sock, msg, flags);
+
+	bytes_sent = VTABLE_CALL(sendmsg, sock, msg, flags);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(socket, sendmsg, sock,
+				       bytes_sent < 0 ? -errno : bytes_sent);
+
+	sock_obj_core_update_send_stats(sock, bytes_sent);
+
+	return bytes_sent;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline ssize_t z_vrfy_zsock_sendmsg(int sock,
+					   const struct msghdr *msg,
+					   int flags)
+{
+	struct msghdr msg_copy;
+	int ret;
 
-		k_free(msg_copy.msg_iov);
+	ret = msghdr_copy_from_user(&msg_copy, msg);
+	K_OOPS(ret == -EFAULT);
+	if (ret < 0) {
+		return -1;
 	}
 
-	return -1;
+	ret = z_impl_zsock_sendmsg(sock, (const struct msghdr *)&msg_copy,
+				   flags);
+
+	msghdr_copy_free(&msg_copy, msg_copy.msg_iovlen);
+
+	return ret;
 }
 #include <zephyr/syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
@@ -545,7 +640,6 @@ ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 {
 	struct msghdr msg_copy;
 	size_t iovlen;
-	size_t i;
 	int ret;
 
 	if (msg == NULL) {
@@ -553,163 +647,311 @@ ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
 		return -1;
 	}
 
-	if (msg->msg_iov == NULL) {
-		errno = ENOMEM;
+	ret = msghdr_copy_from_user(&msg_copy, msg);
+	K_OOPS(ret == -EFAULT);
+	if (ret < 0) {
 		return -1;
 	}
 
-	K_OOPS(k_usermode_from_copy(&msg_copy, (void *)msg, sizeof(msg_copy)));
+	/* Note that we need to free according to original iovlen */
+	iovlen = msg_copy.msg_iovlen;
 
-	k_usermode_from_copy(&iovlen, &msg->msg_iovlen, sizeof(iovlen));
+	ret = z_impl_zsock_recvmsg(sock, &msg_copy, flags);
 
-	msg_copy.msg_name = NULL;
-	msg_copy.msg_control = NULL;
+	/* Do not copy anything back if there was an error or nothing was
+	 * received.
+	 */
+	if (ret > 0) {
+		msghdr_copy_to_user(msg, &msg_copy, iovlen);
+	}
 
-	msg_copy.msg_iov = k_usermode_alloc_from_copy(msg->msg_iov,
-				       msg->msg_iovlen * sizeof(struct iovec));
-	if (!msg_copy.msg_iov) {
-		errno = ENOMEM;
-		goto fail;
+	msghdr_copy_free(&msg_copy, iovlen);
+
+	return ret;
+}
+#include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	int bytes_sent = 0;
+	unsigned int i;
+	void *obj;
+	int ret = 0;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
 	}
 
-	/* Clear the pointers in the copy so that if the allocation in the
-	 * next loop fails, we do not try to free non allocated memory
-	 * in fail branch.
-	 */
-	memset(msg_copy.msg_iov, 0, msg->msg_iovlen * sizeof(struct iovec));
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
 
-	for (i = 0; i < iovlen; i++) {
-		/* TODO: In practice we do not need to copy the actual data
-		 * in msghdr when receiving data but currently there is no
-		 * ready made function to do just that (unless we want to call
-		 * relevant malloc function here ourselves). So just use
-		 * the copying variant for now.
-		 */
-		msg_copy.msg_iov[i].iov_base =
-			k_usermode_alloc_from_copy(msg->msg_iov[i].iov_base,
-						   msg->msg_iov[i].iov_len);
-		if (!msg_copy.msg_iov[i].iov_base) {
-			errno = ENOMEM;
-			goto fail;
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(socket, sendmsg, sock,
+						&msgvec[i].msg_hdr, flags);
+
+		ret = vtable->sendmsg(obj, &msgvec[i].msg_hdr, flags);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(socket, sendmsg, sock,
+					       ret < 0 ? -errno : ret);
+
+		if (ret < 0) {
+			break;
 		}
 
-		msg_copy.msg_iov[i].iov_len = msg->msg_iov[i].iov_len;
+		msgvec[i].msg_len = ret;
+		bytes_sent += ret;
 	}
 
-	if (msg->msg_namelen > 0) {
-		if (msg->msg_name == NULL) {
-			errno = EINVAL;
-			goto fail;
-		}
+	k_mutex_unlock(lock);
 
-		msg_copy.msg_name = k_usermode_alloc_from_copy(msg->msg_name,
-							   msg->msg_namelen);
-		if (msg_copy.msg_name == NULL) {
-			errno = ENOMEM;
-			goto fail;
-		}
+	sock_obj_core_update_send_stats(sock, bytes_sent);
+
+	/* An error is only reported if nothing was sent, like on Linux */
+	if (i == 0 && ret < 0) {
+		return -1;
 	}
 
-	if (msg->msg_controllen > 0) {
-		if (msg->msg_control == NULL) {
-			errno = EINVAL;
-			goto fail;
-		}
+	return i;
+}
 
-		msg_copy.msg_control =
-			k_usermode_alloc_from_copy(msg->msg_control,
-						   msg->msg_controllen);
-		if (msg_copy.msg_control == NULL) {
-			errno = ENOMEM;
-			goto fail;
-		}
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec, unsigned int vlen,
+			  int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	int bytes_received = 0;
+	unsigned int i;
+	void *obj;
+	int ret = 0;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
 	}
 
-	ret = z_impl_zsock_recvmsg(sock, &msg_copy, flags);
+	if (vtable->recvmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
 
-	/* Do not copy anything back if there was an error or nothing was
-	 * received.
-	 */
-	if (ret > 0) {
-		if (msg->msg_namelen > 0 && msg->msg_name != NULL) {
-			K_OOPS(k_usermode_to_copy(msg->msg_name,
-						  msg_copy.msg_name,
-						  msg_copy.msg_namelen));
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		int msg_flags = flags & ~ZSOCK_MSG_WAITFORONE;
+
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(socket, recvmsg, sock,
+						&msgvec[i].msg_hdr, msg_flags);
+
+		ret = vtable->recvmsg(obj, &msgvec[i].msg_hdr, msg_flags);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(socket, recvmsg, sock,
+					       &msgvec[i].msg_hdr,
+					       ret < 0 ? -errno : ret);
+
+		if (ret < 0) {
+			break;
 		}
 
-		if (msg->msg_controllen > 0 &&
-		    msg->msg_control != NULL) {
-			K_OOPS(k_usermode_to_copy(msg->msg_control,
-						  msg_copy.msg_control,
-						  msg_copy.msg_controllen));
+		msgvec[i].msg_len = ret;
+		bytes_received += ret;
 
-			msg->msg_controllen = msg_copy.msg_controllen;
-		} else {
-			msg->msg_controllen = 0U;
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
 		}
+	}
+
+	k_mutex_unlock(lock);
 
-		k_usermode_to_copy(&msg->msg_iovlen,
-				   &msg_copy.msg_iovlen,
-				   sizeof(msg->msg_iovlen));
-
-		/* The new iovlen cannot be bigger than the original one */
-		NET_ASSERT(msg_copy.msg_iovlen <= iovlen);
-
-		for (i = 0; i < iovlen; i++) {
-			if (i < msg_copy.msg_iovlen) {
-				K_OOPS(k_usermode_to_copy(msg->msg_iov[i].iov_base,
-							  msg_copy.msg_iov[i].iov_base,
-							  msg_copy.msg_iov[i].iov_len));
-				K_OOPS(k_usermode_to_copy(&msg->msg_iov[i].iov_len,
-							  &msg_copy.msg_iov[i].iov_len,
-							  sizeof(msg->msg_iov[i].iov_len)));
-			} else {
-				/* Clear out those vectors that we could not populate */
-				msg->msg_iov[i].iov_len = 0;
-			}
+	sock_obj_core_update_recv_stats(sock, bytes_received);
+
+	/* An error is only reported if nothing was received, like on Linux */
+	if (i == 0 && ret < 0) {
+		return -1;
+	}
+
+	return i;
+}
+
+#ifdef CONFIG_USERSPACE
+static void mmsghdr_copy_free(struct mmsghdr *msgvec_copy,
+			      const size_t *iovlens, unsigned int vlen)
+{
+	for (unsigned int i = 0; i < vlen; i++) {
+		msghdr_copy_free(&msgvec_copy[i].msg_hdr, iovlens[i]);
+	}
+
+	k_free(msgvec_copy);
+}
+
+/* Copy a message vector from user space with msghdr_copy_from_user(). The
+ * original number of vectors of each message is stored in @a iovlens,
+ * which shares the allocation of the returned copy.
+ */
+static struct mmsghdr *mmsghdr_copy_from_user(struct mmsghdr *msgvec,
+					      unsigned int vlen,
+					      size_t **iovlens)
+{
+	struct mmsghdr *msgvec_copy;
+	size_t size;
+
+	if (size_mul_overflow(vlen, sizeof(struct mmsghdr) + sizeof(size_t),
+			      &size)) {
+		errno = EINVAL;
+		return NULL;
+	}
+
+	msgvec_copy = k_malloc(size);
+	if (msgvec_copy == NULL) {
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	*iovlens = (size_t *)&msgvec_copy[vlen];
+
+	for (unsigned int i = 0; i < vlen; i++) {
+		int ret = msghdr_copy_from_user(&msgvec_copy[i].msg_hdr,
+						&msgvec[i].msg_hdr);
+
+		if (ret < 0) {
+			/* Release the messages already copied, also before
+			 * faulting the caller.
+			 */
+			mmsghdr_copy_free(msgvec_copy, *iovlens, i);
+			K_OOPS(ret == -EFAULT);
+			return NULL;
 		}
 
-		k_usermode_to_copy(&msg->msg_flags,
-				   &msg_copy.msg_flags,
-				   sizeof(msg->msg_flags));
+		(*iovlens)[i] = msgvec_copy[i].msg_hdr.msg_iovlen;
+		msgvec_copy[i].msg_len = 0U;
 	}
 
-	k_free(msg_copy.msg_name);
-	k_free(msg_copy.msg_control);
+	return msgvec_copy;
+}
 
-	/* Note that we need to free according to original iovlen */
-	for (i = 0; i < iovlen; i++) {
-		k_free(msg_copy.msg_iov[i].iov_base);
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct mmsghdr *msgvec_copy;
+	size_t *iovlens;
+	int ret;
+
+	if (vlen == 0U) {
+		return z_impl_zsock_sendmmsg(sock, NULL, 0U, flags);
 	}
 
-	k_free(msg_copy.msg_iov);
+	msgvec_copy = mmsghdr_copy_from_user(msgvec, vlen, &iovlens);
+	if (msgvec_copy == NULL) {
+		return -1;
+	}
+
+	ret = z_impl_zsock_sendmmsg(sock, msgvec_copy, vlen, flags);
+
+	for (int i = 0; i < ret; i++) {
+		K_OOPS(k_usermode_to_copy(&msgvec[i].msg_len,
+					  &msgvec_copy[i].msg_len,
+					  sizeof(msgvec[i].msg_len)));
+	}
+
+	mmsghdr_copy_free(msgvec_copy, iovlens, vlen);
 
 	return ret;
+}
+#include <zephyr/syscalls/zsock_sendmmsg_mrsh.c>
 
-fail:
-	if (msg_copy.msg_name) {
-		k_free(msg_copy.msg_name);
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct mmsghdr *msgvec_copy;
+	size_t *iovlens;
+	int ret;
+
+	if (vlen == 0U) {
+		return z_impl_zsock_recvmmsg(sock, NULL, 0U, flags);
 	}
 
-	if (msg_copy.msg_control) {
-		k_free(msg_copy.msg_control);
+	msgvec_copy = mmsghdr_copy_from_user(msgvec, vlen, &iovlens);
+	if (msgvec_copy == NULL) {
+		return -1;
 	}
 
-	if (msg_copy.msg_iov) {
-		for (i = 0; i < msg_copy.msg_iovlen; i++) {
-			if (msg_copy.msg_iov[i].iov_base) {
-				k_free(msg_copy.msg_iov[i].iov_base);
-			}
-		}
+	ret = z_impl_zsock_recvmmsg(sock, msgvec_copy, vlen, flags);
+
+	/* A zero length datagram still has its source address, flags and
+	 * control data to report.
+	 */
+	for (int i = 0; i < ret; i++) {
+		msghdr_copy_to_user(&msgvec[i].msg_hdr, &msgvec_copy[i].msg_hdr,
+				    iovlens[i]);
 
-		k_free(msg_copy.msg_iov);
+		K_OOPS(k_usermode_to_copy(&msgvec[i].msg_len,
+					  &msgvec_copy[i].msg_len,
+					  sizeof(msgvec[i].msg_len)));
 	}
 
-	return -1;
+	mmsghdr_copy_free(msgvec_copy, iovlens, vlen);
+
+	return ret;
 }
-#include <zephyr/syscalls/zsock_recvmsg_mrsh.c>
+#include <zephyr/syscalls/zsock_recvmmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#if defined(CONFIG_NET_SOCKETS_RECV_BUF)
+ssize_t zsock_recv_buf(int sock, struct net_buf **frags, int flags,
+		       struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	int bytes_received;
+
+	__ASSERT(!k_is_user_context(), "Not available from user mode");
+
+	if (frags == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	*frags = NULL;
+
+	bytes_received = VTABLE_CALL(recvbuf, sock, frags, flags, src_addr, addrlen);
+
+	sock_obj_core_update_recv_stats(sock, bytes_received);
+
+	return bytes_received;
+}
+
+void zsock_recv_buf_release(int sock, struct net_buf *frags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	size_t len;
+	void *obj;
+
+	if (frags == NULL) {
+		return;
+	}
+
+	len = net_buf_frags_len(frags);
+	net_buf_unref(frags);
+
+	/* Only now is there room for more data */
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if ((obj != NULL) && (vtable->recvbuf_done != NULL)) {
+		(void)k_mutex_lock(lock, K_FOREVER);
+		vtable->recvbuf_done(obj, len);
+		k_mutex_unlock(lock);
+	}
+}
+#endif /* CONFIG_NET_SOCKETS_RECV_BUF */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -75,6 +75,9 @@ struct socket_op_vtable {
 			   socklen_t *addrlen);
 	int (*getsockname)(void *obj, struct sockaddr *addr,
 			   socklen_t *addrlen);
+	ssize_t (*recvbuf)(void *obj, struct net_buf **frags, int flags,
+			   struct sockaddr *src_addr, socklen_t *addrlen);
+	void (*recvbuf_done)(void *obj, size_t len);
 };
 
 size_t msghdr_non_empty_iov_count(const struct msghdr *msg);
@@ -11,6 +11,8 @@
 #define RTIO_WORKQ_PRIO_HIGH		RTIO_WORKQ_PRIO_MED - 1
 #define RTIO_WORKQ_PRIO_LOW		RTIO_WORKQ_PRIO_MED + 1
 
+#define RTIO_WORKQ_IODEV_INFLIGHT	CONFIG_RTIO_WORKQ_IODEV_INFLIGHT
+
 K_P4WQ_DEFINE(rtio_workq,
 	      CONFIG_RTIO_WORKQ_THREADS_POOL,
 	      CONFIG_RTIO_WORKQ_STACK_SIZE);
@@ -20,16 +22,173 @@ K_MEM_SLAB_DEFINE_STATIC(rtio_work_items_slab,
 			 CONFIG_RTIO_WORKQ_POOL_ITEMS,
 			 4);
 
+#if defined(CONFIG_RTIO_WORKQ_FAIR) || (RTIO_WORKQ_IODEV_INFLIGHT > 0)
+static struct k_spinlock rtio_workq_lock;
+#endif
+
+#if RTIO_WORKQ_IODEV_INFLIGHT > 0
+/** Requests of an iodev handed to the threads, and those waiting for them. */
+struct rtio_work_iodev {
+	const struct rtio_iodev *iodev;
+	uint16_t inflight;
+	sys_slist_t waiting;
+};
+
+/** An iodev tracked here has at least one request allocated, so this never runs out. */
+static struct rtio_work_iodev rtio_work_iodevs[CONFIG_RTIO_WORKQ_POOL_ITEMS];
+
+static struct rtio_work_iodev *rtio_work_iodev_get(const struct rtio_iodev *iodev)
+{
+	struct rtio_work_iodev *unused = NULL;
+
+	for (size_t i = 0; i < ARRAY_SIZE(rtio_work_iodevs); i++) {
+		if (rtio_work_iodevs[i].iodev == iodev) {
+			return &rtio_work_iodevs[i];
+		}
+		if (unused == NULL && rtio_work_iodevs[i].iodev == NULL) {
+			unused = &rtio_work_iodevs[i];
+		}
+	}
+
+	__ASSERT_NO_MSG(unused != NULL);
+
+	unused->iodev = iodev;
+	unused->inflight = 0;
+	sys_slist_init(&unused->waiting);
+
+	return unused;
+}
+
+/**
+ * Account for the request in its iodev. Returns false if the iodev has as many requests as
+ * allowed in the threads' hands, in which case the request is queued behind those of the
+ * same or higher priority.
+ */
+static bool rtio_work_iodev_acquire(struct rtio_work_req *req)
+{
+	k_spinlock_key_t key;
+	struct rtio_work_iodev *iodev;
+	struct rtio_work_req *waiting;
+	struct rtio_work_req *prev = NULL;
+
+	if (req->iodev_sqe->sqe.iodev == NULL) {
+		req->iodev = NULL;
+		return true;
+	}
+
+	key = k_spin_lock(&rtio_workq_lock);
+	iodev = rtio_work_iodev_get(req->iodev_sqe->sqe.iodev);
+	req->iodev = iodev;
+
+	if (iodev->inflight < RTIO_WORKQ_IODEV_INFLIGHT) {
+		iodev->inflight++;
+		k_spin_unlock(&rtio_workq_lock, key);
+		return true;
+	}
+
+	/** A higher priority is a lower number, as for threads. */
+	SYS_SLIST_FOR_EACH_CONTAINER(&iodev->waiting, waiting, node) {
+		if (waiting->work.priority > req->work.priority) {
+			break;
+		}
+		prev = waiting;
+	}
+	sys_slist_insert(&iodev->waiting, prev ? &prev->node : NULL, &req->node);
+
+	k_spin_unlock(&rtio_workq_lock, key);
+
+	return false;
+}
+
+/** Returns the next request of the iodev to hand to the threads, if any. */
+static struct rtio_work_req *rtio_work_iodev_release(struct rtio_work_iodev *iodev)
+{
+	k_spinlock_key_t key = k_spin_lock(&rtio_workq_lock);
+	sys_snode_t *node = sys_slist_get(&iodev->waiting);
+
+	if (node == NULL && --iodev->inflight == 0) {
+		iodev->iodev = NULL;
+	}
+
+	k_spin_unlock(&rtio_workq_lock, key);
+
+	return node ? CONTAINER_OF(node, struct rtio_work_req, node) : NULL;
+}
+#endif /* RTIO_WORKQ_IODEV_INFLIGHT > 0 */
+
+#ifdef CONFIG_RTIO_WORKQ_FAIR
+/**
+ * Deadline of the next request of a context: one quantum after the one of its previous
+ * request, or now if later, so that the contexts with requests queued get the threads in
+ * turn. A deadline further away than the pool allows for is stale and starts over.
+ */
+static int32_t rtio_work_deadline(struct rtio *r)
+{
+	const uint32_t quantum = k_us_to_cyc_ceil32(CONFIG_RTIO_WORKQ_FAIR_QUANTUM_US);
+	k_spinlock_key_t key;
+	uint32_t now;
+	int32_t deadline;
+
+	if (r == NULL) {
+		return 0;
+	}
+
+	key = k_spin_lock(&rtio_workq_lock);
+	now = k_cycle_get_32();
+
+	deadline = (int32_t)(r->workq_tag + quantum - now);
+	if (deadline < 0 || deadline > (int32_t)(quantum * CONFIG_RTIO_WORKQ_POOL_ITEMS)) {
+		deadline = 0;
+	}
+	r->workq_tag = now + deadline;
+
+	k_spin_unlock(&rtio_workq_lock, key);
+
+	return deadline;
+}
+#endif /* CONFIG_RTIO_WORKQ_FAIR */
+
+static void rtio_work_dispatch(struct rtio_work_req *req)
+{
+#ifdef CONFIG_RTIO_WORKQ_FAIR
+	req->work.deadline = rtio_work_deadline(req->iodev_sqe->r);
+#else
+	req->work.deadline = 0;
+#endif
+
+	/** Decoupling action: Let the P4WQ execute the action. */
+	k_p4wq_submit(&rtio_workq, &req->work);
+}
+
 static void rtio_work_handler(struct k_p4wq_work *work)
 {
 	struct rtio_work_req *req = CONTAINER_OF(work,
 						 struct rtio_work_req,
 						 work);
 	struct rtio_iodev_sqe *iodev_sqe = req->iodev_sqe;
+#if RTIO_WORKQ_IODEV_INFLIGHT > 0
+	/** The handler completes the SQE, which may then be reused: keep the iodev first. */
+	struct rtio_work_iodev *iodev = req->iodev;
+	struct rtio_work_req *next;
+#endif
 
 	req->handler(iodev_sqe);
 
+#if RTIO_WORKQ_IODEV_INFLIGHT > 0
+	/**
+	 * Release the iodev while the request is still allocated, so that the table, sized for
+	 * the pool, always has an entry for the iodev of a newly allocated request.
+	 */
+	next = iodev ? rtio_work_iodev_release(iodev) : NULL;
+#endif
+
 	k_mem_slab_free(&rtio_work_items_slab, req);
+
+#if RTIO_WORKQ_IODEV_INFLIGHT > 0
+	if (next != NULL) {
+		rtio_work_dispatch(next);
+	}
+#endif
 }
 
 struct rtio_work_req *rtio_work_req_alloc(void)
@@ -74,7 +233,6 @@ void rtio_work_req_submit(struct rtio_work_req *req,
 
 	/** Set the required information to handle the action */
 	work->handler = rtio_work_handler;
-	work->deadline = 0;
 
 	if (sqe->prio == RTIO_PRIO_LOW) {
 		work->priority = RTIO_WORKQ_PRIO_LOW;
@@ -84,8 +242,14 @@ void rtio_work_req_submit(struct rtio_work_req *req,
 		work->priority = RTIO_WORKQ_PRIO_MED;
 	}
 
-	/** Decoupling action: Let the P4WQ execute the action. */
-	k_p4wq_submit(&rtio_workq, work);
+#if RTIO_WORKQ_IODEV_INFLIGHT > 0
+	if (!rtio_work_iodev_acquire(req)) {
+		/** Handed to the threads once a request of the same iodev completes. */
+		return;
+	}
+#endif
+
+	rtio_work_dispatch(req);
 }
 
 uint32_t rtio_work_req_used_count_get(void)
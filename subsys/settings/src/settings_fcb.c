@@ -32,11 +32,19 @@ static int settings_fcb_load(struct settings_store *cs,
 static int settings_fcb_save(struct settings_store *cs, const char *name,
 			     const char *value, size_t val_len);
 static void *settings_fcb_storage_get(struct settings_store *cs);
+#if defined(CONFIG_SETTINGS_WRITE_BACK)
+static int settings_fcb_lock(struct settings_store *cs, k_timeout_t timeout);
+static void settings_fcb_unlock(struct settings_store *cs);
+#endif
 
 static const struct settings_store_itf settings_fcb_itf = {
 	.csi_load = settings_fcb_load,
 	.csi_save = settings_fcb_save,
-	.csi_storage_get = settings_fcb_storage_get
+	.csi_storage_get = settings_fcb_storage_get,
+#if defined(CONFIG_SETTINGS_WRITE_BACK)
+	.csi_lock = settings_fcb_lock,
+	.csi_unlock = settings_fcb_unlock,
+#endif
 };
 
 /**
@@ -453,3 +461,27 @@ static void *settings_fcb_storage_get(struct settings_store *cs)
 
 	return &cf->cf_fcb;
 }
+
+#if defined(CONFIG_SETTINGS_WRITE_BACK)
+/* The FCB lock is a mutex, so the appends and rotations done while holding
+ * it take it again without waiting.
+ */
+static int settings_fcb_lock(struct settings_store *cs, k_timeout_t timeout)
+{
+	struct settings_fcb *cf = CONTAINER_OF(cs, struct settings_fcb, cf_store);
+
+	/* The mutex is recursive, its owner may be in the middle of a write */
+	if (cf->cf_fcb.f_mtx.owner == k_current_get()) {
+		return -EBUSY;
+	}
+
+	return k_mutex_lock(&cf->cf_fcb.f_mtx, timeout);
+}
+
+static void settings_fcb_unlock(struct settings_store *cs)
+{
+	struct settings_fcb *cf = CONTAINER_OF(cs, struct settings_fcb, cf_store);
+
+	k_mutex_unlock(&cf->cf_fcb.f_mtx);
+}
+#endif /* CONFIG_SETTINGS_WRITE_BACK */
@@ -33,13 +33,126 @@ static int settings_nvs_load(struct settings_store *cs,
 static int settings_nvs_save(struct settings_store *cs, const char *name,
 			     const char *value, size_t val_len);
 static void *settings_nvs_storage_get(struct settings_store *cs);
+#if defined(CONFIG_SETTINGS_WRITE_BACK)
+static int settings_nvs_lock(struct settings_store *cs, k_timeout_t timeout);
+static void settings_nvs_unlock(struct settings_store *cs);
+#endif
 
 static struct settings_store_itf settings_nvs_itf = {
 	.csi_load = settings_nvs_load,
 	.csi_save = settings_nvs_save,
-	.csi_storage_get = settings_nvs_storage_get
+	.csi_storage_get = settings_nvs_storage_get,
+#if defined(CONFIG_SETTINGS_WRITE_BACK)
+	.csi_lock = settings_nvs_lock,
+	.csi_unlock = settings_nvs_unlock,
+#endif
 };
 
+#if CONFIG_SETTINGS_NVS_LOAD_INDEX
+/* Index slot values other than NVS addresses */
+#define SETTINGS_NVS_INDEX_UNKNOWN UINT32_MAX
+#define SETTINGS_NVS_INDEX_DELETED (UINT32_MAX - 1)
+
+struct settings_nvs_index {
+	struct nvs_fs *fs;
+	/* Write position of NVS when the index was built */
+	uint32_t ate_wra;
+	uint16_t last_name_id;
+	bool valid;
+	struct {
+		uint32_t name;
+		uint32_t value;
+	} entry[CONFIG_SETTINGS_NVS_LOAD_INDEX_SIZE];
+};
+
+/* Only used while loading, which is done under the settings lock */
+static struct settings_nvs_index settings_nvs_index;
+
+static uint32_t *settings_nvs_index_slot(struct settings_nvs_index *index, uint16_t id)
+{
+	if ((id > NVS_NAMECNT_ID) && (id <= index->last_name_id)) {
+		return &index->entry[id - NVS_NAMECNT_ID - 1].name;
+	}
+
+	if ((id > NVS_NAMECNT_ID + NVS_NAME_ID_OFFSET) &&
+	    (id <= index->last_name_id + NVS_NAME_ID_OFFSET)) {
+		return &index->entry[id - NVS_NAMECNT_ID - NVS_NAME_ID_OFFSET - 1].value;
+	}
+
+	return NULL;
+}
+
+static int settings_nvs_index_add(uint16_t id, size_t len, uint32_t addr, void *arg)
+{
+	uint32_t *slot = settings_nvs_index_slot(arg, id);
+
+	/* Entries come newest first, older ones are stale */
+	if ((slot != NULL) && (*slot == SETTINGS_NVS_INDEX_UNKNOWN)) {
+		*slot = (len > 0) ? addr : SETTINGS_NVS_INDEX_DELETED;
+	}
+
+	return 0;
+}
+
+static void settings_nvs_index_build(struct settings_nvs *cf)
+{
+	struct settings_nvs_index *index = &settings_nvs_index;
+	uint16_t count = cf->last_name_id - NVS_NAMECNT_ID;
+
+	index->valid = false;
+
+	if (count > CONFIG_SETTINGS_NVS_LOAD_INDEX_SIZE) {
+		LOG_DBG("%u settings do not fit the load index", count);
+		return;
+	}
+
+	index->fs = &cf->cf_nvs;
+	index->last_name_id = cf->last_name_id;
+	memset(index->entry, 0xff, count * sizeof(index->entry[0]));
+
+	if (nvs_walk(&cf->cf_nvs, settings_nvs_index_add, index) == 0) {
+		index->ate_wra = cf->cf_nvs.ate_wra;
+		index->valid = true;
+	}
+}
+
+static uint32_t settings_nvs_index_lookup(struct nvs_fs *fs, uint16_t id)
+{
+	struct settings_nvs_index *index = &settings_nvs_index;
+	uint32_t *slot;
+
+	/* Any write to NVS may have moved the entries */
+	if (!index->valid || (index->fs != fs) || (index->ate_wra != fs->ate_wra)) {
+		return SETTINGS_NVS_INDEX_UNKNOWN;
+	}
+
+	slot = settings_nvs_index_slot(index, id);
+	if (slot == NULL) {
+		return SETTINGS_NVS_INDEX_UNKNOWN;
+	}
+
+	/* Not found by the walk, so not in NVS */
+	return (*slot == SETTINGS_NVS_INDEX_UNKNOWN) ? SETTINGS_NVS_INDEX_DELETED : *slot;
+}
+#endif /* CONFIG_SETTINGS_NVS_LOAD_INDEX */
+
+static ssize_t settings_nvs_read(struct nvs_fs *fs, uint16_t id, void *data, size_t len)
+{
+#if CONFIG_SETTINGS_NVS_LOAD_INDEX
+	uint32_t addr = settings_nvs_index_lookup(fs, id);
+
+	if (addr == SETTINGS_NVS_INDEX_DELETED) {
+		return -ENOENT;
+	}
+
+	if (addr != SETTINGS_NVS_INDEX_UNKNOWN) {
+		return nvs_read_addr(fs, id, addr, data, len);
+	}
+#endif
+
+	return nvs_read(fs, id, data, len);
+}
+
 static ssize_t settings_nvs_read_fn(void *back_end, void *data, size_t len)
 {
 	struct settings_nvs_read_fn_arg *rd_fn_arg;
@@ -47,7 +160,7 @@ static ssize_t settings_nvs_read_fn(void *back_end, void *data, size_t len)
 
 	rd_fn_arg = (struct settings_nvs_read_fn_arg *)back_end;
 
-	rc = nvs_read(rd_fn_arg->fs, rd_fn_arg->id, data, len);
+	rc = settings_nvs_read(rd_fn_arg->fs, rd_fn_arg->id, data, len);
 	if (rc > (ssize_t)len) {
 		/* nvs_read signals that not all bytes were read
 		 * align read len to what was requested
@@ -137,6 +250,10 @@ static int settings_nvs_load(struct settings_store *cs,
 	cf->loaded = false;
 #endif
 
+#if CONFIG_SETTINGS_NVS_LOAD_INDEX
+	settings_nvs_index_build(cf);
+#endif
+
 	name_id = cf->last_name_id + 1;
 
 	while (1) {
@@ -154,9 +271,9 @@ static int settings_nvs_load(struct settings_store *cs,
 		 * entries one for the setting's name and one with the
 		 * setting's value.
 		 */
-		rc1 = nvs_read(&cf->cf_nvs, name_id, &name, sizeof(name));
-		rc2 = nvs_read(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET,
-			       &buf, sizeof(buf));
+		rc1 = settings_nvs_read(&cf->cf_nvs, name_id, &name, sizeof(name));
+		rc2 = settings_nvs_read(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET,
+					&buf, sizeof(buf));
 
 		if ((rc1 <= 0) && (rc2 <= 0)) {
 			/* Settings largest ID in use is invalid due to
@@ -209,6 +326,11 @@ static int settings_nvs_load(struct settings_store *cs,
 			break;
 		}
 	}
+
+#if CONFIG_SETTINGS_NVS_LOAD_INDEX
+	settings_nvs_index.valid = false;
+#endif
+
 	return ret;
 }
 
@@ -446,3 +568,27 @@ static void *settings_nvs_storage_get(struct settings_store *cs)
 
 	return &cf->cf_nvs;
 }
+
+#if defined(CONFIG_SETTINGS_WRITE_BACK)
+/* The NVS lock is a mutex, so the writes done while holding it take it
+ * again without waiting.
+ */
+static int settings_nvs_lock(struct settings_store *cs, k_timeout_t timeout)
+{
+	struct settings_nvs *cf = CONTAINER_OF(cs, struct settings_nvs, cf_store);
+
+	/* The mutex is recursive, its owner may be in the middle of a write */
+	if (cf->cf_nvs.nvs_lock.owner == k_current_get()) {
+		return -EBUSY;
+	}
+
+	return k_mutex_lock(&cf->cf_nvs.nvs_lock, timeout);
+}
+
+static void settings_nvs_unlock(struct settings_store *cs)
+{
+	struct settings_nvs *cf = CONTAINER_OF(cs, struct settings_nvs, cf_store);
+
+	k_mutex_unlock(&cf->cf_nvs.nvs_lock);
+}
+#endif /* CONFIG_SETTINGS_WRITE_BACK */
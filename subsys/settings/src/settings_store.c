@@ -15,6 +15,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/settings/settings.h>
+#include <zephyr/sys/panic_flush.h>
 #include "settings_priv.h"
 
 #include <zephyr/logging/log.h>
@@ -34,6 +35,257 @@ void settings_dst_register(struct settings_store *cs)
 	settings_save_dst = cs;
 }
 
+#if defined(CONFIG_SETTINGS_WRITE_BACK)
+/* Pending saves follow each other in the buffer, oldest first, each one as
+ * a header followed by the name with its terminating '\0' and the value.
+ * A value length of 0 stands for a delete.
+ */
+struct settings_wb_hdr {
+	uint16_t name_len;
+	uint16_t val_len;
+};
+
+static uint8_t settings_wb_buf[CONFIG_SETTINGS_WRITE_BACK_SIZE];
+static size_t settings_wb_used;
+static uint32_t settings_wb_batch_depth;
+static struct settings_write_back_stats settings_wb_stats;
+
+static void settings_wb_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(settings_wb_work, settings_wb_work_handler);
+
+static size_t settings_wb_rec_len(const struct settings_wb_hdr *hdr)
+{
+	return sizeof(*hdr) + hdr->name_len + hdr->val_len;
+}
+
+static void settings_wb_remove(size_t off, size_t len)
+{
+	memmove(&settings_wb_buf[off], &settings_wb_buf[off + len],
+		settings_wb_used - off - len);
+	settings_wb_used -= len;
+}
+
+/* Drop the pending save of name, returns true if there was one */
+static bool settings_wb_drop(const char *name, size_t name_len)
+{
+	struct settings_wb_hdr hdr;
+
+	for (size_t off = 0; off < settings_wb_used; off += settings_wb_rec_len(&hdr)) {
+		memcpy(&hdr, &settings_wb_buf[off], sizeof(hdr));
+
+		if ((hdr.name_len == name_len) &&
+		    (memcmp(&settings_wb_buf[off + sizeof(hdr)], name, name_len) == 0)) {
+			settings_wb_remove(off, settings_wb_rec_len(&hdr));
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Write the pending saves in order, those which fail and the following ones
+ * stay pending.
+ */
+static int settings_wb_flush(struct settings_store *cs)
+{
+	struct settings_wb_hdr hdr;
+	size_t off;
+	int rc = 0;
+
+	if (settings_wb_used == 0) {
+		return 0;
+	}
+
+	(void)k_work_cancel_delayable(&settings_wb_work);
+	settings_wb_stats.flushes++;
+
+	for (off = 0; off < settings_wb_used; off += settings_wb_rec_len(&hdr)) {
+		const char *name;
+
+		memcpy(&hdr, &settings_wb_buf[off], sizeof(hdr));
+		name = (const char *)&settings_wb_buf[off + sizeof(hdr)];
+
+		rc = cs->cs_itf->csi_save(cs, name,
+					  (hdr.val_len > 0) ? (name + hdr.name_len) : NULL,
+					  hdr.val_len);
+		if (rc != 0) {
+			LOG_ERR("Failed to write %s (%d)", name, rc);
+			break;
+		}
+
+		settings_wb_stats.writes++;
+	}
+
+	settings_wb_remove(0, off);
+
+	return rc;
+}
+
+static int settings_wb_save(struct settings_store *cs, const char *name,
+			    const char *value, size_t val_len)
+{
+	struct settings_wb_hdr hdr;
+	size_t rec_len;
+	int rc;
+
+	if (!name) {
+		return -EINVAL;
+	}
+
+	settings_wb_stats.saves++;
+
+	hdr.name_len = strlen(name) + 1;
+	hdr.val_len = (value != NULL) ? val_len : 0;
+	rec_len = sizeof(hdr) + hdr.name_len + ((value != NULL) ? val_len : 0);
+
+	if (settings_wb_drop(name, hdr.name_len)) {
+		settings_wb_stats.merged++;
+	}
+
+	if (rec_len > sizeof(settings_wb_buf)) {
+		/* Too large to be cached, written directly */
+		rc = cs->cs_itf->csi_save(cs, name, value, val_len);
+		if (rc == 0) {
+			settings_wb_stats.writes++;
+		}
+
+		return rc;
+	}
+
+	if (rec_len > (sizeof(settings_wb_buf) - settings_wb_used)) {
+		rc = settings_wb_flush(cs);
+		if (rc != 0) {
+			return rc;
+		}
+	}
+
+	memcpy(&settings_wb_buf[settings_wb_used], &hdr, sizeof(hdr));
+	memcpy(&settings_wb_buf[settings_wb_used + sizeof(hdr)], name, hdr.name_len);
+	if (hdr.val_len > 0) {
+		memcpy(&settings_wb_buf[settings_wb_used + sizeof(hdr) + hdr.name_len], value,
+		       hdr.val_len);
+	}
+	settings_wb_used += rec_len;
+
+	/* Scheduling again keeps the earlier deadline */
+	if ((settings_wb_batch_depth == 0) && (CONFIG_SETTINGS_WRITE_BACK_DELAY_MS > 0)) {
+		(void)k_work_schedule(&settings_wb_work, K_MSEC(CONFIG_SETTINGS_WRITE_BACK_DELAY_MS));
+	}
+
+	return 0;
+}
+
+static void settings_wb_work_handler(struct k_work *work)
+{
+	int rc;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	/* The end of the batch writes the saves */
+	if ((settings_wb_batch_depth > 0) || (settings_save_dst == NULL)) {
+		k_mutex_unlock(&settings_lock);
+		return;
+	}
+
+	rc = settings_wb_flush(settings_save_dst);
+	if (rc != 0) {
+		(void)k_work_schedule(&settings_wb_work, K_MSEC(CONFIG_SETTINGS_WRITE_BACK_DELAY_MS));
+	}
+
+	k_mutex_unlock(&settings_lock);
+}
+
+int settings_save_batch_begin(void)
+{
+	k_mutex_lock(&settings_lock, K_FOREVER);
+	settings_wb_batch_depth++;
+	k_mutex_unlock(&settings_lock);
+
+	return 0;
+}
+
+int settings_save_batch_commit(void)
+{
+	int rc = 0;
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	if (settings_wb_batch_depth == 0) {
+		rc = -EINVAL;
+	} else if ((--settings_wb_batch_depth == 0) && (settings_save_dst != NULL)) {
+		rc = settings_wb_flush(settings_save_dst);
+	}
+
+	k_mutex_unlock(&settings_lock);
+
+	return rc;
+}
+
+int settings_flush(void)
+{
+	int rc;
+
+	if (!settings_save_dst) {
+		return -ENOENT;
+	}
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+	rc = settings_wb_flush(settings_save_dst);
+	k_mutex_unlock(&settings_lock);
+
+	return rc;
+}
+
+/* Write the pending saves from log_panic() or sys_reboot(). Nothing is
+ * written from an ISR, or when the settings or the storage of the backend
+ * are still in use after timeout, as waiting for them longer could hang the
+ * system. The settings lock is recursive, so a thread interrupted in the
+ * middle of a save or a flush must not be let in again.
+ */
+static void settings_wb_panic_flush(struct sys_panic_flush *hook, k_timeout_t timeout)
+{
+	struct settings_store *cs = settings_save_dst;
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+
+	ARG_UNUSED(hook);
+
+	if ((settings_wb_used == 0) || (cs == NULL)) {
+		return;
+	}
+
+	if (k_is_in_isr() || (cs->cs_itf->csi_lock == NULL) ||
+	    (settings_lock.owner == k_current_get()) ||
+	    (k_mutex_lock(&settings_lock, timeout) != 0)) {
+		LOG_WRN("Settings busy, %zu bytes of pending saves dropped", settings_wb_used);
+		return;
+	}
+
+	if (cs->cs_itf->csi_lock(cs, sys_timepoint_timeout(end)) == 0) {
+		(void)settings_wb_flush(cs);
+		cs->cs_itf->csi_unlock(cs);
+	} else {
+		LOG_WRN("Storage busy, %zu bytes of pending saves dropped", settings_wb_used);
+	}
+
+	k_mutex_unlock(&settings_lock);
+}
+
+static struct sys_panic_flush settings_wb_panic_hook = {
+	.flush = settings_wb_panic_flush,
+};
+
+int settings_write_back_stats_get(struct settings_write_back_stats *stats)
+{
+	k_mutex_lock(&settings_lock, K_FOREVER);
+	*stats = settings_wb_stats;
+	k_mutex_unlock(&settings_lock);
+
+	return 0;
+}
+#endif /* CONFIG_SETTINGS_WRITE_BACK */
+
 int settings_load(void)
 {
 	return settings_load_subtree(NULL);
@@ -54,6 +306,12 @@ int settings_load_subtree(const char *subtree)
 	 *    commit all
 	 */
 	k_mutex_lock(&settings_lock, K_FOREVER);
+#if defined(CONFIG_SETTINGS_WRITE_BACK)
+	/* Loading must see the pending saves */
+	if (settings_save_dst) {
+		(void)settings_wb_flush(settings_save_dst);
+	}
+#endif
 	SYS_SLIST_FOR_EACH_CONTAINER(&settings_load_srcs, cs, cs_next) {
 		cs->cs_itf->csi_load(cs, &arg);
 	}
@@ -81,6 +339,12 @@ int settings_load_subtree_direct(
 	 *    commit all
 	 */
 	k_mutex_lock(&settings_lock, K_FOREVER);
+#if defined(CONFIG_SETTINGS_WRITE_BACK)
+	/* Loading must see the pending saves */
+	if (settings_save_dst) {
+		(void)settings_wb_flush(settings_save_dst);
+	}
+#endif
 	SYS_SLIST_FOR_EACH_CONTAINER(&settings_load_srcs, cs, cs_next) {
 		cs->cs_itf->csi_load(cs, &arg);
 	}
@@ -103,7 +367,11 @@ int settings_save_one(const char *name, const void *value, size_t val_len)
 
 	k_mutex_lock(&settings_lock, K_FOREVER);
 
+#if defined(CONFIG_SETTINGS_WRITE_BACK)
+	rc = settings_wb_save(cs, name, (char *)value, val_len);
+#else
 	rc = cs->cs_itf->csi_save(cs, name, (char *)value, val_len);
+#endif
 
 	k_mutex_unlock(&settings_lock);
 
@@ -136,6 +404,11 @@ int settings_save_subtree(const char *subtree)
 	}
 	rc = 0;
 
+#if defined(CONFIG_SETTINGS_WRITE_BACK)
+	/* The exported values reach the back-end before csi_save_end */
+	(void)settings_save_batch_begin();
+#endif
+
 	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
 		if (subtree && !settings_name_steq(ch->name, subtree, NULL)) {
 			continue;
@@ -163,6 +436,13 @@ int settings_save_subtree(const char *subtree)
 	}
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
 
+#if defined(CONFIG_SETTINGS_WRITE_BACK)
+	rc2 = settings_save_batch_commit();
+	if (!rc) {
+		rc = rc2;
+	}
+#endif
+
 	if (cs->cs_itf->csi_save_end) {
 		cs->cs_itf->csi_save_end(cs);
 	}
@@ -187,4 +467,14 @@ int settings_storage_get(void **storage)
 void settings_store_init(void)
 {
 	sys_slist_init(&settings_load_srcs);
+
+#if defined(CONFIG_SETTINGS_WRITE_BACK)
+	static bool panic_hook_registered;
+
+	/* Called again when the backend failed to initialize */
+	if (!panic_hook_registered) {
+		sys_panic_flush_register(&settings_wb_panic_hook);
+		panic_hook_registered = true;
+	}
+#endif /* CONFIG_SETTINGS_WRITE_BACK */
 }
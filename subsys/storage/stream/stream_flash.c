@@ -39,6 +39,9 @@ static int settings_direct_loader(const char *key, size_t len,
 		/* Check that loaded progress is not outdated. */
 		if (bytes_written >= ctx->bytes_written) {
 			ctx->bytes_written = bytes_written;
+#ifdef CONFIG_STREAM_FLASH_WRITE_BEHIND
+			ctx->wb_queued = bytes_written;
+#endif
 		} else {
 			LOG_WRN("Loaded outdated bytes_written %zu < %zu",
 				bytes_written, ctx->bytes_written);
@@ -122,7 +125,9 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 
 #endif /* CONFIG_STREAM_FLASH_ERASE */
 
-static int flash_sync(struct stream_flash_ctx *ctx)
+/* Write buf_bytes bytes of buf at the end of the data written so far */
+static int flash_sync_buf(struct stream_flash_ctx *ctx, uint8_t *buf,
+			  size_t buf_bytes)
 {
 	int rc = 0;
 	size_t write_addr = ctx->offset + ctx->bytes_written;
@@ -131,14 +136,14 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	uint8_t filler;
 
 
-	if (ctx->buf_bytes == 0) {
+	if (buf_bytes == 0) {
 		return 0;
 	}
 
 	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE)) {
 
 		rc = stream_flash_erase_page(ctx,
-					     write_addr + ctx->buf_bytes - 1);
+					     write_addr + buf_bytes - 1);
 		if (rc < 0) {
 			LOG_ERR("stream_flash_erase_page err %d offset=0x%08zx",
 				rc, write_addr);
@@ -147,17 +152,17 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	}
 
 	fill_length = ctx->write_block_size;
-	if (ctx->buf_bytes % fill_length) {
-		fill_length -= ctx->buf_bytes % fill_length;
+	if (buf_bytes % fill_length) {
+		fill_length -= buf_bytes % fill_length;
 		filler = ctx->erase_value;
 
-		memset(ctx->buf + ctx->buf_bytes, filler, fill_length);
+		memset(buf + buf_bytes, filler, fill_length);
 	} else {
 		fill_length = 0;
 	}
 
-	buf_bytes_aligned = ctx->buf_bytes + fill_length;
-	rc = flash_write(ctx->fdev, write_addr, ctx->buf, buf_bytes_aligned);
+	buf_bytes_aligned = buf_bytes + fill_length;
+	rc = flash_write(ctx->fdev, write_addr, buf, buf_bytes_aligned);
 
 	if (rc != 0) {
 		LOG_ERR("flash_write error %d offset=0x%08zx", rc,
@@ -171,18 +176,17 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 		/* Invert to ensure that caller is able to discover a faulty
 		 * flash_read() even if no error code is returned.
 		 */
-		for (int i = 0; i < ctx->buf_bytes; i++) {
-			ctx->buf[i] = ~ctx->buf[i];
+		for (int i = 0; i < buf_bytes; i++) {
+			buf[i] = ~buf[i];
 		}
 
-		rc = flash_read(ctx->fdev, write_addr, ctx->buf,
-				ctx->buf_bytes);
+		rc = flash_read(ctx->fdev, write_addr, buf, buf_bytes);
 		if (rc != 0) {
 			LOG_ERR("flash read failed: %d", rc);
 			return rc;
 		}
 
-		rc = ctx->callback(ctx->buf, ctx->buf_bytes, write_addr);
+		rc = ctx->callback(buf, buf_bytes, write_addr);
 		if (rc != 0) {
 			LOG_ERR("callback failed: %d", rc);
 			return rc;
@@ -191,30 +195,223 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 
 #endif
 
-	ctx->bytes_written += ctx->buf_bytes;
-	ctx->buf_bytes = 0U;
+	ctx->bytes_written += buf_bytes;
 
 	return rc;
 }
 
+#ifdef CONFIG_STREAM_FLASH_WRITE_BEHIND
+
+static K_THREAD_STACK_DEFINE(stream_flash_wb_stack,
+			     CONFIG_STREAM_FLASH_WRITE_BEHIND_STACK_SIZE);
+static struct k_work_q stream_flash_wb_queue;
+
+static inline uint8_t *wb_buf(const struct stream_flash_ctx *ctx, uint8_t idx)
+{
+	return (idx == 0U) ? ctx->buf : (ctx->wb_bufs + (idx - 1U) * ctx->buf_len);
+}
+
+/* Buffer being filled by stream_flash_buffered_write() */
+static inline uint8_t *fill_buf(const struct stream_flash_ctx *ctx)
+{
+	return (ctx->wb_count != 0U) ? wb_buf(ctx, ctx->wb_fill) : ctx->buf;
+}
+
+static void wb_work_handler(struct k_work *work)
+{
+	struct stream_flash_ctx *ctx = CONTAINER_OF(work, struct stream_flash_ctx, wb_work);
+	int rc;
+
+	/* Buffers are written in the order they were filled, all of them full */
+	while (atomic_get(&ctx->wb_pending) > 0) {
+		if (ctx->wb_err == 0) {
+			rc = flash_sync_buf(ctx, wb_buf(ctx, ctx->wb_write), ctx->buf_len);
+			if (rc != 0) {
+				ctx->wb_err = rc;
+			}
+		}
+
+		ctx->wb_write = (ctx->wb_write + 1U) % ctx->wb_count;
+		(void)atomic_dec(&ctx->wb_pending);
+		k_sem_give(&ctx->wb_free);
+	}
+
+#ifdef CONFIG_STREAM_FLASH_ERASE
+	/* Erase the page of the next buffer while it is being filled */
+	if ((ctx->wb_err == 0) && ((ctx->bytes_written + ctx->buf_len) <= ctx->available)) {
+		rc = stream_flash_erase_page(ctx, ctx->offset + ctx->bytes_written +
+						  ctx->buf_len - 1);
+		if (rc < 0) {
+			ctx->wb_err = rc;
+		}
+	}
+#endif
+}
+
+/* Hand the full fill buffer to the work queue and move to the next one */
+static int wb_queue(struct stream_flash_ctx *ctx)
+{
+	ctx->wb_queued += ctx->buf_bytes;
+	ctx->buf_bytes = 0U;
+
+	(void)atomic_inc(&ctx->wb_pending);
+	(void)k_work_submit_to_queue(&stream_flash_wb_queue, &ctx->wb_work);
+
+	(void)k_sem_take(&ctx->wb_free, K_FOREVER);
+	ctx->wb_fill = (ctx->wb_fill + 1U) % ctx->wb_count;
+
+	return ctx->wb_err;
+}
+
+/* Wait for all full buffers to be written */
+static int wb_wait(struct stream_flash_ctx *ctx)
+{
+	struct k_work_sync sync;
+
+	(void)k_work_flush(&ctx->wb_work, &sync);
+
+	return ctx->wb_err;
+}
+
+int stream_flash_write_behind_stop(struct stream_flash_ctx *ctx)
+{
+	struct k_work_sync sync;
+
+	if (!ctx) {
+		return -EFAULT;
+	}
+
+	if (ctx->wb_count == 0U) {
+		return 0;
+	}
+
+	/* Have the work item skip the full buffers it did not start on */
+	ctx->wb_err = -ECANCELED;
+	(void)k_work_cancel_sync(&ctx->wb_work, &sync);
+	atomic_set(&ctx->wb_pending, 0);
+	ctx->wb_count = 0U;
+	ctx->buf_bytes = 0U;
+
+	return 0;
+}
+
+int stream_flash_write_behind(struct stream_flash_ctx *ctx, uint8_t *bufs, size_t count)
+{
+	if (!ctx || !bufs) {
+		return -EFAULT;
+	}
+
+	if (count == 0 || count >= UINT8_MAX) {
+		return -EINVAL;
+	}
+
+	if (ctx->buf_bytes != 0 || ctx->wb_count != 0) {
+		LOG_ERR("Write-behind must be enabled before writing");
+		return -EBUSY;
+	}
+
+	ctx->wb_bufs = bufs;
+	ctx->wb_count = count + 1;
+	ctx->wb_fill = 0U;
+	ctx->wb_write = 0U;
+	ctx->wb_queued = ctx->bytes_written;
+	ctx->wb_err = 0;
+	atomic_set(&ctx->wb_pending, 0);
+	k_sem_init(&ctx->wb_free, count, count);
+	k_work_init(&ctx->wb_work, wb_work_handler);
+
+	return 0;
+}
+
+static int stream_flash_wb_init(void)
+{
+	static const struct k_work_queue_config cfg = {
+		.name = "stream_flash",
+	};
+
+	k_work_queue_init(&stream_flash_wb_queue);
+	k_work_queue_start(&stream_flash_wb_queue, stream_flash_wb_stack,
+			   K_THREAD_STACK_SIZEOF(stream_flash_wb_stack),
+			   CONFIG_STREAM_FLASH_WRITE_BEHIND_THREAD_PRIO, &cfg);
+
+	return 0;
+}
+
+SYS_INIT(stream_flash_wb_init, POST_KERNEL, CONFIG_APPLICATION_INIT_PRIORITY);
+
+#else
+
+static inline uint8_t *fill_buf(const struct stream_flash_ctx *ctx)
+{
+	return ctx->buf;
+}
+
+#endif /* CONFIG_STREAM_FLASH_WRITE_BEHIND */
+
+static int flash_sync(struct stream_flash_ctx *ctx)
+{
+	int rc;
+
+#ifdef CONFIG_STREAM_FLASH_WRITE_BEHIND
+	if (ctx->wb_count != 0U) {
+		if (ctx->buf_bytes == ctx->buf_len) {
+			return wb_queue(ctx);
+		}
+
+		/* A partial buffer is only written by a flush, after the full ones */
+		rc = wb_wait(ctx);
+		if (rc != 0) {
+			return rc;
+		}
+	}
+#endif
+
+	rc = flash_sync_buf(ctx, fill_buf(ctx), ctx->buf_bytes);
+	if (rc != 0) {
+		return rc;
+	}
+
+#ifdef CONFIG_STREAM_FLASH_WRITE_BEHIND
+	ctx->wb_queued = ctx->bytes_written;
+#endif
+	ctx->buf_bytes = 0U;
+
+	return 0;
+}
+
 int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *data,
 				size_t len, bool flush)
 {
 	int processed = 0;
 	int rc = 0;
 	int buf_empty_bytes;
+	size_t bytes_written;
 
 	if (!ctx) {
 		return -EFAULT;
 	}
 
-	if (ctx->bytes_written + ctx->buf_bytes + len > ctx->available) {
+#ifdef CONFIG_STREAM_FLASH_WRITE_BEHIND
+	if (ctx->wb_count != 0U) {
+		if (ctx->wb_err != 0) {
+			return ctx->wb_err;
+		}
+
+		bytes_written = ctx->wb_queued;
+	} else {
+		bytes_written = ctx->bytes_written;
+	}
+#else
+	bytes_written = ctx->bytes_written;
+#endif
+
+	if (bytes_written + ctx->buf_bytes + len > ctx->available) {
 		return -ENOMEM;
 	}
 
 	while ((len - processed) >=
 	       (buf_empty_bytes = ctx->buf_len - ctx->buf_bytes)) {
-		memcpy(ctx->buf + ctx->buf_bytes, data + processed,
+		memcpy(fill_buf(ctx) + ctx->buf_bytes, data + processed,
 		       buf_empty_bytes);
 
 		ctx->buf_bytes = ctx->buf_len;
@@ -229,7 +426,7 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 
 	/* place rest of the data into ctx->buf */
 	if (processed < len) {
-		memcpy(ctx->buf + ctx->buf_bytes,
+		memcpy(fill_buf(ctx) + ctx->buf_bytes,
 		       data + processed, len - processed);
 		ctx->buf_bytes += len - processed;
 	}
@@ -238,6 +435,12 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		rc = flash_sync(ctx);
 	}
 
+#ifdef CONFIG_STREAM_FLASH_WRITE_BEHIND
+	if (flush && rc == 0 && ctx->wb_count != 0U) {
+		rc = wb_wait(ctx);
+	}
+#endif
+
 	return rc;
 }
 
@@ -334,6 +537,9 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 	ctx->offset = offset;
 	ctx->available = size;
 	ctx->write_block_size = params->write_block_size;
+#ifdef CONFIG_STREAM_FLASH_WRITE_BEHIND
+	ctx->wb_count = 0U;
+#endif
 
 #if !defined(CONFIG_STREAM_FLASH_POST_WRITE_CALLBACK)
 	ARG_UNUSED(cb);
@@ -5,6 +5,7 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/init.h>
+#include <zephyr/sys/barrier.h>
 #include <zephyr/sys/iterable_sections.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/printk.h>
@@ -19,6 +20,49 @@ static struct k_spinlock _zbus_chan_slock;
 
 static struct k_spinlock obs_slock;
 
+#if defined(CONFIG_ZBUS_LOANED_MSG) || defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
+/* The reference count of net_buf is not atomic, and loaned buffers are shared among threads */
+static struct k_spinlock msg_ref_slock;
+
+static struct net_buf *_zbus_msg_ref(struct net_buf *buf)
+{
+	K_SPINLOCK(&msg_ref_slock) {
+		net_buf_ref(buf);
+	}
+
+	return buf;
+}
+
+void zbus_msg_release(struct net_buf *buf)
+{
+	bool last = false;
+
+	K_SPINLOCK(&msg_ref_slock) {
+		if (buf->ref == 1) {
+			last = true;
+		} else {
+			buf->ref--;
+		}
+	}
+
+	/* Nobody else can reach the buffer any more */
+	if (last) {
+		net_buf_unref(buf);
+	}
+}
+#endif /* CONFIG_ZBUS_LOANED_MSG || CONFIG_ZBUS_MSG_SUBSCRIBER */
+
+static inline struct net_buf *_zbus_chan_loan_buf(const struct zbus_channel *chan)
+{
+#if defined(CONFIG_ZBUS_LOANED_MSG)
+	return chan->data->loan_buf;
+#else
+	ARG_UNUSED(chan);
+
+	return NULL;
+#endif /* CONFIG_ZBUS_LOANED_MSG */
+}
+
 #if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
 
 #if defined(CONFIG_ZBUS_MSG_SUBSCRIBER_BUF_ALLOC_DYNAMIC)
@@ -137,11 +181,17 @@ static inline int _zbus_notify_observer(const struct zbus_channel *chan,
 #if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
 	case ZBUS_OBSERVER_MSG_SUBSCRIBER_TYPE: {
 		struct net_buf *cloned_buf = net_buf_clone(buf, sys_timepoint_timeout(end_time));
+		struct net_buf *loan = _zbus_chan_loan_buf(chan);
 
 		if (cloned_buf == NULL) {
 			return -ENOMEM;
 		}
 
+		/* A loaned message is referenced instead of copied */
+		if (loan != NULL) {
+			cloned_buf->frags = _zbus_msg_ref(loan);
+		}
+
 		k_fifo_put(obs->message_fifo, cloned_buf);
 
 		break;
@@ -169,14 +219,20 @@ static inline int _zbus_vded_exec(const struct zbus_channel *chan, k_timepoint_t
 		COND_CODE_1(CONFIG_ZBUS_MSG_SUBSCRIBER_NET_BUF_POOL_ISOLATION,
 			    (chan->data->msg_subscriber_pool), (&_zbus_msg_subscribers_pool));
 
-	buf = _zbus_create_net_buf(pool, zbus_chan_msg_size(chan), sys_timepoint_timeout(end_time));
+	/* A loaned message is not copied, the notifications only carry the channel */
+	bool loaned = _zbus_chan_loan_buf(chan) != NULL;
+
+	buf = _zbus_create_net_buf(pool, loaned ? 0 : zbus_chan_msg_size(chan),
+				   sys_timepoint_timeout(end_time));
 
 	_ZBUS_ASSERT(buf != NULL, "net_buf zbus_msg_subscribers_pool is "
 				  "unavailable or heap is full");
 
 	memcpy(net_buf_user_data(buf), &chan, sizeof(struct zbus_channel *));
 
-	net_buf_add_mem(buf, zbus_chan_msg(chan), zbus_chan_msg_size(chan));
+	if (!loaned) {
+		net_buf_add_mem(buf, zbus_chan_msg(chan), zbus_chan_msg_size(chan));
+	}
 #endif /* CONFIG_ZBUS_MSG_SUBSCRIBER */
 
 	LOG_DBG("Notifing %s's observers. Starting VDED:", _ZBUS_CHAN_NAME(chan));
@@ -320,12 +376,26 @@ static inline void update_all_channels_hop(const struct zbus_observer *obs)
 
 #endif /* CONFIG_ZBUS_PRIORITY_BOOST */
 
+static inline bool _zbus_chan_is_seqlock(const struct zbus_channel *chan)
+{
+#if defined(CONFIG_ZBUS_SEQLOCK_CHANNEL)
+	return chan->seqlock;
+#else
+	ARG_UNUSED(chan);
+
+	return false;
+#endif /* CONFIG_ZBUS_SEQLOCK_CHANNEL */
+}
+
 static inline int chan_lock(const struct zbus_channel *chan, k_timeout_t timeout, int *prio)
 {
 	bool boosting = false;
 
 #if defined(CONFIG_ZBUS_PRIORITY_BOOST)
-	if (!k_is_in_isr()) {
+	/* Seqlock channels are read without being locked, no observer preempting the publisher
+	 * would wait for it
+	 */
+	if (!k_is_in_isr() && !_zbus_chan_is_seqlock(chan)) {
 		*prio = k_thread_priority_get(k_current_get());
 
 		K_SPINLOCK(&_zbus_chan_slock) {
@@ -374,6 +444,61 @@ static inline void chan_unlock(const struct zbus_channel *chan, int prio)
 #endif /* CONFIG_ZBUS_PRIORITY_BOOST */
 }
 
+/* Make the channel's message field hold its message again, the channel must be locked */
+static inline void _zbus_chan_loan_drop(const struct zbus_channel *chan, bool copy)
+{
+#if defined(CONFIG_ZBUS_LOANED_MSG)
+	struct net_buf *loan = chan->data->loan_buf;
+
+	if (loan == NULL) {
+		return;
+	}
+
+	if (copy) {
+		memcpy(chan->message, loan->data, chan->message_size);
+	}
+
+	chan->data->loan_buf = NULL;
+	zbus_msg_release(loan);
+#else
+	ARG_UNUSED(chan);
+	ARG_UNUSED(copy);
+#endif /* CONFIG_ZBUS_LOANED_MSG */
+}
+
+#if defined(CONFIG_ZBUS_SEQLOCK_CHANNEL)
+
+/* Publish to a seqlock channel, the channel must be locked */
+static inline void _zbus_chan_seqlock_write(const struct zbus_channel *chan, const void *msg)
+{
+	atomic_val_t seq = atomic_get(&chan->data->seq) + 1;
+
+	/* Fill the copy readers are not reading, then switch them to it */
+	memcpy(_zbus_chan_seqlock_msg(chan, seq), msg, chan->message_size);
+
+	/* The copy must be visible to other CPUs before the switch is */
+	barrier_dmem_fence_full();
+
+	atomic_set(&chan->data->seq, seq);
+}
+
+static inline void _zbus_chan_seqlock_read(const struct zbus_channel *chan, void *msg)
+{
+	atomic_val_t seq;
+
+	/* The copy read is only written again after the next publish, retry if there was one */
+	do {
+		seq = atomic_get(&chan->data->seq);
+
+		memcpy(msg, _zbus_chan_seqlock_msg(chan, seq), chan->message_size);
+
+		/* Keep the copy from being reordered after the check */
+		barrier_dmem_fence_full();
+	} while (atomic_get(&chan->data->seq) != seq);
+}
+
+#endif /* CONFIG_ZBUS_SEQLOCK_CHANNEL */
+
 int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t timeout)
 {
 	int err;
@@ -403,7 +528,16 @@ int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t
 	chan->data->publish_count += 1;
 #endif /* CONFIG_ZBUS_CHANNEL_PUBLISH_STATS */
 
-	memcpy(chan->message, msg, chan->message_size);
+#if defined(CONFIG_ZBUS_SEQLOCK_CHANNEL)
+	if (chan->seqlock) {
+		_zbus_chan_seqlock_write(chan, msg);
+	} else
+#endif /* CONFIG_ZBUS_SEQLOCK_CHANNEL */
+	{
+		memcpy(chan->message, msg, chan->message_size);
+
+		_zbus_chan_loan_drop(chan, false);
+	}
 
 	err = _zbus_vded_exec(chan, end_time);
 
@@ -417,6 +551,14 @@ int zbus_chan_read(const struct zbus_channel *chan, void *msg, k_timeout_t timeo
 	_ZBUS_ASSERT(chan != NULL, "chan is required");
 	_ZBUS_ASSERT(msg != NULL, "msg is required");
 
+#if defined(CONFIG_ZBUS_SEQLOCK_CHANNEL)
+	if (chan->seqlock) {
+		_zbus_chan_seqlock_read(chan, msg);
+
+		return 0;
+	}
+#endif /* CONFIG_ZBUS_SEQLOCK_CHANNEL */
+
 	if (k_is_in_isr()) {
 		timeout = K_NO_WAIT;
 	}
@@ -426,13 +568,115 @@ int zbus_chan_read(const struct zbus_channel *chan, void *msg, k_timeout_t timeo
 		return err;
 	}
 
-	memcpy(msg, chan->message, chan->message_size);
+	memcpy(msg, zbus_chan_const_msg(chan), chan->message_size);
 
 	k_sem_give(&chan->data->sem);
 
 	return 0;
 }
 
+#if defined(CONFIG_ZBUS_LOANED_MSG)
+
+int zbus_chan_loan(const struct zbus_channel *chan, struct net_buf **buf, k_timeout_t timeout)
+{
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(buf != NULL, "buf is required");
+
+	/* A loaned buffer is published in place, readers of a seqlock channel would see it
+	 * change
+	 */
+	if (chan->data->loan_pool == NULL || _zbus_chan_is_seqlock(chan)) {
+		return -ENOTSUP;
+	}
+
+	if (k_is_in_isr()) {
+		timeout = K_NO_WAIT;
+	}
+
+	*buf = net_buf_alloc(chan->data->loan_pool, timeout);
+	if (*buf == NULL) {
+		return -ENOMEM;
+	}
+
+	_ZBUS_ASSERT(net_buf_tailroom(*buf) >= chan->message_size,
+		     "loan pool buffers must fit the channel's message");
+
+	net_buf_add(*buf, chan->message_size);
+
+	return 0;
+}
+
+int zbus_chan_commit(const struct zbus_channel *chan, struct net_buf *buf, k_timeout_t timeout)
+{
+	int err;
+
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(buf != NULL, "buf is required");
+
+	if (k_is_in_isr()) {
+		timeout = K_NO_WAIT;
+	}
+
+	k_timepoint_t end_time = sys_timepoint_calc(timeout);
+
+	if (chan->validator != NULL && !chan->validator(buf->data, chan->message_size)) {
+		zbus_msg_release(buf);
+		return -ENOMSG;
+	}
+
+	int context_priority = ZBUS_MIN_THREAD_PRIORITY;
+
+	err = chan_lock(chan, timeout, &context_priority);
+	if (err) {
+		zbus_msg_release(buf);
+		return err;
+	}
+
+#if defined(CONFIG_ZBUS_CHANNEL_PUBLISH_STATS)
+	chan->data->publish_timestamp = k_uptime_ticks();
+	chan->data->publish_count += 1;
+#endif /* CONFIG_ZBUS_CHANNEL_PUBLISH_STATS */
+
+	/* The channel takes over the publisher's reference */
+	_zbus_chan_loan_drop(chan, false);
+	chan->data->loan_buf = buf;
+
+	err = _zbus_vded_exec(chan, end_time);
+
+	chan_unlock(chan, context_priority);
+
+	return err;
+}
+
+int zbus_chan_read_ref(const struct zbus_channel *chan, struct net_buf **buf,
+		       k_timeout_t timeout)
+{
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(buf != NULL, "buf is required");
+
+	if (k_is_in_isr()) {
+		timeout = K_NO_WAIT;
+	}
+
+	int err = k_sem_take(&chan->data->sem, timeout);
+
+	if (err) {
+		return err;
+	}
+
+	if (chan->data->loan_buf != NULL) {
+		*buf = _zbus_msg_ref(chan->data->loan_buf);
+	} else {
+		err = -ENODATA;
+	}
+
+	k_sem_give(&chan->data->sem);
+
+	return err;
+}
+
+#endif /* CONFIG_ZBUS_LOANED_MSG */
+
 int zbus_chan_notify(const struct zbus_channel *chan, k_timeout_t timeout)
 {
 	int err;
@@ -473,6 +717,11 @@ int zbus_chan_claim(const struct zbus_channel *chan, k_timeout_t timeout)
 		return err;
 	}
 
+	/* The message may be modified in place, which a loaned buffer shared with subscribers
+	 * must not be
+	 */
+	_zbus_chan_loan_drop(chan, true);
+
 	return 0;
 }
 
@@ -499,6 +748,23 @@ int zbus_sub_wait(const struct zbus_observer *sub, const struct zbus_channel **c
 
 #if defined(CONFIG_ZBUS_MSG_SUBSCRIBER)
 
+/* Returns the buffer holding the message of a notification, which is the notification itself
+ * unless it references a loaned buffer
+ */
+static struct net_buf *_zbus_msg_buf_take(struct net_buf *buf)
+{
+	struct net_buf *loan = buf->frags;
+
+	if (loan == NULL) {
+		return buf;
+	}
+
+	buf->frags = NULL;
+	net_buf_unref(buf);
+
+	return loan;
+}
+
 int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel **chan, void *msg,
 		      k_timeout_t timeout)
 {
@@ -518,9 +784,35 @@ int zbus_sub_wait_msg(const struct zbus_observer *sub, const struct zbus_channel
 
 	*chan = *((struct zbus_channel **)net_buf_user_data(buf));
 
-	memcpy(msg, net_buf_remove_mem(buf, zbus_chan_msg_size(*chan)), zbus_chan_msg_size(*chan));
+	buf = _zbus_msg_buf_take(buf);
 
-	net_buf_unref(buf);
+	memcpy(msg, buf->data, zbus_chan_msg_size(*chan));
+
+	zbus_msg_release(buf);
+
+	return 0;
+}
+
+int zbus_sub_wait_msg_ref(const struct zbus_observer *sub, const struct zbus_channel **chan,
+			  struct net_buf **buf, k_timeout_t timeout)
+{
+	_ZBUS_ASSERT(!k_is_in_isr(), "zbus_sub_wait_msg_ref cannot be used inside ISRs");
+	_ZBUS_ASSERT(sub != NULL, "sub is required");
+	_ZBUS_ASSERT(sub->type == ZBUS_OBSERVER_MSG_SUBSCRIBER_TYPE,
+		     "sub must be a MSG_SUBSCRIBER");
+	_ZBUS_ASSERT(sub->message_fifo != NULL, "sub message_fifo is required");
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+	_ZBUS_ASSERT(buf != NULL, "buf is required");
+
+	struct net_buf *notification = k_fifo_get(sub->message_fifo, timeout);
+
+	if (notification == NULL) {
+		return -ENOMSG;
+	}
+
+	*chan = *((struct zbus_channel **)net_buf_user_data(notification));
+
+	*buf = _zbus_msg_buf_take(notification);
 
 	return 0;
 }
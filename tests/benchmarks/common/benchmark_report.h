@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_BENCHMARK_COMMON_BENCHMARK_REPORT_H_
+#define ZEPHYR_BENCHMARK_COMMON_BENCHMARK_REPORT_H_
+
+#include <stdint.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/timing/timing.h>
+
+/**
+ * @brief Display a single measurement
+ *
+ * With CONFIG_BENCHMARK_RECORDING, the line is a record for the "REC: "
+ * regex of the benchmarks' testcase.yaml, the metric being @a tag
+ * followed by @a count. Keep both in sync.
+ *
+ * @param count Parameter the measurement was made with, e.g. the number
+ *              of active CPUs or the message size
+ * @param cycles Measured number of cycles
+ * @param tag Short record tag
+ * @param str Description of the measurement
+ */
+static inline void benchmark_report_cycles(unsigned int count, uint64_t cycles,
+					   const char *tag, const char *str)
+{
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s.%05u - %s, %u : %7llu cycles , %7u ns :\n",
+	       tag, count, str, count, cycles, (uint32_t)timing_cycles_to_ns(cycles));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%s (%u) : %7llu cycles (%7u nsec)\n", str, count, cycles,
+	       (uint32_t)timing_cycles_to_ns(cycles));
+#endif
+}
+
+/**
+ * @brief Display the minimum, maximum and average of a series of measurements
+ *
+ * With CONFIG_BENCHMARK_RECORDING, each value is a record for the "REC: "
+ * regex of the benchmarks' testcase.yaml, the metric being @a tag followed
+ * by @a count and the name of the statistic.
+ *
+ * @param count Parameter the measurements were made with, e.g. the number
+ *              of pending timeouts or the buffer size
+ * @param unit What @a count is a number of
+ * @param cycles Measured numbers of cycles
+ * @param num Number of measurements in @a cycles, at least one
+ * @param tag Short record tag
+ * @param str Description of the measurement
+ *
+ * @return Average number of cycles
+ */
+static inline uint64_t benchmark_report_stats(unsigned int count, const char *unit,
+					      const uint64_t *cycles, unsigned int num,
+					      const char *tag, const char *str)
+{
+	uint64_t minimum = cycles[0];
+	uint64_t maximum = cycles[0];
+	uint64_t total = 0;
+	uint64_t average;
+
+	for (unsigned int i = 0; i < num; i++) {
+		minimum = MIN(minimum, cycles[i]);
+		maximum = MAX(maximum, cycles[i]);
+		total += cycles[i];
+	}
+
+	average = total / num;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s.%05u.min - %s, %u %s, min. : %7llu cycles , %7u ns :\n",
+	       tag, count, str, count, unit, minimum,
+	       (uint32_t)timing_cycles_to_ns(minimum));
+	printk("REC: %s.%05u.max - %s, %u %s, max. : %7llu cycles , %7u ns :\n",
+	       tag, count, str, count, unit, maximum,
+	       (uint32_t)timing_cycles_to_ns(maximum));
+	printk("REC: %s.%05u.avg - %s, %u %s, avg. : %7llu cycles , %7u ns :\n",
+	       tag, count, str, count, unit, average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#else
+	ARG_UNUSED(tag);
+
+	printk("------------------------------------\n");
+	printk("%s (%u %s)\n", str, count, unit);
+
+	printk("    Minimum : %7llu cycles (%7u nsec)\n", minimum,
+	       (uint32_t)timing_cycles_to_ns(minimum));
+	printk("    Maximum : %7llu cycles (%7u nsec)\n", maximum,
+	       (uint32_t)timing_cycles_to_ns(maximum));
+	printk("    Average : %7llu cycles (%7u nsec)\n", average,
+	       (uint32_t)timing_cycles_to_ns(average));
+#endif
+
+	return average;
+}
+
+/** Seed of benchmark_rand(), the same for every run */
+#define BENCHMARK_RAND_SEED 0x2545F491U
+
+/**
+ * @brief Next value of a xorshift32 sequence
+ *
+ * Cheap and reproducible, so that each run of a benchmark works on the
+ * same data. Start from BENCHMARK_RAND_SEED, offset per thread if needed.
+ *
+ * @param state Sequence state, updated
+ *
+ * @return Next pseudo-random value
+ */
+static inline uint32_t benchmark_rand(uint32_t *state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 17;
+	*state ^= *state << 5;
+
+	return *state;
+}
+
+#endif /* ZEPHYR_BENCHMARK_COMMON_BENCHMARK_REPORT_H_ */
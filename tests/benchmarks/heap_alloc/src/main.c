@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the cost of allocating and freeing
+ * small blocks from a k_heap while a varying number of CPUs use the same
+ * heap at once, which shows the contention on the heap lock.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include "../../common/benchmark_report.h"
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+#define BLOCKS_PER_WORKER (CONFIG_BENCHMARK_NUM_ITERATIONS * CONFIG_BENCHMARK_BURST)
+
+K_HEAP_DEFINE(bench_heap, CONFIG_BENCHMARK_HEAP_SIZE);
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stack, CONFIG_MP_MAX_NUM_CPUS,
+				   STACK_SIZE);
+static struct k_thread worker_thread[CONFIG_MP_MAX_NUM_CPUS];
+static uint64_t worker_cycles[CONFIG_MP_MAX_NUM_CPUS];
+static unsigned int worker_failures[CONFIG_MP_MAX_NUM_CPUS];
+
+static atomic_t start_flag;
+static K_SEM_DEFINE(done_sem, 0, CONFIG_MP_MAX_NUM_CPUS);
+
+static void worker_entry(void *p1, void *p2, void *p3)
+{
+	unsigned int id = (unsigned int)(uintptr_t)p1;
+	void *blocks[CONFIG_BENCHMARK_BURST];
+	/* Same sizes allocated on each run */
+	uint32_t rand_state = BENCHMARK_RAND_SEED + id;
+	timing_t start;
+	timing_t finish;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!atomic_get(&start_flag)) {
+		arch_spin_relax();
+	}
+
+	start = timing_counter_get();
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		for (unsigned int j = 0; j < CONFIG_BENCHMARK_BURST; j++) {
+			blocks[j] = k_heap_alloc(&bench_heap,
+						 8 + benchmark_rand(&rand_state) % 57,
+						 K_NO_WAIT);
+		}
+
+		for (unsigned int j = CONFIG_BENCHMARK_BURST; j > 0; j--) {
+			if (blocks[j - 1] == NULL) {
+				worker_failures[id]++;
+			} else {
+				k_heap_free(&bench_heap, blocks[j - 1]);
+			}
+		}
+	}
+	finish = timing_counter_get();
+
+	worker_cycles[id] = timing_cycles_get(&start, &finish);
+
+	k_sem_give(&done_sem);
+}
+
+static unsigned int test_alloc_free(unsigned int active)
+{
+	unsigned int failures = 0;
+	uint64_t total = 0;
+
+	for (unsigned int i = 0; i < active; i++) {
+		worker_failures[i] = 0;
+		k_thread_create(&worker_thread[i], worker_stack[i], STACK_SIZE,
+				worker_entry, (void *)(uintptr_t)i, NULL, NULL,
+				K_PRIO_PREEMPT(10), 0, K_NO_WAIT);
+	}
+
+	/* Let the workers on the other CPUs reach the start line, the one
+	 * sharing this CPU starts once we block.
+	 */
+	k_busy_wait(10000);
+	atomic_set(&start_flag, 1);
+
+	for (unsigned int i = 0; i < active; i++) {
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+
+	for (unsigned int i = 0; i < active; i++) {
+		k_thread_join(&worker_thread[i], K_FOREVER);
+		total += worker_cycles[i];
+		failures += worker_failures[i];
+	}
+
+	atomic_clear(&start_flag);
+
+	benchmark_report_cycles(active, total / (active * BLOCKS_PER_WORKER),
+				"heap.alloc_free", "Allocate and free a small block, per CPU");
+
+	return failures;
+}
+
+/* Whatever the CPUs still cache, nothing may be left allocated */
+static int heap_check(void)
+{
+	struct sys_memory_stats stats;
+	void *mem;
+
+	/* Cannot fit, but returns the cached blocks to the heap first */
+	mem = k_heap_alloc(&bench_heap, CONFIG_BENCHMARK_HEAP_SIZE, K_NO_WAIT);
+	if (mem != NULL) {
+		k_heap_free(&bench_heap, mem);
+	}
+
+	(void)k_heap_runtime_stats_get(&bench_heap, &stats);
+
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+	printk("Cache hits %zu, misses %zu\n", stats.cache_hits,
+	       stats.cache_misses);
+#endif
+
+	if (stats.allocated_bytes != 0) {
+		printk("%zu bytes still allocated\n", stats.allocated_bytes);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	unsigned int failures = 0;
+	int ret;
+
+	timing_init();
+
+	printk("Time Measurements for %s k_heap\n",
+	       IS_ENABLED(CONFIG_K_HEAP_CPU_CACHE) ? "per-CPU cached" : "locked");
+	printk("Timing results: Clock frequency: %u MHz\n",
+	       timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int active = 1; active <= num_cpus; active++) {
+		failures += test_alloc_free(active);
+	}
+
+	timing_stop();
+
+	if (failures != 0) {
+		printk("%u allocations failed\n", failures);
+	}
+
+	ret = heap_check();
+
+	TC_END_REPORT(((ret < 0) || (failures != 0)) ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
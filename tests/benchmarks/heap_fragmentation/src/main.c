@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure how fragmented a sys_heap gets
+ * under long runs of random allocations and frees of mixed sizes, as the
+ * rate of failed allocations and the largest block left free, along with
+ * the cost of the allocations.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/sys/sys_heap.h>
+#include "../../common/benchmark_report.h"
+
+static uint8_t __aligned(8) heap_mem[CONFIG_BENCHMARK_HEAP_SIZE];
+
+/* Block records of the stress rig, half the heap as it recommends */
+static uint8_t __aligned(8) scratch_mem[CONFIG_BENCHMARK_HEAP_SIZE / 2];
+
+static struct sys_heap heap;
+
+static void *stress_alloc(void *arg, size_t bytes)
+{
+	return sys_heap_alloc(arg, bytes);
+}
+
+static void stress_free(void *arg, void *p)
+{
+	sys_heap_free(arg, p);
+}
+
+static int test_fragmentation(uint32_t op_count)
+{
+	struct z_heap_stress_result result;
+	struct sys_memory_stats stats;
+	uint32_t failures;
+	uint32_t permille;
+	size_t largest;
+	timing_t start;
+	timing_t finish;
+
+	sys_heap_init(&heap, heap_mem, sizeof(heap_mem));
+
+	start = timing_counter_get();
+	sys_heap_stress(stress_alloc, stress_free, &heap, sizeof(heap_mem),
+			op_count, scratch_mem, sizeof(scratch_mem),
+			CONFIG_BENCHMARK_TARGET_PERCENT, &result);
+	finish = timing_counter_get();
+
+	(void)sys_heap_runtime_stats_get(&heap, &stats);
+	largest = sys_heap_largest_free(&heap);
+
+	failures = result.total_allocs - result.successful_allocs;
+	permille = (uint32_t)((1000ULL * failures) / MAX(result.total_allocs, 1));
+
+	printk("------------------------------------\n");
+	printk("After %u operations:\n", op_count);
+	printk("    Failed allocations : %u of %u (%u.%u%%)\n", failures,
+	       result.total_allocs, permille / 10U, permille % 10U);
+	printk("    Average usage : %llu bytes\n",
+	       result.accumulated_in_use_bytes / op_count);
+	printk("    Free : %zu bytes, largest free block : %zu bytes\n",
+	       stats.free_bytes, largest);
+
+	benchmark_report_cycles(op_count, timing_cycles_get(&start, &finish) / op_count,
+				"heap.stress", "Average cost of an allocation or free");
+
+	/* The largest block is part of the free memory */
+	return (largest <= stats.free_bytes) ? 0 : -EIO;
+}
+
+int main(void)
+{
+	int ret = 0;
+
+	timing_init();
+
+	printk("Fragmentation Measurements for %s sys_heap\n",
+	       IS_ENABLED(CONFIG_SYS_HEAP_ALLOC_BEST_FIT) ? "best fit" : "bucket");
+	printk("Heap of %u bytes, %u%% target usage\n",
+	       CONFIG_BENCHMARK_HEAP_SIZE, CONFIG_BENCHMARK_TARGET_PERCENT);
+	printk("Timing results: Clock frequency: %u MHz\n",
+	       timing_freq_get_mhz());
+
+	timing_start();
+
+	for (uint32_t op_count = 1000;
+	     (ret == 0) && (op_count <= CONFIG_BENCHMARK_NUM_OPERATIONS);
+	     op_count *= 10) {
+		ret = test_fragmentation(op_count);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(ret < 0 ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
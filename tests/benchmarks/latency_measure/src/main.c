@@ -108,6 +108,9 @@ static void test_thread(void *arg1, void *arg2, void *arg3)
 
 	TC_START("Time Measurement");
 	TC_PRINT("Timing results: Clock frequency: %u MHz\n", freq);
+	TC_PRINT("Run queues: %s, %u CPUs\n",
+		 IS_ENABLED(CONFIG_SCHED_CPU_RUNQ) ? "per CPU" : "global",
+		 arch_num_cpus());
 
 	timestamp_overhead_init(CONFIG_BENCHMARK_NUM_ITERATIONS);
 
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure how many log lines per second
+ * log_output_process() formats for the output buffers and flags used by
+ * the UART, file system and network backends, and how many times it calls
+ * the output function of the backend per line.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_output.h>
+#include <zephyr/sys/cbprintf.h>
+
+#define UART_BUF_SIZE 32
+#define FS_BUF_SIZE   256
+#define NET_BUF_SIZE  480
+
+struct sink {
+	uint32_t calls;
+	uint32_t bytes;
+};
+
+static uint8_t uart_buf[UART_BUF_SIZE];
+static uint8_t fs_buf[FS_BUF_SIZE];
+static uint8_t net_buf[NET_BUF_SIZE];
+
+static struct sink sink;
+
+static int sink_out(uint8_t *data, size_t length, void *ctx)
+{
+	struct sink *s = ctx;
+
+	ARG_UNUSED(data);
+
+	s->calls++;
+	s->bytes += length;
+
+	return length;
+}
+
+LOG_OUTPUT_DEFINE(uart_output, sink_out, uart_buf, sizeof(uart_buf));
+LOG_OUTPUT_DEFINE(fs_output, sink_out, fs_buf, sizeof(fs_buf));
+LOG_OUTPUT_DEFINE(net_output, sink_out, net_buf, sizeof(net_buf));
+
+struct backend_config {
+	const char *name;
+	const struct log_output *output;
+	uint32_t flags;
+};
+
+static const struct backend_config backends[] = {
+	{
+		.name = "uart",
+		.output = &uart_output,
+		.flags = LOG_OUTPUT_FLAG_COLORS | LOG_OUTPUT_FLAG_TIMESTAMP |
+			 LOG_OUTPUT_FLAG_FORMAT_TIMESTAMP | LOG_OUTPUT_FLAG_LEVEL,
+	},
+	{
+		.name = "fs",
+		.output = &fs_output,
+		.flags = LOG_OUTPUT_FLAG_TIMESTAMP | LOG_OUTPUT_FLAG_FORMAT_TIMESTAMP |
+			 LOG_OUTPUT_FLAG_LEVEL,
+	},
+	{
+		.name = "net",
+		.output = &net_output,
+		.flags = LOG_OUTPUT_FLAG_TIMESTAMP | LOG_OUTPUT_FLAG_LEVEL |
+			 LOG_OUTPUT_FLAG_CRLF_NONE,
+	},
+};
+
+static uint8_t __aligned(sizeof(void *)) package[128];
+static uint8_t hexdump_data[32];
+
+static void report(const char *tag, const char *str, uint64_t cycles)
+{
+	uint64_t ns = timing_cycles_to_ns(cycles);
+	uint64_t lines_per_sec = (1000000000ULL * CONFIG_BENCHMARK_NUM_ITERATIONS) /
+				 MAX(ns, 1);
+	uint64_t line_cycles = cycles / CONFIG_BENCHMARK_NUM_ITERATIONS;
+
+#ifdef CONFIG_BENCHMARK_RECORDING
+	printk("REC: %s - %s : %7llu cycles , %7u ns :\n", tag, str, line_cycles,
+	       (uint32_t)timing_cycles_to_ns(line_cycles));
+#else
+	ARG_UNUSED(tag);
+
+	printk("%s : %7llu cycles (%7u nsec)\n", str, line_cycles,
+	       (uint32_t)timing_cycles_to_ns(line_cycles));
+#endif
+	printk("    %llu lines/s, %u.%02u output calls and %u bytes per line\n",
+	       lines_per_sec, sink.calls / CONFIG_BENCHMARK_NUM_ITERATIONS,
+	       ((sink.calls % CONFIG_BENCHMARK_NUM_ITERATIONS) * 100U) /
+	       CONFIG_BENCHMARK_NUM_ITERATIONS,
+	       sink.bytes / CONFIG_BENCHMARK_NUM_ITERATIONS);
+}
+
+static int test_output(const struct backend_config *backend, bool hexdump)
+{
+	char tag[32];
+	char str[64];
+	timing_t start;
+	timing_t finish;
+
+	sink.calls = 0;
+	sink.bytes = 0;
+	log_output_ctx_set(backend->output, &sink);
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		log_output_process(backend->output, i, NULL, "bench", NULL,
+				   LOG_LEVEL_INF, package,
+				   hexdump ? hexdump_data : NULL,
+				   hexdump ? sizeof(hexdump_data) : 0,
+				   backend->flags);
+	}
+	finish = timing_counter_get();
+
+	snprintk(tag, sizeof(tag), "log_output.%s%s", backend->name,
+		 hexdump ? ".hexdump" : "");
+	snprintk(str, sizeof(str), "Format a %sline for the %s backend",
+		 hexdump ? "hexdump " : "", backend->name);
+	report(tag, str, timing_cycles_get(&start, &finish));
+
+	/* Every line must have reached the backend */
+	return (sink.bytes >= CONFIG_BENCHMARK_NUM_ITERATIONS) ? 0 : -EIO;
+}
+
+int main(void)
+{
+	int ret;
+
+	ret = cbprintf_package(package, sizeof(package), 0,
+			       "sensor %d reading %u out of range (%s)", -3, 1024U,
+			       "retrying");
+	if (ret < 0) {
+		printk("Failed to create package (%d)\n", ret);
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	for (size_t i = 0; i < sizeof(hexdump_data); i++) {
+		hexdump_data[i] = i * 7;
+	}
+
+	log_output_timestamp_freq_set(sys_clock_hw_cycles_per_sec());
+
+	timing_init();
+
+	printk("Time Measurements for %s log output\n",
+	       IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE) ? "immediate" : "deferred");
+	printk("Timing results: Clock frequency: %u MHz\n",
+	       timing_freq_get_mhz());
+
+	timing_start();
+
+	ret = 0;
+	for (size_t i = 0; (ret == 0) && (i < ARRAY_SIZE(backends)); i++) {
+		ret = test_output(&backends[i], false);
+		if (ret == 0) {
+			ret = test_output(&backends[i], true);
+		}
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(ret < 0 ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
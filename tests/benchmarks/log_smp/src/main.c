@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the cost of a LOG_INF() call in
+ * deferred mode while a varying number of CPUs log at once, which shows the
+ * contention on the log buffer.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_internal.h>
+#include "../../common/benchmark_report.h"
+
+LOG_MODULE_REGISTER(log_smp, LOG_LEVEL_INF);
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stack, CONFIG_MP_MAX_NUM_CPUS,
+				   STACK_SIZE);
+static struct k_thread worker_thread[CONFIG_MP_MAX_NUM_CPUS];
+static uint64_t worker_cycles[CONFIG_MP_MAX_NUM_CPUS];
+
+static atomic_t start_flag;
+static K_SEM_DEFINE(done_sem, 0, CONFIG_MP_MAX_NUM_CPUS);
+
+/* Only the log processing context touches these */
+static uint32_t processed_cnt;
+static uint32_t unordered_cnt;
+static uint32_t dropped_cnt;
+static log_timestamp_t prev_timestamp;
+
+static void bench_process(const struct log_backend *const backend,
+			  union log_msg_generic *msg)
+{
+	log_timestamp_t timestamp = log_msg_get_timestamp(&msg->log);
+
+	if (timestamp < prev_timestamp) {
+		unordered_cnt++;
+	}
+
+	prev_timestamp = timestamp;
+	processed_cnt++;
+}
+
+static void bench_dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	dropped_cnt += cnt;
+}
+
+static const struct log_backend_api bench_backend_api = {
+	.process = bench_process,
+	.dropped = bench_dropped,
+};
+
+LOG_BACKEND_DEFINE(bench_backend, bench_backend_api, true);
+
+static void worker_entry(void *p1, void *p2, void *p3)
+{
+	unsigned int id = (unsigned int)(uintptr_t)p1;
+	timing_t start;
+	timing_t finish;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!atomic_get(&start_flag)) {
+		arch_spin_relax();
+	}
+
+	start = timing_counter_get();
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		LOG_INF("worker %u message %u", id, i);
+	}
+	finish = timing_counter_get();
+
+	worker_cycles[id] = timing_cycles_get(&start, &finish);
+
+	k_sem_give(&done_sem);
+}
+
+static void report_drops(void)
+{
+#ifdef CONFIG_LOG_CPU_BUFFERS
+	for (unsigned int cpu = 0; cpu < arch_num_cpus(); cpu++) {
+		uint32_t cnt;
+
+		if ((log_dropped_cpu_get(cpu, &cnt) == 0) && (cnt != 0)) {
+			printk("    CPU %u dropped %u messages so far\n", cpu, cnt);
+		}
+	}
+#endif
+}
+
+/* Every message logged must be processed or reported as dropped */
+static int test_log(unsigned int active)
+{
+	uint32_t logged = active * CONFIG_BENCHMARK_NUM_ITERATIONS;
+	uint64_t total = 0;
+
+	processed_cnt = 0;
+	unordered_cnt = 0;
+	dropped_cnt = 0;
+	prev_timestamp = 0;
+
+	for (unsigned int i = 0; i < active; i++) {
+		k_thread_create(&worker_thread[i], worker_stack[i], STACK_SIZE,
+				worker_entry, (void *)(uintptr_t)i, NULL, NULL,
+				K_PRIO_PREEMPT(10), 0, K_NO_WAIT);
+	}
+
+	/* Let the workers on the other CPUs reach the start line, the one
+	 * sharing this CPU starts once we block.
+	 */
+	k_busy_wait(10000);
+	atomic_set(&start_flag, 1);
+
+	for (unsigned int i = 0; i < active; i++) {
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+
+	for (unsigned int i = 0; i < active; i++) {
+		k_thread_join(&worker_thread[i], K_FOREVER);
+		total += worker_cycles[i];
+	}
+
+	atomic_clear(&start_flag);
+
+	benchmark_report_cycles(active, total / logged, "log.inf",
+				"LOG_INF() with two arguments, per CPU");
+
+	while (log_process()) {
+	}
+
+	dropped_cnt += z_log_dropped_read_and_clear();
+
+	printk("    Processed %u, dropped %u, out of order %u\n",
+	       processed_cnt, dropped_cnt, unordered_cnt);
+	report_drops();
+
+	return (processed_cnt + dropped_cnt == logged) ? 0 : -EIO;
+}
+
+int main(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	int ret = 0;
+
+	log_init();
+
+	timing_init();
+
+	printk("Time Measurements for %s log buffer\n",
+	       IS_ENABLED(CONFIG_LOG_CPU_BUFFERS) ? "per-CPU" : "shared");
+	printk("Timing results: Clock frequency: %u MHz\n",
+	       timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int active = 1; (ret == 0) && (active <= num_cpus); active++) {
+		ret = test_log(active);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(ret < 0 ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the cost of allocating and freeing
+ * memory slab blocks while a varying number of CPUs use the same slab at
+ * once, which shows the contention on the slab lock.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include "../../common/benchmark_report.h"
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+#define BLOCK_SIZE  64
+#define BLOCK_COUNT (CONFIG_MP_MAX_NUM_CPUS * 4 * CONFIG_BENCHMARK_BURST)
+
+#define BLOCKS_PER_WORKER (CONFIG_BENCHMARK_NUM_ITERATIONS * CONFIG_BENCHMARK_BURST)
+
+K_MEM_SLAB_DEFINE_STATIC(bench_slab, BLOCK_SIZE, BLOCK_COUNT, sizeof(void *));
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stack, CONFIG_MP_MAX_NUM_CPUS,
+				   STACK_SIZE);
+static struct k_thread worker_thread[CONFIG_MP_MAX_NUM_CPUS];
+static uint64_t worker_cycles[CONFIG_MP_MAX_NUM_CPUS];
+
+static atomic_t start_flag;
+static K_SEM_DEFINE(done_sem, 0, CONFIG_MP_MAX_NUM_CPUS);
+
+static void worker_entry(void *p1, void *p2, void *p3)
+{
+	unsigned int id = (unsigned int)(uintptr_t)p1;
+	void *blocks[CONFIG_BENCHMARK_BURST];
+	timing_t start;
+	timing_t finish;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!atomic_get(&start_flag)) {
+		arch_spin_relax();
+	}
+
+	start = timing_counter_get();
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		for (unsigned int j = 0; j < CONFIG_BENCHMARK_BURST; j++) {
+			(void)k_mem_slab_alloc(&bench_slab, &blocks[j], K_FOREVER);
+		}
+
+		for (unsigned int j = CONFIG_BENCHMARK_BURST; j > 0; j--) {
+			k_mem_slab_free(&bench_slab, blocks[j - 1]);
+		}
+	}
+	finish = timing_counter_get();
+
+	worker_cycles[id] = timing_cycles_get(&start, &finish);
+
+	k_sem_give(&done_sem);
+}
+
+static void test_alloc_free(unsigned int active)
+{
+	uint64_t total = 0;
+
+	for (unsigned int i = 0; i < active; i++) {
+		k_thread_create(&worker_thread[i], worker_stack[i], STACK_SIZE,
+				worker_entry, (void *)(uintptr_t)i, NULL, NULL,
+				K_PRIO_PREEMPT(10), 0, K_NO_WAIT);
+	}
+
+	/* Let the workers on the other CPUs reach the start line, the one
+	 * sharing this CPU starts once we block.
+	 */
+	k_busy_wait(10000);
+	atomic_set(&start_flag, 1);
+
+	for (unsigned int i = 0; i < active; i++) {
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+
+	for (unsigned int i = 0; i < active; i++) {
+		k_thread_join(&worker_thread[i], K_FOREVER);
+		total += worker_cycles[i];
+	}
+
+	atomic_clear(&start_flag);
+
+	benchmark_report_cycles(active, total / (active * BLOCKS_PER_WORKER),
+				"mem_slab.alloc_free", "Allocate and free a block, per CPU");
+}
+
+/* Every block must be allocatable again, wherever it was freed */
+static unsigned int slab_drain(void)
+{
+	static void *blocks[BLOCK_COUNT];
+	unsigned int count = 0;
+
+	while ((count < BLOCK_COUNT) &&
+	       (k_mem_slab_alloc(&bench_slab, &blocks[count], K_NO_WAIT) == 0)) {
+		count++;
+	}
+
+	for (unsigned int i = 0; i < count; i++) {
+		k_mem_slab_free(&bench_slab, blocks[i]);
+	}
+
+	if (count != BLOCK_COUNT) {
+		printk("Allocated %u of %u blocks\n", count, BLOCK_COUNT);
+	}
+
+	return count;
+}
+
+int main(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	int ret = 0;
+
+	timing_init();
+
+	printk("Time Measurements for %s memory slab\n",
+	       IS_ENABLED(CONFIG_MEM_SLAB_CPU_CACHE) ? "per-CPU cached" : "locked");
+	printk("Timing results: Clock frequency: %u MHz\n",
+	       timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int active = 1; active <= num_cpus; active++) {
+		test_alloc_free(active);
+	}
+
+	timing_stop();
+
+	/* Cached blocks do not count as used */
+	if (k_mem_slab_num_used_get(&bench_slab) != 0) {
+		printk("%u blocks reported as used\n",
+		       k_mem_slab_num_used_get(&bench_slab));
+		ret = -EIO;
+	}
+
+	if (slab_drain() != BLOCK_COUNT) {
+		ret = -EIO;
+	}
+
+	TC_END_REPORT(ret < 0 ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
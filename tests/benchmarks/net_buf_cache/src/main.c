@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the cost of allocating and freeing
+ * network buffers while a varying number of CPUs use the same pool at once,
+ * which shows the contention on the pool free list.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/net_buf.h>
+#include "../../common/benchmark_report.h"
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+#define BUF_SIZE  128
+#define BUF_COUNT (CONFIG_MP_MAX_NUM_CPUS * 4 * CONFIG_BENCHMARK_BURST)
+
+#define BUFS_PER_WORKER (CONFIG_BENCHMARK_NUM_ITERATIONS * CONFIG_BENCHMARK_BURST)
+
+NET_BUF_POOL_FIXED_DEFINE(bench_pool, BUF_COUNT, BUF_SIZE, 0, NULL);
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stack, CONFIG_MP_MAX_NUM_CPUS,
+				   STACK_SIZE);
+static struct k_thread worker_thread[CONFIG_MP_MAX_NUM_CPUS];
+static uint64_t worker_cycles[CONFIG_MP_MAX_NUM_CPUS];
+
+/* Buffers passed from each producer to its consumer */
+static struct k_fifo pass_fifo[CONFIG_MP_MAX_NUM_CPUS / 2];
+
+static atomic_t start_flag;
+static K_SEM_DEFINE(done_sem, 0, CONFIG_MP_MAX_NUM_CPUS);
+
+static void wait_for_start(void)
+{
+	while (!atomic_get(&start_flag)) {
+		arch_spin_relax();
+	}
+}
+
+static void local_entry(void *p1, void *p2, void *p3)
+{
+	unsigned int id = (unsigned int)(uintptr_t)p1;
+	struct net_buf *bufs[CONFIG_BENCHMARK_BURST];
+	timing_t start;
+	timing_t finish;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	wait_for_start();
+
+	start = timing_counter_get();
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		for (unsigned int j = 0; j < CONFIG_BENCHMARK_BURST; j++) {
+			bufs[j] = net_buf_alloc(&bench_pool, K_FOREVER);
+		}
+
+		for (unsigned int j = 0; j < CONFIG_BENCHMARK_BURST; j++) {
+			net_buf_unref(bufs[j]);
+		}
+	}
+	finish = timing_counter_get();
+
+	worker_cycles[id] = timing_cycles_get(&start, &finish);
+
+	k_sem_give(&done_sem);
+}
+
+static void producer_entry(void *p1, void *p2, void *p3)
+{
+	struct k_fifo *fifo = &pass_fifo[(uintptr_t)p1];
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	wait_for_start();
+
+	for (unsigned int i = 0; i < BUFS_PER_WORKER; i++) {
+		k_fifo_put(fifo, net_buf_alloc(&bench_pool, K_FOREVER));
+	}
+
+	k_sem_give(&done_sem);
+}
+
+static void consumer_entry(void *p1, void *p2, void *p3)
+{
+	unsigned int pair = (unsigned int)(uintptr_t)p1;
+	struct k_fifo *fifo = &pass_fifo[pair];
+	timing_t start;
+	timing_t finish;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	wait_for_start();
+
+	start = timing_counter_get();
+	for (unsigned int i = 0; i < BUFS_PER_WORKER; i++) {
+		net_buf_unref(k_fifo_get(fifo, K_FOREVER));
+	}
+	finish = timing_counter_get();
+
+	worker_cycles[pair] = timing_cycles_get(&start, &finish);
+
+	k_sem_give(&done_sem);
+}
+
+static void workers_run(unsigned int num_threads)
+{
+	/* Let the workers on the other CPUs reach the start line, the one
+	 * sharing this CPU starts once we block.
+	 */
+	k_busy_wait(10000);
+	atomic_set(&start_flag, 1);
+
+	for (unsigned int i = 0; i < num_threads; i++) {
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+
+	for (unsigned int i = 0; i < num_threads; i++) {
+		k_thread_join(&worker_thread[i], K_FOREVER);
+	}
+
+	atomic_clear(&start_flag);
+}
+
+static void test_local(unsigned int active)
+{
+	uint64_t total = 0;
+
+	for (unsigned int i = 0; i < active; i++) {
+		k_thread_create(&worker_thread[i], worker_stack[i], STACK_SIZE,
+				local_entry, (void *)(uintptr_t)i, NULL, NULL,
+				K_PRIO_PREEMPT(10), 0, K_NO_WAIT);
+	}
+
+	workers_run(active);
+
+	for (unsigned int i = 0; i < active; i++) {
+		total += worker_cycles[i];
+	}
+
+	benchmark_report_cycles(active, total / (active * BUFS_PER_WORKER),
+				"net_buf.local", "Allocate and free a buffer, per CPU");
+}
+
+static void test_remote(unsigned int pairs)
+{
+	uint64_t total = 0;
+
+	for (unsigned int i = 0; i < pairs; i++) {
+		k_fifo_init(&pass_fifo[i]);
+
+		k_thread_create(&worker_thread[2 * i], worker_stack[2 * i],
+				STACK_SIZE, producer_entry,
+				(void *)(uintptr_t)i, NULL, NULL,
+				K_PRIO_PREEMPT(10), 0, K_NO_WAIT);
+		k_thread_create(&worker_thread[2 * i + 1],
+				worker_stack[2 * i + 1], STACK_SIZE,
+				consumer_entry, (void *)(uintptr_t)i, NULL, NULL,
+				K_PRIO_PREEMPT(10), 0, K_NO_WAIT);
+	}
+
+	workers_run(2 * pairs);
+
+	for (unsigned int i = 0; i < pairs; i++) {
+		total += worker_cycles[i];
+	}
+
+	benchmark_report_cycles(pairs, total / (pairs * BUFS_PER_WORKER),
+				"net_buf.remote",
+				"Allocate a buffer and free it on another CPU, per pair");
+}
+
+/* Every buffer must be allocatable again, wherever it was freed */
+static unsigned int pool_drain(void)
+{
+	unsigned int count = 0;
+	struct net_buf *buf;
+	sys_slist_t bufs;
+
+	sys_slist_init(&bufs);
+
+	while ((buf = net_buf_alloc(&bench_pool, K_NO_WAIT)) != NULL) {
+		sys_slist_append(&bufs, &buf->node);
+		count++;
+	}
+
+	while ((buf = (struct net_buf *)sys_slist_get(&bufs)) != NULL) {
+		net_buf_unref(buf);
+	}
+
+	if (count != BUF_COUNT) {
+		printk("Allocated %u of %u buffers\n", count, BUF_COUNT);
+	}
+
+	return count;
+}
+
+int main(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	int ret = 0;
+
+	timing_init();
+
+	printk("Time Measurements for %s network buffer pool\n",
+	       IS_ENABLED(CONFIG_NET_BUF_POOL_CPU_CACHE) ? "per-CPU cached" : "shared");
+	printk("Timing results: Clock frequency: %u MHz\n",
+	       timing_freq_get_mhz());
+
+	timing_start();
+
+	for (unsigned int active = 1; active <= num_cpus; active++) {
+		test_local(active);
+	}
+
+	for (unsigned int pairs = 1; pairs <= num_cpus / 2; pairs++) {
+		test_remote(pairs);
+	}
+
+	timing_stop();
+
+	if (pool_drain() != BUF_COUNT) {
+		ret = -EIO;
+	}
+
+	TC_END_REPORT(ret < 0 ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
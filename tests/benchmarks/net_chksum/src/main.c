@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the length of time required by
+ * calc_chksum() to calculate the Internet checksum of buffers of various
+ * sizes and alignments, and the resulting throughput in bytes per cycle.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#include "net_private.h"
+#include "../../common/benchmark_report.h"
+
+#define MAX_LEN 4096
+
+static const size_t lengths[] = { 20, 64, 256, 576, 1500, 4096 };
+
+/* One spare word so that the data can start at an odd address */
+static uint32_t buffer[(MAX_LEN / sizeof(uint32_t)) + 1];
+
+static uint64_t cycles[CONFIG_BENCHMARK_NUM_ITERATIONS];
+
+/* Plain RFC 1071 sum of 16-bit big endian words */
+static uint16_t calc_chksum_ref(uint16_t sum, const uint8_t *data, size_t len)
+{
+	uint32_t acc = sum;
+
+	for (; len > 1; len -= 2, data += 2) {
+		acc += (data[0] << 8) | data[1];
+	}
+
+	if (len == 1) {
+		acc += data[0] << 8;
+	}
+
+	while ((acc >> 16) != 0) {
+		acc = (acc & 0xffff) + (acc >> 16);
+	}
+
+	return acc;
+}
+
+static int test_chksum(const uint8_t *data, size_t len)
+{
+	volatile uint16_t sum;
+	timing_t start;
+	timing_t finish;
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		start = timing_counter_get();
+		sum = calc_chksum(0, data, len);
+		finish = timing_counter_get();
+
+		cycles[i] = timing_cycles_get(&start, &finish);
+	}
+
+	if (sum != calc_chksum_ref(0, data, len)) {
+		printk("Checksum 0x%04x of %zu bytes at %p, expected 0x%04x\n",
+		       sum, len, data, calc_chksum_ref(0, data, len));
+		return -EIO;
+	}
+
+	return 0;
+}
+
+static void report_stats(size_t len, const char *tag, const char *str)
+{
+	uint64_t average;
+	uint32_t centi_bytes_per_cycle;
+
+	average = benchmark_report_stats(len, "bytes", cycles,
+					 CONFIG_BENCHMARK_NUM_ITERATIONS, tag, str);
+	centi_bytes_per_cycle = (uint32_t)((len * 100U) / MAX(average, 1));
+
+	printk("    Throughput : %u.%02u bytes/cycle\n",
+	       centi_bytes_per_cycle / 100U, centi_bytes_per_cycle % 100U);
+}
+
+int main(void)
+{
+	uint8_t *data = (uint8_t *)buffer;
+	uint32_t rand_state = BENCHMARK_RAND_SEED;
+	int ret = 0;
+
+	/* Same data summed on each run */
+	for (size_t i = 0; i < sizeof(buffer); i++) {
+		data[i] = benchmark_rand(&rand_state);
+	}
+
+	timing_init();
+
+	printk("Time Measurements for %s Internet checksum\n",
+	       IS_ENABLED(CONFIG_NET_IP_CHKSUM_WIDE) ? "wide" : "generic");
+	printk("Timing results: Clock frequency: %u MHz\n",
+	       timing_freq_get_mhz());
+
+	timing_start();
+
+	for (size_t i = 0; (ret == 0) && (i < ARRAY_SIZE(lengths)); i++) {
+		ret = test_chksum(data, lengths[i]);
+		if (ret == 0) {
+			report_stats(lengths[i], "chksum.aligned",
+				     "Checksum of aligned data");
+			ret = test_chksum(data + 1, lengths[i]);
+		}
+
+		if (ret == 0) {
+			report_stats(lengths[i], "chksum.odd",
+				     "Checksum of data at an odd address");
+		}
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(ret < 0 ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the length of time required by
+ * net_conn_input() to find the handler of a received UDP packet while a
+ * varying number of connection handlers are registered. The packets are
+ * handed to net_conn_input() directly and the handlers do not consume
+ * them, so only the connection lookup is measured.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/udp.h>
+
+#include "connection.h"
+#include "../../common/benchmark_report.h"
+
+#define LOCAL_PORT	4242
+#define LISTEN_PORT	7
+#define REMOTE_PORT	1024
+
+static struct net_conn_handle *handles[CONFIG_NET_MAX_CONN];
+
+static uint64_t connected_cycles[CONFIG_BENCHMARK_NUM_ITERATIONS];
+static uint64_t listener_cycles[CONFIG_BENCHMARK_NUM_ITERATIONS];
+
+static struct net_ipv4_hdr ipv4_hdr;
+static struct net_udp_hdr udp_hdr;
+static struct net_pkt *pkt;
+
+static unsigned int delivered;
+/* Same connections looked up on each run */
+static uint32_t rand_state = BENCHMARK_RAND_SEED;
+
+static enum net_verdict conn_cb(struct net_conn *conn, struct net_pkt *p,
+				union net_ip_header *ip_hdr,
+				union net_proto_header *proto_hdr,
+				void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(p);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	/* Keep the packet, it is looked up again by the next iteration */
+	delivered++;
+
+	return NET_OK;
+}
+
+/* Remote end of the connected handler @a i, 192.0.2.x / 1024 + i */
+static void remote_addr_get(unsigned int i, struct sockaddr_in *addr)
+{
+	addr->sin_family = AF_INET;
+	addr->sin_addr.s4_addr[0] = 192;
+	addr->sin_addr.s4_addr[1] = 0;
+	addr->sin_addr.s4_addr[2] = 2;
+	addr->sin_addr.s4_addr[3] = 1 + (i % 250);
+}
+
+static int conns_register(unsigned int num_conns)
+{
+	struct sockaddr_in local = {
+		.sin_family = AF_INET,
+		.sin_addr = { { { 198, 51, 100, 1 } } },
+	};
+	struct sockaddr_in remote;
+	int ret;
+
+	/* The listener is registered first, so that it is the last one
+	 * on the list of used connections.
+	 */
+	ret = net_conn_register(IPPROTO_UDP, AF_INET, NULL,
+				(struct sockaddr *)&local, 0, LISTEN_PORT,
+				NULL, conn_cb, NULL, &handles[0]);
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (unsigned int i = 1; i < num_conns; i++) {
+		remote_addr_get(i, &remote);
+
+		ret = net_conn_register(IPPROTO_UDP, AF_INET,
+					(struct sockaddr *)&remote,
+					(struct sockaddr *)&local,
+					REMOTE_PORT + i, LOCAL_PORT,
+					NULL, conn_cb, NULL, &handles[i]);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static void conns_unregister(unsigned int num_conns)
+{
+	for (unsigned int i = 0; i < num_conns; i++) {
+		if (handles[i] != NULL) {
+			net_conn_unregister(handles[i]);
+			handles[i] = NULL;
+		}
+	}
+}
+
+static uint64_t lookup(unsigned int i, uint16_t src_port, uint16_t dst_port)
+{
+	union net_ip_header ip_hdr = { .ipv4 = &ipv4_hdr };
+	union net_proto_header proto_hdr = { .udp = &udp_hdr };
+	struct sockaddr_in remote;
+	timing_t start;
+	timing_t finish;
+
+	remote_addr_get(i, &remote);
+	net_ipv4_addr_copy_raw(ipv4_hdr.src, remote.sin_addr.s4_addr);
+	udp_hdr.src_port = htons(src_port);
+	udp_hdr.dst_port = htons(dst_port);
+
+	start = timing_counter_get();
+	(void)net_conn_input(pkt, &ip_hdr, IPPROTO_UDP, &proto_hdr);
+	finish = timing_counter_get();
+
+	return timing_cycles_get(&start, &finish);
+}
+
+static void test_lookup(unsigned int num_conns)
+{
+	unsigned int i;
+
+	for (unsigned int n = 0; n < CONFIG_BENCHMARK_NUM_ITERATIONS; n++) {
+		if (num_conns > 1) {
+			i = 1 + benchmark_rand(&rand_state) % (num_conns - 1);
+			connected_cycles[n] = lookup(i, REMOTE_PORT + i,
+						     LOCAL_PORT);
+		}
+
+		i = benchmark_rand(&rand_state) % 250;
+		listener_cycles[n] = lookup(i, REMOTE_PORT + i, LISTEN_PORT);
+	}
+}
+
+int main(void)
+{
+	unsigned int num_conns;
+	unsigned int expected = 0;
+	int ret = 0;
+
+	pkt = net_pkt_alloc_on_iface(net_if_get_default(), K_FOREVER);
+	net_pkt_set_family(pkt, AF_INET);
+
+	ipv4_hdr.dst[0] = 198;
+	ipv4_hdr.dst[1] = 51;
+	ipv4_hdr.dst[2] = 100;
+	ipv4_hdr.dst[3] = 1;
+
+	timing_init();
+
+	printk("Time Measurements for %s connection lookup\n",
+	       IS_ENABLED(CONFIG_NET_CONN_HASH) ? "hashed" : "list");
+	printk("Timing results: Clock frequency: %u MHz\n",
+	       timing_freq_get_mhz());
+
+	timing_start();
+
+	for (num_conns = 1; num_conns <= CONFIG_NET_MAX_CONN; num_conns *= 4) {
+		ret = conns_register(num_conns);
+		if (ret < 0) {
+			printk("Cannot register %u connections (%d)\n",
+			       num_conns, ret);
+			conns_unregister(num_conns);
+			break;
+		}
+
+		test_lookup(num_conns);
+
+		if (num_conns > 1) {
+			(void)benchmark_report_stats(num_conns, "conns", connected_cycles,
+						     CONFIG_BENCHMARK_NUM_ITERATIONS,
+						     "conn.connected",
+						     "Look up a connected handler");
+			expected += CONFIG_BENCHMARK_NUM_ITERATIONS;
+		}
+
+		(void)benchmark_report_stats(num_conns, "conns", listener_cycles,
+					     CONFIG_BENCHMARK_NUM_ITERATIONS,
+					     "conn.listener", "Look up a listening handler");
+		expected += CONFIG_BENCHMARK_NUM_ITERATIONS;
+
+		conns_unregister(num_conns);
+	}
+
+	timing_stop();
+
+	net_pkt_unref(pkt);
+
+	if (delivered != expected) {
+		printk("Delivered %u of %u packets\n", delivered, expected);
+		ret = -EIO;
+	}
+
+	TC_END_REPORT(ret < 0 ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the worst case and the average time
+ * of nvs_write(), over enough writes to go through the garbage collection of
+ * every sector several times.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/fs/nvs.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/flash_map.h>
+#include "../../common/benchmark_report.h"
+
+#define NVS_PARTITION		storage_partition
+#define NVS_PARTITION_DEVICE	FIXED_PARTITION_DEVICE(NVS_PARTITION)
+#define NVS_PARTITION_OFFSET	FIXED_PARTITION_OFFSET(NVS_PARTITION)
+
+#define DATA_LEN 32
+
+static struct nvs_fs fs;
+
+static int nvs_setup(void)
+{
+	struct flash_pages_info info;
+	int rc;
+
+	fs.flash_device = NVS_PARTITION_DEVICE;
+	if (!device_is_ready(fs.flash_device)) {
+		printk("Flash device %s is not ready\n", fs.flash_device->name);
+		return -ENODEV;
+	}
+
+	fs.offset = NVS_PARTITION_OFFSET;
+	rc = flash_get_page_info_by_offs(fs.flash_device, fs.offset, &info);
+	if (rc != 0) {
+		printk("Unable to get page info (%d)\n", rc);
+		return rc;
+	}
+
+	fs.sector_size = info.size;
+	fs.sector_count = CONFIG_BENCHMARK_SECTOR_COUNT;
+
+	rc = nvs_mount(&fs);
+	if (rc == 0) {
+		rc = nvs_clear(&fs);
+	}
+	if (rc == 0) {
+		rc = nvs_mount(&fs);
+	}
+	if (rc != 0) {
+		printk("Unable to set up NVS (%d)\n", rc);
+	}
+
+	return rc;
+}
+
+/* Every write must succeed and the last value of each id must be read back */
+static int test_write(void)
+{
+	uint8_t data[DATA_LEN];
+	uint8_t rd_data[DATA_LEN];
+	timing_t start;
+	timing_t finish;
+	uint64_t cycles;
+	uint64_t total = 0U;
+	uint64_t worst = 0U;
+	ssize_t rc;
+
+	for (uint32_t i = 0; i < CONFIG_BENCHMARK_NUM_WRITES; i++) {
+		memset(data, (uint8_t)i, sizeof(data));
+
+		start = timing_counter_get();
+		rc = nvs_write(&fs, i % CONFIG_BENCHMARK_NUM_IDS, data, sizeof(data));
+		finish = timing_counter_get();
+
+		if (rc != sizeof(data)) {
+			printk("Write %u failed (%d)\n", i, (int)rc);
+			return -EIO;
+		}
+
+		cycles = timing_cycles_get(&start, &finish);
+		total += cycles;
+		worst = MAX(worst, cycles);
+
+#if defined(CONFIG_NVS_GC_INCREMENTAL) && !defined(CONFIG_NVS_GC_WORKQUEUE)
+		while (nvs_gc_step(&fs) > 0) {
+		}
+#endif
+	}
+
+	benchmark_report_cycles(CONFIG_BENCHMARK_NUM_WRITES, worst, "nvs.write.worst",
+				"Worst case of a write");
+	benchmark_report_cycles(CONFIG_BENCHMARK_NUM_WRITES, total / CONFIG_BENCHMARK_NUM_WRITES,
+				"nvs.write.average", "Average cost of a write");
+
+	for (uint32_t id = 0; id < CONFIG_BENCHMARK_NUM_IDS; id++) {
+		uint32_t last = CONFIG_BENCHMARK_NUM_WRITES - 1U;
+
+		last -= (last % CONFIG_BENCHMARK_NUM_IDS + CONFIG_BENCHMARK_NUM_IDS - id) %
+			CONFIG_BENCHMARK_NUM_IDS;
+		memset(data, (uint8_t)last, sizeof(data));
+
+		rc = nvs_read(&fs, id, rd_data, sizeof(rd_data));
+		if ((rc != sizeof(rd_data)) || (memcmp(data, rd_data, sizeof(data)) != 0)) {
+			printk("Id %u does not hold its last value (%d)\n", id, (int)rc);
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	int ret;
+
+	ret = nvs_setup();
+	if (ret != 0) {
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	timing_init();
+
+	printk("Time Measurements for nvs_write with %s garbage collection\n",
+	       IS_ENABLED(CONFIG_NVS_GC_INCREMENTAL) ? "incremental" : "synchronous");
+	printk("Timing results: Clock frequency: %u MHz\n",
+	       timing_freq_get_mhz());
+
+	timing_start();
+
+	ret = test_write();
+
+	timing_stop();
+
+	TC_END_REPORT(ret < 0 ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
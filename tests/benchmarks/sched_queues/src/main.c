@@ -242,6 +242,9 @@ int main(void)
 	       IS_ENABLED(CONFIG_SCHED_DUMB) ? "dumb" :
 	       IS_ENABLED(CONFIG_SCHED_SCALABLE) ? "scalable" : "multiq");
 	printk("Timing results: Clock frequency: %u MHz\n", freq);
+	printk("Run queues: %s, %u CPUs\n",
+	       IS_ENABLED(CONFIG_SCHED_CPU_RUNQ) ? "per CPU" : "global",
+	       arch_num_cpus());
 
 	start_threads(CONFIG_BENCHMARK_NUM_THREADS);
 
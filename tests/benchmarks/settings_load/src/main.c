@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure how long it takes to load the
+ * settings stored in the NVS backend, as done at boot, in full and for a
+ * subtree.
+ */
+
+#include <stdlib.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/settings/settings.h>
+#include "../../common/benchmark_report.h"
+
+static uint32_t set_cnt;
+static uint32_t mismatch_cnt;
+
+static int bench_set(const char *name, size_t len, settings_read_cb read_cb,
+		     void *cb_arg)
+{
+	unsigned long idx = strtoul(name, NULL, 10);
+	uint32_t value;
+	ssize_t rc;
+
+	if (len != sizeof(value)) {
+		mismatch_cnt++;
+		return -EINVAL;
+	}
+
+	rc = read_cb(cb_arg, &value, sizeof(value));
+	if ((rc != sizeof(value)) || (value != idx * 3U)) {
+		mismatch_cnt++;
+	}
+
+	set_cnt++;
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(bench, "bench", NULL, bench_set, NULL, NULL);
+
+static int settings_fill(void)
+{
+	char name[SETTINGS_MAX_NAME_LEN];
+	uint32_t value;
+	int rc;
+
+	for (uint32_t i = 0; i < CONFIG_BENCHMARK_NUM_SETTINGS; i++) {
+		snprintk(name, sizeof(name), "bench/%u", i);
+		value = i * 3U;
+
+		rc = settings_save_one(name, &value, sizeof(value));
+		if (rc != 0) {
+			printk("Failed to save %s (%d)\n", name, rc);
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+/* Every stored setting must reach the handler with its value */
+static int test_load(const char *subtree)
+{
+	timing_t start;
+	timing_t finish;
+	uint64_t cycles;
+	int rc;
+
+	set_cnt = 0;
+	mismatch_cnt = 0;
+
+	start = timing_counter_get();
+	rc = (subtree != NULL) ? settings_load_subtree(subtree) : settings_load();
+	finish = timing_counter_get();
+
+	cycles = timing_cycles_get(&start, &finish);
+
+	if (subtree != NULL) {
+		benchmark_report_cycles(CONFIG_BENCHMARK_NUM_SETTINGS, cycles,
+					"settings.load_subtree", "Load a subtree of settings");
+	} else {
+		benchmark_report_cycles(CONFIG_BENCHMARK_NUM_SETTINGS, cycles, "settings.load",
+					"Load all settings");
+	}
+
+	benchmark_report_cycles(CONFIG_BENCHMARK_NUM_SETTINGS,
+				cycles / CONFIG_BENCHMARK_NUM_SETTINGS,
+				(subtree != NULL) ? "settings.load_subtree.per_setting" :
+						    "settings.load.per_setting",
+				"Average cost of a setting");
+
+	if ((rc != 0) || (set_cnt != CONFIG_BENCHMARK_NUM_SETTINGS) || (mismatch_cnt != 0)) {
+		printk("Load returned %d, %u settings set, %u mismatches\n", rc, set_cnt,
+		       mismatch_cnt);
+		return -EIO;
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	int ret;
+
+	ret = settings_subsys_init();
+	if (ret == 0) {
+		ret = settings_fill();
+	}
+
+	if (ret != 0) {
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	timing_init();
+
+	printk("Time Measurements for settings load %s\n",
+	       IS_ENABLED(CONFIG_SETTINGS_NVS_LOAD_INDEX) ? "with index" : "by ID");
+	printk("Timing results: Clock frequency: %u MHz\n",
+	       timing_freq_get_mhz());
+
+	timing_start();
+
+	ret = test_load(NULL);
+	if (ret == 0) {
+		ret = test_load("bench");
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(ret < 0 ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
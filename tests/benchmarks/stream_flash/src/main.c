@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the throughput of stream writes to
+ * flash, fed in chunks by a simulated transport as during a firmware update.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/storage/stream_flash.h>
+#include "../../common/benchmark_report.h"
+
+#define STREAM_PARTITION	slot1_partition
+#define STREAM_PARTITION_DEVICE	FIXED_PARTITION_DEVICE(STREAM_PARTITION)
+#define STREAM_PARTITION_OFFSET	FIXED_PARTITION_OFFSET(STREAM_PARTITION)
+#define STREAM_PARTITION_SIZE	FIXED_PARTITION_SIZE(STREAM_PARTITION)
+
+#define NUM_CHUNKS DIV_ROUND_UP(CONFIG_BENCHMARK_IMAGE_SIZE, CONFIG_BENCHMARK_CHUNK_SIZE)
+
+BUILD_ASSERT(CONFIG_BENCHMARK_IMAGE_SIZE <= STREAM_PARTITION_SIZE,
+	     "Image does not fit in the partition");
+
+static struct stream_flash_ctx ctx;
+static uint8_t buf[CONFIG_BENCHMARK_BUF_SIZE];
+#if CONFIG_BENCHMARK_WRITE_BEHIND_BUFFERS > 1
+static uint8_t wb_bufs[CONFIG_BENCHMARK_BUF_SIZE * (CONFIG_BENCHMARK_WRITE_BEHIND_BUFFERS - 1)];
+#endif
+static uint8_t chunk[CONFIG_BENCHMARK_CHUNK_SIZE];
+
+static int stream_setup(void)
+{
+	int rc;
+
+	rc = stream_flash_init(&ctx, STREAM_PARTITION_DEVICE, buf, sizeof(buf),
+			       STREAM_PARTITION_OFFSET, CONFIG_BENCHMARK_IMAGE_SIZE, NULL);
+#if CONFIG_BENCHMARK_WRITE_BEHIND_BUFFERS > 1
+	if (rc == 0) {
+		rc = stream_flash_write_behind(&ctx, wb_bufs,
+					       CONFIG_BENCHMARK_WRITE_BEHIND_BUFFERS - 1);
+	}
+#endif
+	if (rc != 0) {
+		printk("Unable to set up stream flash (%d)\n", rc);
+	}
+
+	return rc;
+}
+
+/* Every byte of the stream must be found in flash once flushed */
+static int verify_stream(void)
+{
+	size_t len;
+	int rc;
+
+	for (size_t off = 0; off < CONFIG_BENCHMARK_IMAGE_SIZE; off += len) {
+		len = MIN(sizeof(chunk), CONFIG_BENCHMARK_IMAGE_SIZE - off);
+
+		rc = flash_read(STREAM_PARTITION_DEVICE, STREAM_PARTITION_OFFSET + off, chunk,
+				len);
+		if (rc != 0) {
+			return rc;
+		}
+
+		for (size_t i = 0; i < len; i++) {
+			if (chunk[i] != (uint8_t)(off + i)) {
+				printk("Mismatch at offset %zu\n", off + i);
+				return -EIO;
+			}
+		}
+	}
+
+	return 0;
+}
+
+static int test_stream(void)
+{
+	timing_t start;
+	timing_t finish;
+	uint64_t cycles;
+	uint32_t ns;
+	size_t len;
+	int rc = 0;
+
+	start = timing_counter_get();
+
+	for (size_t off = 0; (off < CONFIG_BENCHMARK_IMAGE_SIZE) && (rc == 0); off += len) {
+		len = MIN(sizeof(chunk), CONFIG_BENCHMARK_IMAGE_SIZE - off);
+
+		/* Wait for the next chunk, as a transport would */
+		k_usleep(CONFIG_BENCHMARK_CHUNK_DELAY_US);
+		for (size_t i = 0; i < len; i++) {
+			chunk[i] = (uint8_t)(off + i);
+		}
+
+		rc = stream_flash_buffered_write(&ctx, chunk, len,
+						 (off + len) == CONFIG_BENCHMARK_IMAGE_SIZE);
+	}
+
+	finish = timing_counter_get();
+
+	if (rc != 0) {
+		printk("Stream write failed (%d)\n", rc);
+		return rc;
+	}
+
+	cycles = timing_cycles_get(&start, &finish);
+	ns = (uint32_t)timing_cycles_to_ns(cycles);
+
+	benchmark_report_cycles(NUM_CHUNKS, cycles, "stream_flash.write", "Write the whole stream");
+	benchmark_report_cycles(NUM_CHUNKS, cycles / NUM_CHUNKS, "stream_flash.write.per_chunk",
+				"Average time of a chunk");
+	printk("Throughput: %u bytes/s\n",
+	       (uint32_t)(((uint64_t)CONFIG_BENCHMARK_IMAGE_SIZE * NSEC_PER_SEC) / MAX(ns, 1U)));
+
+	return verify_stream();
+}
+
+int main(void)
+{
+	int ret;
+
+	ret = stream_setup();
+	if (ret != 0) {
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	timing_init();
+
+	printk("Time Measurements for stream flash with %u write buffer(s)\n",
+	       CONFIG_BENCHMARK_WRITE_BEHIND_BUFFERS);
+	printk("Timing results: Clock frequency: %u MHz\n",
+	       timing_freq_get_mhz());
+
+	timing_start();
+
+	ret = test_stream();
+
+	timing_stop();
+
+	TC_END_REPORT(ret < 0 ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
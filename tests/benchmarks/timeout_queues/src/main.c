@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the length of time required to add
+ * a timeout to, abort a timeout from and expire a timeout out of the kernel
+ * timeout queue while it holds a varying number of other pending timeouts.
+ * The timeouts are dummy _timeout structures whose expiry function does
+ * nothing, so only the timeout queue itself is measured.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/drivers/timer/system_timer.h>
+#include <timeout_q.h>
+#include "utils.h"
+#include "../../common/benchmark_report.h"
+
+/* Spread of the expiry of the pending timeouts, in ticks */
+#define BACKGROUND_SPREAD (1U << 20)
+
+static struct _timeout background[CONFIG_BENCHMARK_NUM_TIMEOUTS];
+static struct _timeout measured[CONFIG_BENCHMARK_NUM_ITERATIONS];
+
+static uint64_t add_cycles[CONFIG_BENCHMARK_NUM_ITERATIONS];
+static uint64_t abort_cycles[CONFIG_BENCHMARK_NUM_ITERATIONS];
+static uint64_t announce_cycles[CONFIG_BENCHMARK_NUM_ITERATIONS];
+
+static unsigned int expired;
+/* Same expiry ticks on each run */
+static uint32_t rand_state = BENCHMARK_RAND_SEED;
+
+static void dummy_expiry(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	expired++;
+}
+
+static void background_add(unsigned int num_timeouts)
+{
+	for (unsigned int i = 0; i < num_timeouts; i++) {
+		z_init_timeout(&background[i]);
+		z_add_timeout(&background[i], dummy_expiry,
+			      K_TICKS(CONFIG_BENCHMARK_NUM_ITERATIONS +
+				      benchmark_rand(&rand_state) % BACKGROUND_SPREAD));
+	}
+}
+
+static void background_abort(unsigned int num_timeouts)
+{
+	for (unsigned int i = 0; i < num_timeouts; i++) {
+		z_abort_timeout(&background[i]);
+	}
+}
+
+static void test_add_abort(void)
+{
+	timing_t start;
+	timing_t finish;
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		z_init_timeout(&measured[i]);
+
+		start = timing_counter_get();
+		z_add_timeout(&measured[i], dummy_expiry,
+			      K_TICKS(benchmark_rand(&rand_state) % BACKGROUND_SPREAD));
+		finish = timing_counter_get();
+
+		add_cycles[i] = timing_cycles_get(&start, &finish);
+	}
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		start = timing_counter_get();
+		z_abort_timeout(&measured[i]);
+		finish = timing_counter_get();
+
+		abort_cycles[i] = timing_cycles_get(&start, &finish);
+	}
+}
+
+/**
+ * Arm one timeout per upcoming tick and announce the ticks one by one, the
+ * way a tickful timer driver does, so each announcement expires a single
+ * timeout.
+ */
+static void test_announce(void)
+{
+	timing_t start;
+	timing_t finish;
+	unsigned int key;
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		z_init_timeout(&measured[i]);
+		z_add_timeout(&measured[i], dummy_expiry, K_TICKS(i));
+	}
+
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		key = irq_lock();
+		start = timing_counter_get();
+		sys_clock_announce(1);
+		finish = timing_counter_get();
+		irq_unlock(key);
+
+		announce_cycles[i] = timing_cycles_get(&start, &finish);
+	}
+
+	/* Anything not expired because a real tick slipped in between */
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		z_abort_timeout(&measured[i]);
+	}
+}
+
+int main(void)
+{
+	unsigned int num_timeouts;
+
+	timing_init();
+
+	printk("Time Measurements for %s%s timeout queue\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_PER_CPU) ? "per-CPU " : "",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_WHEEL) ? "timer wheel" : "dlist");
+	printk("Timing results: Clock frequency: %u MHz\n",
+	       timing_freq_get_mhz());
+
+	timing_start();
+
+	for (num_timeouts = 1; num_timeouts <= CONFIG_BENCHMARK_NUM_TIMEOUTS;
+	     num_timeouts *= 10) {
+		background_add(num_timeouts);
+
+		test_add_abort();
+		(void)benchmark_report_stats(num_timeouts, "pending timeouts",
+					     add_cycles, CONFIG_BENCHMARK_NUM_ITERATIONS,
+					     "timeout.add", "Add a timeout");
+		(void)benchmark_report_stats(num_timeouts, "pending timeouts",
+					     abort_cycles, CONFIG_BENCHMARK_NUM_ITERATIONS,
+					     "timeout.abort", "Abort a timeout");
+
+		expired = 0;
+		test_announce();
+		(void)benchmark_report_stats(num_timeouts, "pending timeouts",
+					     announce_cycles, CONFIG_BENCHMARK_NUM_ITERATIONS,
+					     "timeout.announce",
+					     "Announce a tick expiring one timeout");
+		printk("Expired %u of %u timeouts\n", expired,
+		       CONFIG_BENCHMARK_NUM_ITERATIONS);
+
+		background_abort(num_timeouts);
+	}
+
+#ifdef CONFIG_SMP
+	test_smp_contention();
+#endif
+
+	timing_stop();
+
+	TC_END_REPORT(0);
+
+	return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file measures the cost of adding and aborting timeouts while a
+ * varying number of CPUs are doing the same at once, which shows the
+ * contention on the timeout queue lock(s). Each worker is pinned to its
+ * own CPU, so that with CONFIG_TIMEOUT_PER_CPU it always uses the queue
+ * of that CPU and the workers do not pile up on the same CPUs.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <timeout_q.h>
+#include "utils.h"
+#include "../../common/benchmark_report.h"
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/* Timeouts each worker keeps pending while measuring */
+#define WORKER_PENDING (CONFIG_BENCHMARK_NUM_TIMEOUTS / CONFIG_MP_MAX_NUM_CPUS)
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stack, CONFIG_MP_MAX_NUM_CPUS,
+				   STACK_SIZE);
+static struct k_thread worker_thread[CONFIG_MP_MAX_NUM_CPUS];
+
+static struct _timeout worker_pending[CONFIG_MP_MAX_NUM_CPUS][WORKER_PENDING + 1];
+static uint64_t worker_cycles[CONFIG_MP_MAX_NUM_CPUS];
+
+static atomic_t start_flag;
+static K_SEM_DEFINE(done_sem, 0, CONFIG_MP_MAX_NUM_CPUS);
+
+static void dummy_expiry(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+}
+
+static void worker_entry(void *p1, void *p2, void *p3)
+{
+	unsigned int id = (unsigned int)(uintptr_t)p1;
+	struct _timeout *pending = worker_pending[id];
+	struct _timeout *measured = &pending[WORKER_PENDING];
+	timing_t start;
+	timing_t finish;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (unsigned int i = 0; i < WORKER_PENDING; i++) {
+		z_init_timeout(&pending[i]);
+		z_add_timeout(&pending[i], dummy_expiry,
+			      K_TICKS(CONFIG_BENCHMARK_NUM_ITERATIONS + i));
+	}
+	z_init_timeout(measured);
+
+	while (!atomic_get(&start_flag)) {
+		arch_spin_relax();
+	}
+
+	start = timing_counter_get();
+	for (unsigned int i = 0; i < CONFIG_BENCHMARK_NUM_ITERATIONS; i++) {
+		z_add_timeout(measured, dummy_expiry, K_TICKS(i + id));
+		z_abort_timeout(measured);
+	}
+	finish = timing_counter_get();
+
+	worker_cycles[id] = timing_cycles_get(&start, &finish);
+
+	for (unsigned int i = 0; i < WORKER_PENDING; i++) {
+		z_abort_timeout(&pending[i]);
+	}
+
+	k_sem_give(&done_sem);
+}
+
+void test_smp_contention(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int active = 1; active <= num_cpus; active++) {
+		uint64_t total = 0;
+
+		atomic_clear(&start_flag);
+
+		for (unsigned int i = 0; i < active; i++) {
+			k_thread_create(&worker_thread[i], worker_stack[i],
+					STACK_SIZE, worker_entry,
+					(void *)(uintptr_t)i, NULL, NULL,
+					K_PRIO_PREEMPT(10), 0, K_FOREVER);
+			k_thread_cpu_pin(&worker_thread[i], i);
+			k_thread_start(&worker_thread[i]);
+		}
+
+		/* Let the workers on the other CPUs arm their pending
+		 * timeouts, the one sharing this CPU starts once we block.
+		 */
+		k_busy_wait(10000);
+		atomic_set(&start_flag, 1);
+
+		for (unsigned int i = 0; i < active; i++) {
+			k_sem_take(&done_sem, K_FOREVER);
+			k_thread_join(&worker_thread[i], K_FOREVER);
+			total += worker_cycles[i];
+		}
+
+		benchmark_report_cycles(active,
+					total / (active * CONFIG_BENCHMARK_NUM_ITERATIONS),
+					"timeout.smp.add_abort",
+					"Add and abort a timeout, per CPU");
+	}
+}
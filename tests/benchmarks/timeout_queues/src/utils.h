@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __BENCHMARK_TIMEOUT_QUEUES_UTILS_H
+#define __BENCHMARK_TIMEOUT_QUEUES_UTILS_H
+
+void test_smp_contention(void);
+
+#endif
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * This file contains tests that measure the latency from publishing a zbus
+ * message to its reception by a message subscriber, with the message copied
+ * or published from a loaned buffer.
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <zephyr/zbus/zbus.h>
+#include "../../common/benchmark_report.h"
+
+#define MAX_MSG_SIZE	1024
+#define SUB_STACK_SIZE	1024
+#define SUB_PRIORITY	K_PRIO_PREEMPT(5)
+#define PUB_PRIORITY	K_PRIO_PREEMPT(10)
+
+/* The channel's message, the subscriber's one and the one being built */
+#define LOANS		3
+
+ZBUS_MSG_SUBSCRIBER_DEFINE(msg_sub);
+
+#define BENCH_CHAN_DEFINE(_size)                                                                   \
+	struct msg_##_size {                                                                       \
+		uint8_t data[_size];                                                               \
+	};                                                                                         \
+	ZBUS_CHAN_DEFINE(chan_##_size, struct msg_##_size, NULL, NULL, ZBUS_OBSERVERS(msg_sub),   \
+			 ZBUS_MSG_INIT(0));                                                        \
+	ZBUS_LOAN_POOL_DEFINE(loan_pool_##_size, struct msg_##_size, LOANS)
+
+BENCH_CHAN_DEFINE(16);
+BENCH_CHAN_DEFINE(64);
+BENCH_CHAN_DEFINE(256);
+BENCH_CHAN_DEFINE(1024);
+
+static const struct zbus_channel *const chans[] = {&chan_16, &chan_64, &chan_256, &chan_1024};
+static struct net_buf_pool *const loan_pools[] = {&loan_pool_16, &loan_pool_64, &loan_pool_256,
+						  &loan_pool_1024};
+
+static uint8_t tx_msg[MAX_MSG_SIZE];
+static uint8_t rx_msg[MAX_MSG_SIZE];
+
+static volatile bool loaned;
+static timing_t received;
+static uint32_t checksum;
+static K_SEM_DEFINE(rx_sem, 0, 1);
+
+static void sub_thread(void *p1, void *p2, void *p3)
+{
+	const struct zbus_channel *chan;
+	struct net_buf *buf;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		if (loaned) {
+			if (zbus_sub_wait_msg_ref(&msg_sub, &chan, &buf, K_FOREVER) != 0) {
+				continue;
+			}
+			checksum += buf->data[buf->len - 1];
+			zbus_msg_release(buf);
+		} else {
+			if (zbus_sub_wait_msg(&msg_sub, &chan, rx_msg, K_FOREVER) != 0) {
+				continue;
+			}
+			checksum += rx_msg[zbus_chan_msg_size(chan) - 1];
+		}
+
+		received = timing_counter_get();
+		k_sem_give(&rx_sem);
+	}
+}
+
+K_THREAD_DEFINE(sub_tid, SUB_STACK_SIZE, sub_thread, NULL, NULL, NULL, SUB_PRIORITY, 0, 0);
+
+/* Returns the time from the start of the publishing to the reception */
+static int publish(const struct zbus_channel *chan, uint8_t seq, uint64_t *cycles)
+{
+	size_t size = zbus_chan_msg_size(chan);
+	struct net_buf *buf;
+	timing_t start;
+	int rc;
+
+	start = timing_counter_get();
+
+	if (loaned) {
+		rc = zbus_chan_loan(chan, &buf, K_FOREVER);
+		if (rc == 0) {
+			memset(buf->data, seq, size);
+			rc = zbus_chan_commit(chan, buf, K_FOREVER);
+		}
+	} else {
+		memset(tx_msg, seq, size);
+		rc = zbus_chan_pub(chan, tx_msg, K_FOREVER);
+	}
+
+	if (rc != 0) {
+		printk("Unable to publish %zu bytes (%d)\n", size, rc);
+		return rc;
+	}
+
+	k_sem_take(&rx_sem, K_FOREVER);
+
+	*cycles = timing_cycles_get(&start, &received);
+
+	return 0;
+}
+
+static int test_latency(bool loan)
+{
+	const char *tag = loan ? "zbus.loan" : "zbus.copy";
+	const char *str = loan ? "Loaned publish to receive, by message size" :
+				 "Copied publish to receive, by message size";
+	uint64_t total;
+	uint64_t cycles;
+	int rc;
+
+	loaned = loan;
+
+	for (size_t i = 0; i < ARRAY_SIZE(chans); i++) {
+		/* Let the subscriber switch to the publishing method */
+		rc = publish(chans[i], 0, &cycles);
+		if (rc != 0) {
+			return rc;
+		}
+
+		total = 0;
+		for (uint32_t n = 0; n < CONFIG_BENCHMARK_NUM_ITERATIONS; n++) {
+			rc = publish(chans[i], (uint8_t)n, &cycles);
+			if (rc != 0) {
+				return rc;
+			}
+			total += cycles;
+		}
+
+		benchmark_report_cycles(zbus_chan_msg_size(chans[i]),
+					total / CONFIG_BENCHMARK_NUM_ITERATIONS, tag, str);
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	int ret;
+
+	k_thread_priority_set(k_current_get(), PUB_PRIORITY);
+
+	for (size_t i = 0; i < ARRAY_SIZE(chans); i++) {
+		zbus_chan_set_loan_pool(chans[i], loan_pools[i]);
+	}
+
+	timing_init();
+
+	printk("Time Measurements for zbus publish to receive latency\n");
+	printk("Timing results: Clock frequency: %u MHz\n",
+	       timing_freq_get_mhz());
+
+	timing_start();
+
+	ret = test_latency(false);
+	if (ret == 0) {
+		ret = test_latency(true);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(ret < 0 ? TC_FAIL : TC_PASS);
+
+	return 0;
+}
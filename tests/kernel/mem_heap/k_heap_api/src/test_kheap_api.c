@@ -47,6 +47,15 @@ static void thread_alloc_heap(void *p1, void *p2, void *p3)
 	k_heap_free(&k_heap_test, p);
 }
 
+static void thread_realloc_heap(void *p1, void *p2, void *p3)
+{
+	char *p = (char *)k_heap_realloc(&k_heap_test, NULL, 8, K_FOREVER);
+
+	zassert_not_null(p, "k_heap_realloc failed to allocate memory");
+
+	k_heap_free(&k_heap_test, p);
+}
+
 static void thread_alloc_heap_null(void *p1, void *p2, void *p3)
 {
 	char *p;
@@ -291,3 +300,196 @@ ZTEST(k_heap_api, test_k_heap_calloc)
 
 	k_heap_free(&k_heap_test, p);
 }
+
+/**
+ * @brief Validate that blocks held by the per-CPU caches stay usable
+ *
+ * @ingroup kernel_kheap_api_tests
+ *
+ * @details Fill the heap with small blocks and free them, so that some of
+ * them end up in the cache of the current CPU, then check that an
+ * allocation needing most of the heap still succeeds and that small
+ * allocations are served from the cache again afterwards.
+ *
+ * @see k_heap_alloc(), k_heap_free(), k_heap_runtime_stats_get()
+ */
+ZTEST(k_heap_api, test_k_heap_cpu_cache)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_K_HEAP_CPU_CACHE);
+
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+	struct sys_memory_stats stats;
+	void *blocks[HEAP_SIZE / 16];
+	size_t hits;
+	int count = 0;
+	char *p;
+
+	while (count < ARRAY_SIZE(blocks)) {
+		blocks[count] = k_heap_alloc(&k_heap_test, 16, K_NO_WAIT);
+		if (blocks[count] == NULL) {
+			break;
+		}
+
+		count++;
+	}
+
+	zassert_true(count > CONFIG_K_HEAP_CPU_CACHE_DEPTH,
+		     "only %d small blocks allocated", count);
+
+	while (count > 0) {
+		k_heap_free(&k_heap_test, blocks[--count]);
+	}
+
+	zassert_ok(k_heap_runtime_stats_get(&k_heap_test, &stats));
+	zassert_true(stats.cached_bytes > 0, "nothing cached");
+	hits = stats.cache_hits;
+
+	p = k_heap_alloc(&k_heap_test, ALLOC_SIZE_2, K_NO_WAIT);
+	zassert_not_null(p, "cached blocks were not returned to the heap");
+	k_heap_free(&k_heap_test, p);
+
+	zassert_ok(k_heap_runtime_stats_get(&k_heap_test, &stats));
+	zassert_equal(stats.cached_bytes, 0, "caches not flushed");
+
+	for (int i = 0; i < CONFIG_K_HEAP_CPU_CACHE_BATCH; i++) {
+		blocks[i] = k_heap_alloc(&k_heap_test, 16, K_NO_WAIT);
+		zassert_not_null(blocks[i], "k_heap_alloc operation failed");
+	}
+
+	for (int i = 0; i < CONFIG_K_HEAP_CPU_CACHE_BATCH; i++) {
+		k_heap_free(&k_heap_test, blocks[i]);
+	}
+
+	zassert_ok(k_heap_runtime_stats_get(&k_heap_test, &stats));
+	zassert_equal(stats.cache_hits - hits, CONFIG_K_HEAP_CPU_CACHE_BATCH - 1,
+		      "refilled blocks were not served from the cache");
+#endif
+}
+
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+static void *small_blocks[HEAP_SIZE / 16];
+static void *tiny_blocks[HEAP_SIZE / 8];
+
+/* Exhaust the heap with small blocks, then tiny ones */
+static void cache_test_exhaust(int *small, int *tiny)
+{
+	*small = 0;
+	*tiny = 0;
+
+	while (*small < ARRAY_SIZE(small_blocks)) {
+		small_blocks[*small] = k_heap_alloc(&k_heap_test, 16, K_NO_WAIT);
+		if (small_blocks[*small] == NULL) {
+			break;
+		}
+
+		(*small)++;
+	}
+
+	/* Leave no room even for the smallest allocation */
+	while (*tiny < ARRAY_SIZE(tiny_blocks)) {
+		tiny_blocks[*tiny] = k_heap_alloc(&k_heap_test, 8, K_NO_WAIT);
+		if (tiny_blocks[*tiny] == NULL) {
+			break;
+		}
+
+		(*tiny)++;
+	}
+
+	zassert_true(*small > CONFIG_K_HEAP_CPU_CACHE_DEPTH,
+		     "only %d small blocks allocated", *small);
+}
+
+static void cache_test_release(int small, int tiny)
+{
+	while (small > 0) {
+		k_heap_free(&k_heap_test, small_blocks[--small]);
+	}
+
+	while (tiny > 0) {
+		k_heap_free(&k_heap_test, tiny_blocks[--tiny]);
+	}
+}
+#endif
+
+/**
+ * @brief Validate that a free wakes up a thread waiting in k_heap_realloc()
+ *
+ * @ingroup kernel_kheap_api_tests
+ *
+ * @details Exhaust the heap, let a thread wait in k_heap_realloc(), then
+ * free a single small block, which the cache of the current CPU has room
+ * for. The free must go to the heap and let the waiting thread allocate.
+ *
+ * @see k_heap_realloc(), k_heap_free()
+ */
+ZTEST(k_heap_api, test_k_heap_cpu_cache_free_wakes_realloc)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_K_HEAP_CPU_CACHE);
+
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+	int small;
+	int tiny;
+	k_tid_t tid;
+
+	cache_test_exhaust(&small, &tiny);
+
+	tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+			      thread_realloc_heap, NULL, NULL, NULL,
+			      K_PRIO_PREEMPT(5), 0, K_NO_WAIT);
+
+	/* Sleep long enough for child thread to go into pending */
+	k_msleep(5);
+
+	k_heap_free(&k_heap_test, small_blocks[--small]);
+
+	zassert_ok(k_thread_join(tid, K_MSEC(100)),
+		   "waiting thread not woken up by the free");
+
+	cache_test_release(small, tiny);
+#endif
+}
+
+/**
+ * @brief Validate that k_heap_realloc() gets the blocks held by the caches
+ *
+ * @ingroup kernel_kheap_api_tests
+ *
+ * @details Exhaust the heap, then free small blocks into the cache of the
+ * current CPU without filling it. Growing a block, and allocating through
+ * k_heap_realloc(), must then succeed from the flushed blocks.
+ *
+ * @see k_heap_realloc()
+ */
+ZTEST(k_heap_api, test_k_heap_cpu_cache_realloc)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_K_HEAP_CPU_CACHE);
+
+#ifdef CONFIG_K_HEAP_CPU_CACHE
+	struct sys_memory_stats stats;
+	int small;
+	int tiny;
+	void *p;
+
+	cache_test_exhaust(&small, &tiny);
+
+	for (int i = 0; i < CONFIG_K_HEAP_CPU_CACHE_DEPTH; i++) {
+		k_heap_free(&k_heap_test, small_blocks[--small]);
+	}
+
+	zassert_ok(k_heap_runtime_stats_get(&k_heap_test, &stats));
+	zassert_true(stats.cached_bytes > 0, "nothing cached");
+
+	p = k_heap_realloc(&k_heap_test, tiny_blocks[tiny - 1], 32, K_NO_WAIT);
+	zassert_not_null(p, "cached blocks were not used to grow the block");
+	tiny_blocks[tiny - 1] = p;
+
+	zassert_ok(k_heap_runtime_stats_get(&k_heap_test, &stats));
+	zassert_equal(stats.cached_bytes, 0, "caches not flushed");
+
+	p = k_heap_realloc(&k_heap_test, NULL, 8, K_NO_WAIT);
+	zassert_not_null(p, "cached blocks were not used to allocate");
+	k_heap_free(&k_heap_test, p);
+
+	cache_test_release(small, tiny);
+#endif
+}
@@ -783,6 +783,95 @@ ZTEST_USER(timer_api, test_timeout_abs)
 #endif
 }
 
+/**
+ * @brief Test timeouts too far away to ever expire
+ *
+ * Starts a timer with the longest relative duration, which doesn't fit
+ * the absolute tick count, and checks that it neither expires nor keeps
+ * shorter timeouts from expiring.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_start(), k_timer_remaining_ticks()
+ */
+ZTEST_USER(timer_api, test_timeout_far)
+{
+#ifdef CONFIG_TIMEOUT_64BIT
+	init_timer_data();
+	k_timer_start(&remain_timer, K_TICKS(INT64_MAX - 1), K_NO_WAIT);
+
+	if (IS_ENABLED(CONFIG_MULTITHREADING)) {
+		k_msleep(DURATION);
+	} else {
+		busy_wait_ms(DURATION);
+	}
+
+	zassert_true(k_timer_remaining_ticks(&remain_timer) > INT64_MAX / 2,
+		     "far timeout wrapped around");
+
+	k_timer_stop(&remain_timer);
+	TIMER_ASSERT(tdata.expire_cnt == 0, &remain_timer);
+	TIMER_ASSERT(tdata.stop_cnt == 1, &remain_timer);
+#endif
+}
+
+#ifdef CONFIG_SMP
+#define RACE_LOOPS 10000
+
+static struct k_timer race_timer;
+static K_THREAD_STACK_DEFINE(race_stack, 1024 + CONFIG_TEST_EXTRA_STACK_SIZE);
+static struct k_thread race_thread;
+
+static void race_stop(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < RACE_LOOPS; i++) {
+		k_timer_stop(&race_timer);
+	}
+}
+#endif
+
+/**
+ * @brief Test starting and stopping a timer from different CPUs
+ *
+ * Restarts a timer on one CPU while another CPU keeps stopping it, then
+ * checks that timers still expire, i.e. that the timeout queues were
+ * not corrupted.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_start(), k_timer_stop()
+ */
+ZTEST(timer_api, test_timer_start_stop_smp)
+{
+#ifdef CONFIG_SMP
+	if (arch_num_cpus() < 2) {
+		ztest_test_skip();
+	}
+
+	k_timer_init(&race_timer, NULL, NULL);
+	k_thread_create(&race_thread, race_stack,
+			K_THREAD_STACK_SIZEOF(race_stack), race_stop,
+			NULL, NULL, NULL, k_thread_priority_get(k_current_get()),
+			0, K_NO_WAIT);
+
+	for (int i = 0; i < RACE_LOOPS; i++) {
+		k_timer_start(&race_timer, K_MSEC(DURATION), K_NO_WAIT);
+	}
+
+	k_thread_join(&race_thread, K_FOREVER);
+
+	k_timer_start(&race_timer, K_MSEC(PERIOD), K_NO_WAIT);
+	zassert_equal(k_timer_status_sync(&race_timer), 1,
+		      "timer did not expire");
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST_USER(timer_api, test_sleep_abs)
 {
 	if (!IS_ENABLED(CONFIG_MULTITHREADING)) {
@@ -268,6 +268,46 @@ ZTEST(lib_heap, test_solo_free_header)
 	}
 }
 
+/* Leave two free holes of the same bucket in front of the rest of the
+ * heap, the bigger one first in the free list.  Only the best fit
+ * policy is guaranteed to serve a request fitting both from the
+ * smaller hole.
+ */
+ZTEST(lib_heap, test_alloc_policy)
+{
+	struct sys_heap heap;
+	struct sys_memory_stats stats;
+	void *big, *small, *p;
+	size_t largest;
+
+	/* Note whitebox assumption: allocation goes from low address
+	 * to high in an empty heap.
+	 */
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+	big = sys_heap_alloc(&heap, 88);
+	zassert_not_null(sys_heap_alloc(&heap, 8), "");
+	small = sys_heap_alloc(&heap, 64);
+	zassert_not_null(sys_heap_alloc(&heap, 8), "");
+	zassert_true(big != NULL && small != NULL, "");
+
+	sys_heap_free(&heap, big);
+	sys_heap_free(&heap, small);
+	zassert_true(sys_heap_validate(&heap), "");
+
+	sys_heap_runtime_stats_get(&heap, &stats);
+	largest = sys_heap_largest_free(&heap);
+	zassert_true(largest > 88 && largest < stats.free_bytes,
+		     "largest free block %zu of %zu free bytes", largest,
+		     stats.free_bytes);
+
+	p = sys_heap_alloc(&heap, 56);
+	zassert_not_null(p, "");
+	if (IS_ENABLED(CONFIG_SYS_HEAP_ALLOC_BEST_FIT)) {
+		zassert_equal_ptr(p, small, "best fit did not pick the smallest hole");
+	}
+	zassert_true(sys_heap_validate(&heap), "");
+}
+
 /* Simple clobber detection */
 void realloc_fill_block(uint8_t *p, size_t sz)
 {
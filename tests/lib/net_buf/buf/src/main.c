@@ -980,5 +980,119 @@ ZTEST(net_buf_tests, test_net_buf_fixed_append)
 	net_buf_unref(buf);
 }
 
+#if defined(CONFIG_NET_BUF_POOL_CPU_CACHE)
+/* Some buffers end up in the cache of a CPU, the others are spilled */
+#define CACHE_POOL_COUNT (CONFIG_NET_BUF_POOL_CPU_CACHE_SIZE + \
+			  CONFIG_NET_BUF_POOL_CPU_CACHE_BATCH)
+
+NET_BUF_POOL_FIXED_DEFINE(cache_pool, CACHE_POOL_COUNT, 16, 0, NULL);
+
+static struct net_buf *cache_bufs[CACHE_POOL_COUNT];
+/* One thread pinned to each of the first two CPUs */
+static K_THREAD_STACK_ARRAY_DEFINE(cache_thread_stack, 2, 1024);
+static struct k_thread cache_thread_data[2];
+
+static void cache_alloc_all(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	for (int i = 0; i < CACHE_POOL_COUNT; i++) {
+		cache_bufs[i] = net_buf_alloc(&cache_pool, K_NO_WAIT);
+	}
+}
+
+static void cache_free_all(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	for (int i = 0; i < CACHE_POOL_COUNT; i++) {
+		if (cache_bufs[i] != NULL) {
+			net_buf_unref(cache_bufs[i]);
+			cache_bufs[i] = NULL;
+		}
+	}
+}
+
+static void cache_alloc_wait(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	*(struct net_buf **)arg1 = net_buf_alloc(&cache_pool, TEST_TIMEOUT);
+}
+
+static void cache_thread_start(int cpu, k_thread_entry_t entry, void *arg)
+{
+	k_thread_create(&cache_thread_data[cpu], cache_thread_stack[cpu],
+			K_THREAD_STACK_SIZEOF(cache_thread_stack[cpu]),
+			entry, arg, NULL, NULL, K_PRIO_PREEMPT(7), 0, K_FOREVER);
+	zassert_ok(k_thread_cpu_pin(&cache_thread_data[cpu], cpu));
+	k_thread_start(&cache_thread_data[cpu]);
+}
+
+static void cache_thread_join(int cpu)
+{
+	zassert_ok(k_thread_join(&cache_thread_data[cpu], TEST_TIMEOUT));
+}
+
+static void cache_run_on(int cpu, k_thread_entry_t entry)
+{
+	cache_thread_start(cpu, entry, NULL);
+	cache_thread_join(cpu);
+}
+
+static void cache_check_all_allocated(void)
+{
+	for (int i = 0; i < CACHE_POOL_COUNT; i++) {
+		zassert_not_null(cache_bufs[i], "Buffer %d not allocated", i);
+
+		for (int j = 0; j < i; j++) {
+			zassert_not_equal(cache_bufs[i], cache_bufs[j],
+					  "Buffer %d allocated twice", j);
+		}
+	}
+}
+
+ZTEST(net_buf_tests, test_net_buf_cpu_cache_other_cpu)
+{
+	/* All the free buffers sit in the cache of CPU 0 or were spilled */
+	cache_run_on(0, cache_alloc_all);
+	cache_check_all_allocated();
+	cache_run_on(0, cache_free_all);
+
+	/* CPU 1 still gets every one of them without waiting */
+	cache_run_on(1, cache_alloc_all);
+	cache_check_all_allocated();
+	cache_run_on(1, cache_free_all);
+
+	/* And so does CPU 0 again */
+	cache_run_on(0, cache_alloc_all);
+	cache_check_all_allocated();
+	cache_run_on(0, cache_free_all);
+}
+
+ZTEST(net_buf_tests, test_net_buf_cpu_cache_free_wakes_alloc)
+{
+	struct net_buf *buf = NULL;
+
+	cache_run_on(0, cache_alloc_all);
+	cache_check_all_allocated();
+
+	/* CPU 1 waits for a buffer of the exhausted pool */
+	cache_thread_start(1, cache_alloc_wait, &buf);
+	k_sleep(K_MSEC(100));
+
+	/* Freed on CPU 0, which must not keep it in its cache */
+	cache_run_on(0, cache_free_all);
+	cache_thread_join(1);
+	zassert_not_null(buf, "Waiting allocation not woken up");
+
+	net_buf_unref(buf);
+}
+#endif /* CONFIG_NET_BUF_POOL_CPU_CACHE */
 
 ZTEST_SUITE(net_buf_tests, NULL, NULL, NULL, NULL, NULL);
@@ -2415,6 +2415,49 @@ ZTEST(net_socket_tcp, test_so_keepalive)
 	test_context_cleanup();
 }
 
+ZTEST(net_socket_tcp, test_tcp_congestion)
+{
+	struct sockaddr_in bind_addr4;
+	char name[16];
+	socklen_t optlen = sizeof(name);
+	int sock, ret;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &bind_addr4);
+
+	ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_str_equal(name, IS_ENABLED(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC) ?
+			  "cubic" : "reno", "getsockopt got invalid value");
+	zassert_equal(optlen, strlen(name) + 1, "getsockopt got invalid size");
+
+	ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "reno",
+			       strlen("reno"));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	optlen = sizeof(name);
+	ret = zsock_getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_str_equal(name, "reno", "getsockopt got invalid value");
+
+	ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "cubic",
+			       strlen("cubic"));
+	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CUBIC)) {
+		zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+	} else {
+		zassert_equal(ret, -1, "setsockopt should fail");
+		zassert_equal(errno, ENOENT, "setsockopt returned invalid errno");
+	}
+
+	ret = zsock_setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "bogus",
+			       strlen("bogus"));
+	zassert_equal(ret, -1, "setsockopt should fail");
+	zassert_equal(errno, ENOENT, "setsockopt returned invalid errno");
+
+	test_close(sock);
+
+	test_context_cleanup();
+}
+
 ZTEST(net_socket_tcp, test_keepalive_timeout)
 {
 	struct sockaddr_in c_saddr, s_saddr;
@@ -3092,6 +3092,170 @@ ZTEST(net_socket_udp, test_40_clamp_udp_tcp_port_range)
 #endif
 }
 
+ZTEST_USER(net_socket_udp, test_41_v4_sendmmsg_recvmmsg)
+{
+	static const char * const payloads[] = {
+		TEST_STR_SMALL, "second datagram", "and the third one",
+	};
+	uint8_t rx_buf[ARRAY_SIZE(payloads) + 1][MAX_BUF_LEN];
+	struct sockaddr_in addr[ARRAY_SIZE(payloads) + 1];
+	struct iovec io_vector[ARRAY_SIZE(payloads) + 1];
+	struct mmsghdr msgs[ARRAY_SIZE(payloads) + 1];
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	int client_sock;
+	int server_sock;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock,
+			(struct sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	memset(msgs, 0, sizeof(msgs));
+
+	for (int i = 0; i < ARRAY_SIZE(payloads); i++) {
+		io_vector[i].iov_base = (void *)payloads[i];
+		io_vector[i].iov_len = strlen(payloads[i]);
+
+		msgs[i].msg_hdr.msg_name = &server_addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+		msgs[i].msg_hdr.msg_iov = &io_vector[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = zsock_sendmmsg(client_sock, msgs, ARRAY_SIZE(payloads), 0);
+	zassert_equal(rv, ARRAY_SIZE(payloads), "sendmmsg failed (%d)", errno);
+
+	for (int i = 0; i < ARRAY_SIZE(payloads); i++) {
+		zassert_equal(msgs[i].msg_len, strlen(payloads[i]),
+			      "wrong length sent for message %d", i);
+	}
+
+	/* Let the loopback deliver all the datagrams */
+	k_msleep(100);
+
+	memset(msgs, 0, sizeof(msgs));
+
+	for (int i = 0; i < ARRAY_SIZE(msgs); i++) {
+		io_vector[i].iov_base = rx_buf[i];
+		io_vector[i].iov_len = sizeof(rx_buf[i]);
+
+		msgs[i].msg_hdr.msg_name = &addr[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(addr[i]);
+		msgs[i].msg_hdr.msg_iov = &io_vector[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	/* Ask for one more datagram than there is, this must not block */
+	rv = zsock_recvmmsg(server_sock, msgs, ARRAY_SIZE(msgs),
+			    ZSOCK_MSG_WAITFORONE);
+	zassert_equal(rv, ARRAY_SIZE(payloads), "recvmmsg failed (%d)", errno);
+
+	for (int i = 0; i < ARRAY_SIZE(payloads); i++) {
+		zassert_equal(msgs[i].msg_len, strlen(payloads[i]),
+			      "wrong length received for message %d", i);
+		zassert_mem_equal(rx_buf[i], payloads[i], strlen(payloads[i]),
+				  "wrong data received for message %d", i);
+		zassert_equal(addr[i].sin_family, AF_INET,
+			      "wrong source family for message %d", i);
+	}
+
+	rv = zsock_recvmmsg(server_sock, msgs, ARRAY_SIZE(msgs),
+			    ZSOCK_MSG_DONTWAIT);
+	zassert_true(rv < 0 && errno == EAGAIN, "recvmmsg did not fail (%d)", rv);
+
+	/* An empty datagram still reports where it comes from */
+	rv = zsock_sendto(client_sock, TEST_STR_SMALL, 0, 0,
+			  (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, 0, "sendto failed (%d)", errno);
+
+	k_msleep(100);
+
+	memset(&addr[0], 0, sizeof(addr[0]));
+	msgs[0].msg_len = 1U;
+
+	rv = zsock_recvmmsg(server_sock, msgs, 1, 0);
+	zassert_equal(rv, 1, "recvmmsg failed (%d)", errno);
+	zassert_equal(msgs[0].msg_len, 0, "wrong length received");
+	zassert_equal(addr[0].sin_family, AF_INET, "source address not reported");
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+ZTEST(net_socket_udp, test_42_v4_recv_buf)
+{
+#if defined(CONFIG_NET_SOCKETS_RECV_BUF)
+	static const char * const payloads[] = {
+		TEST_STR_SMALL, "second datagram",
+	};
+	uint8_t rx_buf[MAX_BUF_LEN];
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in addr;
+	socklen_t addrlen;
+	struct net_buf *frags;
+	int client_sock;
+	int server_sock;
+	ssize_t len;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock,
+			(struct sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	for (int i = 0; i < ARRAY_SIZE(payloads); i++) {
+		len = zsock_sendto(client_sock, payloads[i], strlen(payloads[i]), 0,
+				   (struct sockaddr *)&server_addr,
+				   sizeof(server_addr));
+		zassert_equal(len, strlen(payloads[i]), "sendto failed");
+	}
+
+	/* Loaned buffers cannot stay on the receive queue */
+	len = zsock_recv_buf(server_sock, &frags, ZSOCK_MSG_PEEK, NULL, NULL);
+	zassert_true(len < 0 && errno == EINVAL, "peek did not fail (%zd)", len);
+	zassert_is_null(frags, "fragments returned on error");
+
+	for (int i = 0; i < ARRAY_SIZE(payloads); i++) {
+		addrlen = sizeof(addr);
+		len = zsock_recv_buf(server_sock, &frags, 0,
+				     (struct sockaddr *)&addr, &addrlen);
+		zassert_equal(len, strlen(payloads[i]), "recv_buf failed (%d)", errno);
+		zassert_not_null(frags, "no fragments returned");
+		zassert_equal(net_buf_frags_len(frags), len, "wrong fragment length");
+		zassert_equal(addrlen, sizeof(addr), "wrong address length");
+		zassert_equal(addr.sin_family, AF_INET, "wrong source family");
+
+		zassert_equal(net_buf_linearize(rx_buf, sizeof(rx_buf), frags, 0, len),
+			      len, "cannot linearize the fragments");
+		zassert_mem_equal(rx_buf, payloads[i], len,
+				  "wrong data received for datagram %d", i);
+
+		zsock_recv_buf_release(server_sock, frags);
+	}
+
+	len = zsock_recv_buf(server_sock, &frags, ZSOCK_MSG_DONTWAIT, NULL, NULL);
+	zassert_true(len < 0 && errno == EAGAIN, "recv_buf did not fail (%zd)", len);
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+#else
+	ztest_test_skip();
+#endif
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -3101,4 +3265,40 @@ static void after(void *arg)
 	}
 }
 
+ZTEST_USER(net_socket_udp, test_43_v4_sendmsg_without_iov)
+{
+	uint8_t rx_buf[MAX_BUF_LEN];
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct msghdr msg;
+	int client_sock;
+	int server_sock;
+	ssize_t len;
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = zsock_bind(server_sock,
+			(struct sockaddr *)&server_addr,
+			sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	/* A message without data needs no iovec array */
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_name = &server_addr;
+	msg.msg_namelen = sizeof(server_addr);
+
+	len = zsock_sendmsg(client_sock, &msg, 0);
+	zassert_equal(len, 0, "sendmsg failed (%d)", errno);
+
+	len = zsock_recv(server_sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(len, 0, "empty datagram not received (%d)", errno);
+
+	rv = zsock_close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = zsock_close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 ZTEST_SUITE(net_socket_udp, NULL, NULL, NULL, after, NULL);
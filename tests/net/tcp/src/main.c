@@ -114,6 +114,9 @@ static enum test_case_no {
 	TEST_CLIENT_CLOSING_FAILURE_IPV6 = 16,
 	TEST_CLIENT_FIN_WAIT_2_IPV4_FAILURE = 17,
 	TEST_CLIENT_FIN_ACK_WITH_DATA = 18,
+	TEST_SERVER_SACK_IPV4 = 19,
+	TEST_SERVER_GSO_GRO_IPV4 = 20,
+	TEST_SERVER_CUBIC_IPV4 = 21,
 } test_case_no;
 
 static enum test_state t_state;
@@ -138,6 +141,7 @@ static void handle_server_rst_on_closed_port(sa_family_t af, struct tcphdr *th);
 static void handle_server_rst_on_listening_port(sa_family_t af, struct tcphdr *th);
 static void handle_syn_invalid_ack(sa_family_t af, struct tcphdr *th);
 static void handle_client_fin_ack_with_data_test(sa_family_t af, struct tcphdr *th);
+static void handle_server_sack_test(struct net_pkt *pkt);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -235,6 +239,12 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+/* Options added by the peer to the segments it sends, when set */
+static const uint8_t *peer_options;
+static uint8_t peer_options_len;
+/* Window advertised by the peer, in host byte order, when non-zero */
+static uint16_t peer_window;
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -243,12 +253,14 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      size_t len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	const uint8_t *opts = peer_options;
+	uint8_t opts_len = peer_options_len;
 	struct net_pkt *pkt;
 	struct tcphdr *th;
-	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
 	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+		opts = tcp_options;
 		opts_len = sizeof(tcp_options);
 	}
 
@@ -284,14 +296,10 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
-		th->th_off = 10U;
-	} else {
-		th->th_off = 5U;
-	}
+	th->th_off = 5U + opts_len / 4U;
 
 	th->th_flags = flags;
-	th->th_win = NET_IPV6_MTU;
+	th->th_win = peer_window ? htons(peer_window) : NET_IPV6_MTU;
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
@@ -303,9 +311,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) && (flags & SYN)) {
+	if (opts_len) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -490,6 +498,11 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case TEST_CLIENT_FIN_ACK_WITH_DATA:
 		handle_client_fin_ack_with_data_test(net_pkt_family(pkt), &th);
 		break;
+	case TEST_SERVER_SACK_IPV4:
+	case TEST_SERVER_GSO_GRO_IPV4:
+	case TEST_SERVER_CUBIC_IPV4:
+		handle_server_sack_test(pkt);
+		break;
 
 	default:
 		zassert_true(false, "Undefined test case");
@@ -719,6 +732,16 @@ static void handle_server_test(sa_family_t af, struct tcphdr *th)
 		break;
 	case T_SYN_ACK:
 		test_verify_flags(th, SYN | ACK);
+		if (test_case_no == TEST_SERVER_WITH_OPTIONS_IPV4) {
+			/* MSS, and window scale and SACK permitted when they
+			 * are enabled, as the peer offered both.
+			 */
+			zassert_equal(th->th_off,
+				      6 + IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) +
+				      IS_ENABLED(CONFIG_NET_TCP_SACK),
+				      "Invalid SYN ACK options");
+		}
+
 		seq++;
 		ack = ntohl(th->th_seq) + 1U;
 		reply = prepare_ack_packet(af, htons(MY_PORT),
@@ -2602,4 +2625,575 @@ ZTEST(net_tcp, test_client_fin_ack_with_data)
 	}
 }
 
+/* Segment sent to the peer, as decoded by handle_server_sack_test() */
+struct sack_test_seg {
+	uint32_t seq;
+	uint32_t ack;
+	uint16_t len;
+	uint8_t flags;
+	bool wscale_found;
+	bool sack_permitted;
+	uint8_t sack_cnt;
+	uint32_t sack_left;
+	uint32_t sack_right;
+};
+
+K_MSGQ_DEFINE(sack_test_segs, sizeof(struct sack_test_seg), 8, 4);
+
+static void handle_server_sack_test(struct net_pkt *pkt)
+{
+	struct sack_test_seg seg = { 0 };
+	uint8_t opts[40];
+	struct tcphdr th;
+	size_t opts_len;
+	size_t i = 0;
+	int ret;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	ret = net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			   net_pkt_ip_opts_len(pkt));
+	if (ret < 0) {
+		goto fail;
+	}
+
+	ret = net_pkt_read(pkt, &th, sizeof(th));
+	if (ret < 0) {
+		goto fail;
+	}
+
+	opts_len = th.th_off * 4U - sizeof(th);
+	ret = net_pkt_read(pkt, opts, opts_len);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	seg.seq = ntohl(th.th_seq);
+	seg.ack = ntohl(th.th_ack);
+	seg.len = net_pkt_remaining_data(pkt);
+	seg.flags = th.th_flags;
+
+	net_pkt_cursor_init(pkt);
+
+	while (i < opts_len && opts[i] != NET_TCP_END_OPT) {
+		if (opts[i] == NET_TCP_NOP_OPT) {
+			i++;
+			continue;
+		}
+
+		if (i + 1 >= opts_len || opts[i + 1] < 2 ||
+		    i + opts[i + 1] > opts_len) {
+			goto fail;
+		}
+
+		switch (opts[i]) {
+		case NET_TCP_WINDOW_SCALE_OPT:
+			seg.wscale_found = true;
+			break;
+		case NET_TCP_SACK_PERM_OPT:
+			seg.sack_permitted = true;
+			break;
+		case NET_TCP_SACK_OPT:
+			seg.sack_cnt = (opts[i + 1] - 2) / NET_TCP_SACK_BLOCK_SIZE;
+			if (seg.sack_cnt > 0) {
+				seg.sack_left = sys_get_be32(&opts[i + 2]);
+				seg.sack_right = sys_get_be32(&opts[i + 6]);
+			}
+			break;
+		}
+
+		i += opts[i + 1];
+	}
+
+	zassert_ok(k_msgq_put(&sack_test_segs, &seg, K_NO_WAIT),
+		   "Too many segments sent to the peer");
+
+	return;
+fail:
+	zassert_true(false, "%s failed", __func__);
+}
+
+static void sack_test_recv(struct sack_test_seg *seg, int line)
+{
+	if (k_msgq_get(&sack_test_segs, seg, K_MSEC(100)) != 0) {
+		zassert_true(false, "no segment sent to the peer (line %d)", line);
+	}
+}
+
+static void sack_test_send(struct net_pkt *pkt)
+{
+	zassert_not_null(pkt, "Cannot create pkt");
+	zassert_ok(net_recv_data(net_iface, pkt), "recv data failed");
+}
+
+/* Test case scenario IPv4
+ *   send SYN with window scale and SACK permitted,
+ *   expect SYN ACK with both options,
+ *   send ACK, its window is scaled,
+ *   send DATA past a hole, expect ACK with a SACK block,
+ *   send DATA filling the hole, expect ACK without SACK block,
+ *   expect five DATA segments,
+ *   send three duplicate ACKs SACKing the 2nd and the 4th,
+ *   expect the 1st and the 3rd to be resent.
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_server_sack_window_scale)
+{
+	uint8_t sack_opt[4 + 2 * NET_TCP_SACK_BLOCK_SIZE] = {
+		NET_TCP_NOP_OPT, NET_TCP_NOP_OPT,
+		NET_TCP_SACK_OPT, 2 + 2 * NET_TCP_SACK_BLOCK_SIZE,
+	};
+	struct sack_test_seg seg;
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint32_t base = 0;
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_SACK) ||
+	    !IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) ||
+	    CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT == 0) {
+		ztest_test_skip();
+	}
+
+	test_case_no = TEST_SERVER_SACK_IPV4;
+	seq = ack = 0;
+	k_msgq_purge(&sack_test_segs);
+	k_sem_reset(&test_sem);
+
+	zassert_ok(net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx),
+		   "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	zassert_ok(net_context_bind(ctx, (struct sockaddr *)&my_addr_s,
+				    sizeof(struct sockaddr_in)),
+		   "Failed to bind net_context");
+	zassert_ok(net_context_listen(ctx, 1), "Failed to listen on net_context");
+	zassert_ok(net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL),
+		   "Failed to set accept on net_context");
+
+	/* tcp_options offer a window scale of 7 and SACK */
+	peer_options = tcp_options;
+	peer_options_len = sizeof(tcp_options);
+	sack_test_send(prepare_syn_packet(AF_INET, htons(MY_PORT),
+					  htons(PEER_PORT)));
+	peer_options = NULL;
+	peer_options_len = 0;
+
+	sack_test_recv(&seg, __LINE__);
+	zassert_equal(seg.flags, SYN | ACK, "Expected SYN ACK");
+	zassert_true(seg.wscale_found, "No window scale in SYN ACK");
+	zassert_true(seg.sack_permitted, "No SACK permitted in SYN ACK");
+
+	seq++;
+	ack = seg.seq + 1U;
+	sack_test_send(prepare_ack_packet(AF_INET, htons(MY_PORT),
+					  htons(PEER_PORT)));
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	conn = accepted_ctx->tcp;
+	zassert_equal(conn->send_win,
+		      MIN((uint32_t)ntohs(NET_IPV6_MTU) << 7, conn->send_win_max),
+		      "Peer window not scaled (%u)", conn->send_win);
+
+	/* Data past a hole is reported in a SACK block */
+	seq += 10U;
+	sack_test_send(prepare_data_packet(AF_INET, htons(MY_PORT),
+					   htons(PEER_PORT), lorem_ipsum + 10, 10U));
+
+	sack_test_recv(&seg, __LINE__);
+	zassert_equal(seg.ack, seq - 10U, "Invalid ACK %u", seg.ack);
+	zassert_equal(seg.sack_cnt, 1, "Expected one SACK block");
+	zassert_equal(seg.sack_left, seq, "Invalid SACK block left edge");
+	zassert_equal(seg.sack_right, seq + 10U, "Invalid SACK block right edge");
+
+	/* Filling the hole acknowledges both and clears the block */
+	seq -= 10U;
+	sack_test_send(prepare_data_packet(AF_INET, htons(MY_PORT),
+					   htons(PEER_PORT), lorem_ipsum, 10U));
+
+	sack_test_recv(&seg, __LINE__);
+	zassert_equal(seg.ack, seq + 20U, "Invalid ACK %u", seg.ack);
+	zassert_equal(seg.sack_cnt, 0, "Unexpected SACK block");
+	seq += 20U;
+
+	for (int i = 0; i < 5; i++) {
+		ret = net_context_send(accepted_ctx, lorem_ipsum + i * 100, 100,
+				       NULL, K_NO_WAIT, NULL);
+		zassert_true(ret >= 0, "Failed to send data to peer");
+
+		sack_test_recv(&seg, __LINE__);
+		if (i == 0) {
+			base = seg.seq;
+		}
+
+		zassert_equal(seg.seq, base + i * 100U, "Invalid seq");
+		zassert_equal(seg.len, 100, "Invalid len %u", seg.len);
+	}
+
+	/* The holes below the highest SACKed block are resent on the third
+	 * duplicate ACK, the data above it is not.
+	 */
+	sys_put_be32(base + 100U, &sack_opt[4]);
+	sys_put_be32(base + 200U, &sack_opt[8]);
+	sys_put_be32(base + 300U, &sack_opt[12]);
+	sys_put_be32(base + 400U, &sack_opt[16]);
+
+	ack = base;
+	peer_options = sack_opt;
+	peer_options_len = sizeof(sack_opt);
+
+	for (int i = 0; i < 3; i++) {
+		sack_test_send(prepare_ack_packet(AF_INET, htons(MY_PORT),
+						  htons(PEER_PORT)));
+	}
+
+	peer_options = NULL;
+	peer_options_len = 0;
+
+	sack_test_recv(&seg, __LINE__);
+	zassert_equal(seg.seq, base, "First hole not resent");
+	zassert_equal(seg.len, 100, "Invalid len %u", seg.len);
+
+	sack_test_recv(&seg, __LINE__);
+	zassert_equal(seg.seq, base + 200U, "Second hole not resent");
+	zassert_equal(seg.len, 100, "Invalid len %u", seg.len);
+
+	/* Abort the connection, no need for a full closing handshake */
+	sack_test_send(prepare_rst_packet(AF_INET, htons(MY_PORT),
+					  htons(PEER_PORT)));
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+static uint8_t gso_gro_data[LOREM_IPSUM_STRLEN];
+static size_t gso_gro_data_len;
+static int gso_gro_recv_calls;
+
+static void gso_gro_recv_cb(struct net_context *context,
+			    struct net_pkt *pkt,
+			    union net_ip_header *ip_hdr,
+			    union net_proto_header *proto_hdr,
+			    int status,
+			    void *user_data)
+{
+	size_t len;
+
+	if (pkt == NULL) {
+		return;
+	}
+
+	len = MIN(net_pkt_remaining_data(pkt),
+		  sizeof(gso_gro_data) - gso_gro_data_len);
+	zassert_ok(net_pkt_read(pkt, gso_gro_data + gso_gro_data_len, len),
+		   "Cannot read received data");
+
+	gso_gro_data_len += len;
+	gso_gro_recv_calls++;
+
+	net_pkt_unref(pkt);
+}
+
+/* Test case scenario IPv4
+ *   send SYN, expect SYN ACK, send ACK,
+ *   send data longer than three segments in one call,
+ *   expect it split into MSS sized segments, send ACK,
+ *   send three DATA segments at once,
+ *   expect them delivered together and acknowledged by a single ACK.
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_server_gso_gro)
+{
+	struct sack_test_seg seg;
+	struct net_context *ctx;
+	uint32_t next = 0;
+	size_t seg_len = 0;
+	int segs = 0;
+	int ret;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_GSO) || !IS_ENABLED(CONFIG_NET_TCP_GRO)) {
+		ztest_test_skip();
+	}
+
+	test_case_no = TEST_SERVER_GSO_GRO_IPV4;
+	seq = ack = 0;
+	k_msgq_purge(&sack_test_segs);
+	k_sem_reset(&test_sem);
+
+	zassert_ok(net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx),
+		   "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	zassert_ok(net_context_bind(ctx, (struct sockaddr *)&my_addr_s,
+				    sizeof(struct sockaddr_in)),
+		   "Failed to bind net_context");
+	zassert_ok(net_context_listen(ctx, 1), "Failed to listen on net_context");
+	zassert_ok(net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL),
+		   "Failed to set accept on net_context");
+
+	/* Let the window, not the peer, limit what is sent at once */
+	peer_window = LOREM_IPSUM_STRLEN;
+
+	sack_test_send(prepare_syn_packet(AF_INET, htons(MY_PORT),
+					  htons(PEER_PORT)));
+
+	sack_test_recv(&seg, __LINE__);
+	zassert_equal(seg.flags, SYN | ACK, "Expected SYN ACK");
+
+	seq++;
+	ack = seg.seq + 1U;
+	sack_test_send(prepare_ack_packet(AF_INET, htons(MY_PORT),
+					  htons(PEER_PORT)));
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	accepted_ctx->recv_cb = gso_gro_recv_cb;
+	gso_gro_data_len = 0;
+	gso_gro_recv_calls = 0;
+
+	/* The interface MTU is far below 300 bytes, so one send is split
+	 * into several segments on the way out.
+	 */
+	ret = net_context_send(accepted_ctx, lorem_ipsum, 300, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, 300, "Failed to send data to peer (%d)", ret);
+
+	next = ack;
+	while (next != ack + 300U) {
+		sack_test_recv(&seg, __LINE__);
+		zassert_equal(seg.seq, next, "Invalid seq %u", seg.seq);
+		zassert_true(seg.len > 0, "Segment without data");
+
+		if (segs == 0) {
+			seg_len = seg.len;
+		}
+
+		zassert_true(seg.len <= seg_len, "Segment too long (%u)", seg.len);
+		next += seg.len;
+		segs++;
+	}
+
+	zassert_true(segs >= 3, "Data not segmented (%d segments)", segs);
+
+	ack = next;
+	sack_test_send(prepare_ack_packet(AF_INET, htons(MY_PORT),
+					  htons(PEER_PORT)));
+
+	/* Queue the segments before the RX thread gets to look at them */
+	k_sched_lock();
+
+	for (int i = 0; i < 3; i++) {
+		sack_test_send(prepare_data_packet(AF_INET, htons(MY_PORT),
+						   htons(PEER_PORT),
+						   lorem_ipsum + i * 50, 50U));
+		seq += 50U;
+	}
+
+	k_sched_unlock();
+
+	sack_test_recv(&seg, __LINE__);
+	zassert_equal(seg.flags, ACK, "Expected ACK");
+	zassert_equal(seg.ack, seq, "Invalid ACK %u", seg.ack);
+	zassert_not_equal(k_msgq_get(&sack_test_segs, &seg, K_MSEC(50)), 0,
+			  "Segments acknowledged separately");
+
+	zassert_equal(gso_gro_recv_calls, 1, "Data delivered %d times",
+		      gso_gro_recv_calls);
+	zassert_equal(gso_gro_data_len, 150U, "Invalid received length %zu",
+		      gso_gro_data_len);
+	zassert_mem_equal(gso_gro_data, lorem_ipsum, 150U, "Invalid data");
+
+	peer_window = 0;
+
+	/* Abort the connection, no need for a full closing handshake */
+	sack_test_send(prepare_rst_packet(AF_INET, htons(MY_PORT),
+					  htons(PEER_PORT)));
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
+/* Send @a len bytes to the peer and acknowledge every segment of them */
+static void cubic_test_exchange(size_t len, int line)
+{
+	struct sack_test_seg seg;
+	uint32_t end;
+	int ret;
+
+	ret = net_context_send(accepted_ctx, lorem_ipsum, len, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, len, "Failed to send data to peer (line %d)", line);
+
+	end = ack + len;
+	while (ack != end) {
+		sack_test_recv(&seg, line);
+		zassert_equal(seg.seq, ack, "Invalid seq %u (line %d)", seg.seq,
+			      line);
+
+		ack = seg.seq + seg.len;
+		sack_test_send(prepare_ack_packet(AF_INET, htons(MY_PORT),
+						  htons(PEER_PORT)));
+	}
+
+	/* Let the last ACK be processed */
+	k_msleep(10);
+}
+
+/* Send @a len bytes to the peer and answer them with three duplicate
+ * ACKs, the first segment is resent.
+ */
+static void cubic_test_loss(size_t len, int line)
+{
+	struct sack_test_seg seg;
+	uint32_t base = ack;
+	uint32_t end;
+	int ret;
+
+	ret = net_context_send(accepted_ctx, lorem_ipsum, len, NULL,
+			       K_NO_WAIT, NULL);
+	zassert_equal(ret, len, "Failed to send data to peer (line %d)", line);
+
+	end = base;
+	while (end != base + len) {
+		sack_test_recv(&seg, line);
+		zassert_equal(seg.seq, end, "Invalid seq %u (line %d)", seg.seq,
+			      line);
+		end += seg.len;
+	}
+
+	for (int i = 0; i < 3; i++) {
+		sack_test_send(prepare_ack_packet(AF_INET, htons(MY_PORT),
+						  htons(PEER_PORT)));
+	}
+
+	sack_test_recv(&seg, line);
+	zassert_equal(seg.seq, base, "First segment not resent (line %d)", line);
+}
+
+/* Test case scenario IPv4
+ *   establish a connection using CUBIC,
+ *   acknowledge data, expect the window to grow in slow start and then
+ *   by less than a segment per ACK,
+ *   send three duplicate ACKs, expect the window reduced by beta,
+ *   acknowledge everything, expect the window at the threshold,
+ *   repeat the loss below the previous maximum, expect the maximum
+ *   lowered further (fast convergence).
+ *   any failures cause test case to fail.
+ */
+ZTEST(net_tcp, test_server_cubic)
+{
+	struct sack_test_seg seg;
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint32_t mss;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_CONGESTION_DEFAULT_CUBIC) ||
+	    !IS_ENABLED(CONFIG_NET_TCP_FAST_RETRANSMIT) ||
+	    IS_ENABLED(CONFIG_NET_TCP_CONGESTION_LARGE_IW)) {
+		ztest_test_skip();
+	}
+
+	test_case_no = TEST_SERVER_CUBIC_IPV4;
+	seq = ack = 0;
+	k_msgq_purge(&sack_test_segs);
+	k_sem_reset(&test_sem);
+
+	zassert_ok(net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx),
+		   "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	zassert_ok(net_context_bind(ctx, (struct sockaddr *)&my_addr_s,
+				    sizeof(struct sockaddr_in)),
+		   "Failed to bind net_context");
+	zassert_ok(net_context_listen(ctx, 1), "Failed to listen on net_context");
+	zassert_ok(net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL),
+		   "Failed to set accept on net_context");
+
+	/* Let the congestion window, not the peer, limit the data in flight */
+	peer_window = LOREM_IPSUM_STRLEN;
+
+	sack_test_send(prepare_syn_packet(AF_INET, htons(MY_PORT),
+					  htons(PEER_PORT)));
+
+	sack_test_recv(&seg, __LINE__);
+	zassert_equal(seg.flags, SYN | ACK, "Expected SYN ACK");
+
+	seq++;
+	ack = seg.seq + 1U;
+	sack_test_send(prepare_ack_packet(AF_INET, htons(MY_PORT),
+					  htons(PEER_PORT)));
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	conn = accepted_ctx->tcp;
+	mss = conn_mss(conn);
+	zassert_str_equal(conn->ca.ops->name, "cubic", "CUBIC not in use");
+	zassert_equal(conn->ca.cwnd, mss, "Invalid initial cwnd %u",
+		      conn->ca.cwnd);
+
+	/* Slow start up to the threshold, then congestion avoidance */
+	cubic_test_exchange(4 * mss, __LINE__);
+	zassert_true(conn->ca.cwnd > 3 * mss, "cwnd %u did not grow",
+		     conn->ca.cwnd);
+	zassert_true(conn->ca.cwnd >= conn->ca.ssthresh,
+		     "cwnd %u still below ssthresh %u", conn->ca.cwnd,
+		     conn->ca.ssthresh);
+
+	cwnd = conn->ca.cwnd;
+	cubic_test_exchange(2 * mss, __LINE__);
+	zassert_true(conn->ca.cwnd > cwnd, "cwnd %u did not grow",
+		     conn->ca.cwnd);
+	zassert_true(conn->ca.cwnd < cwnd + 2 * mss,
+		     "cwnd %u grew as in slow start", conn->ca.cwnd);
+
+	/* Each duplicate ACK inflates the window by a segment first */
+	cwnd = conn->ca.cwnd + 3 * mss;
+	cubic_test_loss(3 * mss, __LINE__);
+
+	ssthresh = MAX(2 * mss, 3 * mss * 7 / 10);
+	zassert_equal(conn->ca.cubic.w_max, cwnd, "Invalid w_max %u",
+		      conn->ca.cubic.w_max);
+	zassert_equal(conn->ca.ssthresh, ssthresh, "Invalid ssthresh %u",
+		      conn->ca.ssthresh);
+	zassert_equal(conn->ca.cwnd, 3 * mss + ssthresh, "Invalid cwnd %u",
+		      conn->ca.cwnd);
+
+	ack += 3 * mss;
+	sack_test_send(prepare_ack_packet(AF_INET, htons(MY_PORT),
+					  htons(PEER_PORT)));
+	k_msleep(10);
+	zassert_equal(conn->ca.cwnd, ssthresh, "Recovery did not end, cwnd %u",
+		      conn->ca.cwnd);
+
+	/* A loss below the previous maximum lowers it further */
+	cwnd = conn->ca.cwnd + 3 * mss;
+	zassert_true(cwnd < conn->ca.cubic.w_max, "No fast convergence case");
+	cubic_test_loss(2 * mss, __LINE__);
+
+	zassert_equal(conn->ca.cubic.w_max, cwnd * 17 / 20, "Invalid w_max %u",
+		      conn->ca.cubic.w_max);
+
+	peer_window = 0;
+
+	/* Abort the connection, no need for a full closing handshake */
+	sack_test_send(prepare_rst_packet(AF_INET, htons(MY_PORT),
+					  htons(PEER_PORT)));
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_context_put(accepted_ctx);
+}
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);
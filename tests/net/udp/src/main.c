@@ -434,6 +434,7 @@ ZTEST(udp_fn_tests, test_udp)
 	struct net_if *iface;
 	struct net_if_addr *ifaddr;
 	struct ud *ud;
+	struct ud *wild;
 	int ret, i = 0;
 	bool st;
 
@@ -628,6 +629,29 @@ ZTEST(udp_fn_tests, test_udp)
 	TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 1234, 4242);
 	TEST_IPV4_FAIL(ud, &in4addr_peer, &in4addr_my, 1234, 4243);
 
+	/* A handler of the remote address and port takes precedence over
+	 * one of the local port only, whichever is registered first, and
+	 * the latter gets the packets again once the former is removed.
+	 */
+	wild = REGISTER(AF_INET, &any_addr4, NULL, 0, 4250);
+	ud = REGISTER(AF_INET, &peer_addr4, &my_addr4, 1234, 4250);
+	TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 1234, 4250);
+	TEST_IPV4_OK(wild, &in4addr_peer, &in4addr_my, 1235, 4250);
+	UNREGISTER(ud);
+	TEST_IPV4_OK(wild, &in4addr_peer, &in4addr_my, 1234, 4250);
+	UNREGISTER(wild);
+	TEST_IPV4_FAIL(wild, &in4addr_peer, &in4addr_my, 1234, 4250);
+
+	ud = REGISTER(AF_INET6, &peer_addr6, &my_addr6, 1234, 4251);
+	wild = REGISTER(AF_INET6, &any_addr6, NULL, 0, 4251);
+	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 1234, 4251);
+	TEST_IPV6_OK(wild, &in6addr_peer, &in6addr_my, 1235, 4251);
+	UNREGISTER(wild);
+	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 1234, 4251);
+	TEST_IPV6_FAIL(ud, &in6addr_peer, &in6addr_my, 1235, 4251);
+	UNREGISTER(ud);
+	TEST_IPV6_FAIL(ud, &in6addr_peer, &in6addr_my, 1234, 4251);
+
 	ud = REGISTER(AF_UNSPEC, NULL, NULL, 1234, 42423);
 	TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 1234, 42423);
 	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 1234, 42423);
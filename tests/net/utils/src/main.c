@@ -927,8 +927,8 @@ ZTEST(test_utils_fn, test_ip_checksum)
 	}
 
 	/* Work across all possible combination so offset and length */
-	for (int offset = 0; offset < 7; offset++) {
-		for (int length = 1; length < 32; length++) {
+	for (int offset = 0; offset < 16; offset++) {
+		for (int length = 1; length < 80; length++) {
 			sum_got = calc_chksum_ref(offset ^ 0x8e72, testdata + offset, length);
 			sum_exp = calc_chksum(offset ^ 0x8e72, testdata + offset, length);
 
@@ -936,6 +936,24 @@ ZTEST(test_utils_fn, test_ip_checksum)
 				      "Mismatch between reference and calculated checksum 3\n");
 		}
 	}
+
+	/* All ones data makes every word addition carry */
+	(void)memset(testdata, 0xff, sizeof(testdata));
+
+	for (int offset = 0; offset < 16; offset++) {
+		for (int length = 1; length < 200; length += 2) {
+			sum_got = calc_chksum_ref(0, testdata + offset, length);
+			sum_exp = calc_chksum(0, testdata + offset, length);
+
+			zassert_equal(sum_got, sum_exp,
+				      "Mismatch between reference and calculated checksum 4\n");
+		}
+	}
+
+	sum_got = calc_chksum_ref(0, testdata + 1, CHECKSUM_TEST_LENGTH - 1);
+	sum_exp = calc_chksum(0, testdata + 1, CHECKSUM_TEST_LENGTH - 1);
+
+	zassert_equal(sum_got, sum_exp, "Mismatch between reference and calculated checksum 5\n");
 }
 
 ZTEST_SUITE(test_utils_fn, NULL, NULL, NULL, NULL, NULL);
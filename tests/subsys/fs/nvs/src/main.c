@@ -639,6 +639,79 @@ ZTEST_F(nvs, test_delete)
 		     " any footprint in the storage");
 }
 
+struct walk_result {
+	uint32_t addr[10];
+	size_t len[10];
+	size_t visited;
+};
+
+static int walk_record(uint16_t id, size_t len, uint32_t addr, void *arg)
+{
+	struct walk_result *result = arg;
+
+	zassert_true(id < ARRAY_SIZE(result->addr), "unexpected id %u", id);
+
+	/* Keep the latest entry of each id only */
+	if (result->addr[id] == NVS_LOOKUP_CACHE_NO_ADDR) {
+		result->addr[id] = addr;
+		result->len[id] = len;
+	}
+
+	result->visited++;
+
+	return 0;
+}
+
+ZTEST_F(nvs, test_nvs_walk)
+{
+	int err;
+	ssize_t len;
+	uint16_t id, data_read;
+	struct walk_result result;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+
+	for (id = 0; id < ARRAY_SIZE(result.addr); id++) {
+		len = nvs_write(&fixture->fs, id, &id, sizeof(id));
+		zassert_true(len == sizeof(id), "nvs_write failed: %d", len);
+	}
+
+	/* Update one entry and delete another */
+	id = 100;
+	len = nvs_write(&fixture->fs, 3, &id, sizeof(id));
+	zassert_true(len == sizeof(id), "nvs_write failed: %d", len);
+
+	err = nvs_delete(&fixture->fs, 5);
+	zassert_true(err == 0,  "nvs_delete call failure: %d", err);
+
+	memset(&result, 0, sizeof(result));
+	memset(result.addr, 0xff, sizeof(result.addr));
+
+	err = nvs_walk(&fixture->fs, walk_record, &result);
+	zassert_true(err == 0,  "nvs_walk call failure: %d", err);
+	zassert_equal(result.visited, ARRAY_SIZE(result.addr) + 2,
+		      "all entries, stale ones included, should be visited");
+
+	for (id = 0; id < ARRAY_SIZE(result.addr); id++) {
+		if (id == 5) {
+			zassert_equal(result.len[id], 0, "deleted entry should be reported first");
+			continue;
+		}
+
+		zassert_equal(result.len[id], sizeof(data_read), "wrong length of %u", id);
+
+		len = nvs_read_addr(&fixture->fs, id, result.addr[id], &data_read,
+				    sizeof(data_read));
+		zassert_true(len == sizeof(data_read), "nvs_read_addr failed: %d", len);
+		zassert_equal(data_read, (id == 3) ? 100 : id, "wrong data for %u", id);
+	}
+
+	/* The address belongs to another id */
+	len = nvs_read_addr(&fixture->fs, 1, result.addr[2], &data_read, sizeof(data_read));
+	zassert_true(len == -ENOENT, "nvs_read_addr shouldn't find the entry: %d", len);
+}
+
 /*
  * Test that garbage-collection can recover all ate's even when the last ate,
  * ie close_ate, is corrupt. In this test the close_ate is set to point to the
@@ -755,6 +828,95 @@ ZTEST_F(nvs, test_nvs_gc_corrupt_ate)
 	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
 }
 
+/*
+ * Test that garbage-collection finds a delete ate written in the last free
+ * position of a sector, right after the data, when the close_ate is corrupt.
+ * The deleted entry must not be copied back.
+ */
+ZTEST_F(nvs, test_nvs_gc_corrupt_close_ate_delete)
+{
+	struct nvs_ate ate, delete_ate, close_ate;
+	uint32_t data;
+	ssize_t len;
+	int err;
+
+	close_ate.id = 0xffff;
+	close_ate.offset = fixture->fs.sector_size - sizeof(struct nvs_ate) * 3;
+	close_ate.len = 0;
+	close_ate.part = 0xff;
+	close_ate.crc8 = 0xff; /* Incorrect crc8 */
+
+	/* Data filling the sector up to the delete ate at -3 */
+	ate.id = 0x1;
+	ate.offset = 0;
+	ate.len = fixture->fs.sector_size - sizeof(struct nvs_ate) * 3;
+	ate.part = 0xff;
+	ate.crc8 = crc8_ccitt(0xff, &ate, offsetof(struct nvs_ate, crc8));
+
+	delete_ate.id = 0x1;
+	delete_ate.offset = ate.len;
+	delete_ate.len = 0;
+	delete_ate.part = 0xff;
+	delete_ate.crc8 = crc8_ccitt(0xff, &delete_ate, offsetof(struct nvs_ate, crc8));
+
+	/* Mark sector 0 as closed */
+	err = flash_write(fixture->fs.flash_device, fixture->fs.offset + fixture->fs.sector_size -
+			  sizeof(struct nvs_ate), &close_ate, sizeof(close_ate));
+	zassert_true(err == 0,  "flash_write failed: %d", err);
+
+	err = flash_write(fixture->fs.flash_device, fixture->fs.offset + fixture->fs.sector_size -
+			  sizeof(struct nvs_ate) * 2, &ate, sizeof(ate));
+	zassert_true(err == 0,  "flash_write failed: %d", err);
+
+	err = flash_write(fixture->fs.flash_device, fixture->fs.offset + fixture->fs.sector_size -
+			  sizeof(struct nvs_ate) * 3, &delete_ate, sizeof(delete_ate));
+	zassert_true(err == 0,  "flash_write failed: %d", err);
+
+	/* Mark sector 1 as closed */
+	err = flash_write(fixture->fs.flash_device,
+			  fixture->fs.offset + (2 * fixture->fs.sector_size) -
+			  sizeof(struct nvs_ate), &close_ate,
+			  sizeof(close_ate));
+	zassert_true(err == 0,  "flash_write failed: %d", err);
+
+	fixture->fs.sector_count = 3;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+
+	len = nvs_read(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(len, -ENOENT, "deleted entry should not be found: %d", (int)len);
+}
+
+/*
+ * Test that reading does not return an entry with an incorrect crc8 when it
+ * is the oldest one in the file system.
+ */
+ZTEST_F(nvs, test_nvs_read_corrupt_ate)
+{
+	struct nvs_ate corrupt_ate;
+	uint32_t data;
+	ssize_t len;
+	int err;
+
+	corrupt_ate.id = 0x1;
+	corrupt_ate.offset = 0;
+	corrupt_ate.len = sizeof(data);
+	corrupt_ate.part = 0xff;
+	corrupt_ate.crc8 = crc8_ccitt(0xff, &corrupt_ate, offsetof(struct nvs_ate, crc8)) ^ 0x01;
+
+	/* Write the corrupt ate in the first position of sector 0 */
+	err = flash_write(fixture->fs.flash_device, fixture->fs.offset + fixture->fs.sector_size -
+			  sizeof(struct nvs_ate) * 2, &corrupt_ate, sizeof(corrupt_ate));
+	zassert_true(err == 0,  "flash_write failed: %d", err);
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+
+	len = nvs_read(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(len, -ENOENT, "corrupt entry should not be read: %d", (int)len);
+}
+
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 static size_t num_matching_cache_entries(uint32_t addr, bool compare_sector_only, struct nvs_fs *fs)
 {
@@ -960,6 +1122,175 @@ ZTEST_F(nvs, test_nvs_cache_hash_quality)
 #endif
 }
 
+/*
+ * Test that writes go on while a sector is collected incrementally, and that
+ * a collection left pending is resumed on mount.
+ */
+ZTEST_F(nvs, test_nvs_gc_incremental)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	int err;
+	uint16_t i = 0;
+
+	const uint16_t max_id = 10;
+
+	fixture->fs.sector_count = 3;
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+
+	/* Fill the sectors until the first one is to be collected */
+	while (fixture->fs.gc.phase != NVS_GC_COPY) {
+		write_content(max_id, i, i + 1, &fixture->fs);
+		i++;
+	}
+
+	/* The next write fits beside the copies left to make */
+	write_content(max_id, i, i + 1, &fixture->fs);
+	i++;
+	zassert_equal(fixture->fs.gc.phase, NVS_GC_COPY, "gc should still be pending");
+	check_content(max_id, &fixture->fs);
+
+	do {
+		err = nvs_gc_step(&fixture->fs);
+		zassert_true(err >= 0, "nvs_gc_step call failure: %d", err);
+	} while (err > 0);
+
+	zassert_equal(fixture->fs.gc.phase, NVS_GC_IDLE, "gc should be done");
+	check_content(max_id, &fixture->fs);
+
+	/* Leave the next collection pending, as after a power loss */
+	while (fixture->fs.gc.phase != NVS_GC_COPY) {
+		write_content(max_id, i, i + 1, &fixture->fs);
+		i++;
+	}
+
+	err = nvs_gc_step(&fixture->fs);
+	zassert_true(err >= 0, "nvs_gc_step call failure: %d", err);
+	write_content(max_id, i, i + 1, &fixture->fs);
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+	zassert_equal(fixture->fs.gc.phase, NVS_GC_IDLE, "gc should be resumed");
+	check_content(max_id, &fixture->fs);
+
+	/* Ensure that the NVS is able to store new content. */
+	execute_long_pattern_write(max_id, &fixture->fs);
+#endif
+}
+
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+/* Leave a collection pending with entries of the collected sector to copy */
+static void gc_incremental_fill(uint16_t max_id, uint16_t keep_cnt,
+				struct nvs_fs *fs)
+{
+	uint8_t buf[32];
+	ssize_t len;
+	uint16_t i = 0;
+
+	for (uint16_t id = max_id; id < max_id + keep_cnt; id++) {
+		memset(buf, id, sizeof(buf));
+		len = nvs_write(fs, id, buf, sizeof(buf));
+		zassert_true(len == sizeof(buf), "nvs_write failed: %d", len);
+	}
+
+	while (fs->gc.phase != NVS_GC_COPY) {
+		write_content(max_id, i, i + 1, fs);
+		i++;
+	}
+}
+#endif
+
+/*
+ * Test that a collection resumed twice after power losses in the middle of a
+ * copy completes the copy in place.
+ */
+ZTEST_F(nvs, test_nvs_gc_incremental_torn_copies)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	int err;
+	ssize_t len;
+	uint8_t buf[32];
+	uint8_t rd_buf[32];
+	uint32_t data_wra;
+	uint32_t *flash_write_stat;
+	uint32_t *flash_erase_stat;
+	uint32_t *flash_max_write_calls;
+	uint32_t *flash_max_erase_calls;
+	uint32_t *flash_max_len;
+
+	const uint16_t max_id = 10;
+	const uint16_t keep_cnt = 4;
+
+	stats_walk(fixture->sim_thresholds, flash_sim_max_write_calls_find,
+		   &flash_max_write_calls);
+	stats_walk(fixture->sim_thresholds, flash_sim_max_erase_calls_find,
+		   &flash_max_erase_calls);
+	stats_walk(fixture->sim_thresholds, flash_sim_max_len_find,
+		   &flash_max_len);
+	stats_walk(fixture->sim_stats, flash_sim_write_calls_find, &flash_write_stat);
+	stats_walk(fixture->sim_stats, flash_sim_erase_calls_find, &flash_erase_stat);
+
+	/* Where the collection ends when resumed without further power loss */
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+
+	gc_incremental_fill(max_id, keep_cnt, &fixture->fs);
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+	data_wra = fixture->fs.data_wra;
+
+	err = nvs_clear(&fixture->fs);
+	zassert_true(err == 0,  "nvs_clear call failure: %d", err);
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+
+	gc_incremental_fill(max_id, keep_cnt, &fixture->fs);
+
+	for (int loss = 0; loss < 2; loss++) {
+		/* Only write the first half of the next copy, keep the
+		 * collected sector.
+		 */
+		*flash_write_stat = 0;
+		*flash_erase_stat = 0;
+		*flash_max_write_calls = 1;
+		*flash_max_erase_calls = 1;
+		*flash_max_len = sizeof(buf) / 2;
+
+		(void)nvs_mount(&fixture->fs);
+
+		*flash_max_write_calls = 0;
+		*flash_max_erase_calls = 0;
+		*flash_max_len = 0;
+
+		memset(&fixture->fs, 0, sizeof(fixture->fs));
+		(void)setup();
+		fixture->fs.sector_count = 3;
+	}
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+	zassert_equal(fixture->fs.gc.phase, NVS_GC_IDLE, "gc should be resumed");
+	zassert_equal(fixture->fs.data_wra, data_wra,
+		      "interrupted copies should not take extra space");
+
+	check_content(max_id, &fixture->fs);
+	for (uint16_t id = max_id; id < max_id + keep_cnt; id++) {
+		memset(buf, id, sizeof(buf));
+		len = nvs_read(&fixture->fs, id, rd_buf, sizeof(rd_buf));
+		zassert_true(len == sizeof(rd_buf), "nvs_read unexpected failure: %d", len);
+		zassert_mem_equal(buf, rd_buf, sizeof(rd_buf),
+				  "RD buff should be equal to the WR buff");
+	}
+
+	/* Ensure that the NVS is able to store new content. */
+	execute_long_pattern_write(max_id, &fixture->fs);
+#endif
+}
+
 /*
  * Test NVS bad region initialization recovery.
  */
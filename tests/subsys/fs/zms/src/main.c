@@ -889,3 +889,70 @@ ZTEST_F(zms, test_zms_cache_hash_quality)
 
 #endif
 }
+
+/*
+ * Test ZMS lookup index when it is full and once rebuilt.
+ */
+ZTEST_F(zms, test_zms_index)
+{
+#ifdef CONFIG_ZMS_LOOKUP_INDEX
+	const uint32_t NUM_IDS = CONFIG_ZMS_LOOKUP_INDEX_SIZE;
+	int err;
+	ssize_t len;
+	uint32_t data;
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+	zassert_true(fixture->fs.index_complete, "index incomplete after mount");
+
+	/* Write more IDs than the index holds */
+
+	for (uint32_t id = 0; id < NUM_IDS; id++) {
+		data = id * 3;
+		len = zms_write(&fixture->fs, id * 5, &data, sizeof(data));
+		zassert_equal(len, sizeof(data), "zms_write call failure: %d", len);
+	}
+
+	zassert_false(fixture->fs.index_complete, "full index still complete");
+
+	/* IDs left out of the index are found all the same */
+
+	for (uint32_t id = 0; id < NUM_IDS; id++) {
+		len = zms_read(&fixture->fs, id * 5, &data, sizeof(data));
+		zassert_equal(len, sizeof(data), "zms_read call failure: %d", len);
+		zassert_equal(data, id * 3, "incorrect data read");
+	}
+
+	/* Delete half of the IDs */
+
+	for (uint32_t id = 0; id < NUM_IDS; id += 2) {
+		err = zms_delete(&fixture->fs, id * 5);
+		zassert_true(err == 0, "zms_delete call failure: %d", err);
+	}
+
+	/* Once rebuilt, the index holds all IDs and misses are conclusive */
+
+	err = zms_mount(&fixture->fs);
+	zassert_true(err == 0, "zms_mount call failure: %d", err);
+	zassert_true(fixture->fs.index_complete, "index incomplete after mount");
+	zassert_equal(fixture->fs.index_used, NUM_IDS / 2, "invalid index content");
+
+	for (uint32_t id = 0; id < NUM_IDS; id++) {
+		len = zms_read(&fixture->fs, id * 5, &data, sizeof(data));
+		if (id % 2) {
+			zassert_equal(len, sizeof(data), "zms_read call failure: %d", len);
+			zassert_equal(data, id * 3, "incorrect data read");
+		} else {
+			zassert_equal(len, -ENOENT, "deleted ID found: %d", len);
+		}
+	}
+
+	/* The previous versions of the deleted IDs are still in the history */
+
+	for (uint32_t id = 0; id < NUM_IDS; id += 2) {
+		len = zms_read_hist(&fixture->fs, id * 5, &data, sizeof(data), 1);
+		zassert_equal(len, sizeof(data), "zms_read_hist call failure: %d", len);
+		zassert_equal(data, id * 3, "incorrect data read");
+	}
+#endif
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_backend.h>
+
+LOG_MODULE_REGISTER(test);
+
+/* Each argument is the ID of the logging CPU and a sequence number */
+#define SEQ_BITS 24
+#define MSGS_PER_CPU 32
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+struct mock_log_backend {
+	log_timestamp_t last_timestamp;
+	uint32_t next_seq[CONFIG_MP_MAX_NUM_CPUS];
+	uint32_t cnt;
+	uint32_t unordered;
+	uint32_t out_of_seq;
+	uint32_t dropped;
+};
+
+static struct mock_log_backend mock_backend;
+
+static K_THREAD_STACK_ARRAY_DEFINE(logger_stack, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread logger_thread[CONFIG_MP_MAX_NUM_CPUS];
+static atomic_t start_flag;
+
+/* Unique and increasing across CPUs, so that the order is well defined
+ * even when two CPUs log within the same tick.
+ */
+static atomic_t timestamp_cnt;
+
+static log_timestamp_t timestamp_get(void)
+{
+	return (log_timestamp_t)atomic_inc(&timestamp_cnt) + 1;
+}
+
+static void process(const struct log_backend *const backend,
+		    union log_msg_generic *msg)
+{
+	log_timestamp_t timestamp = log_msg_get_timestamp(&msg->log);
+	size_t len;
+	uint8_t *package = log_msg_get_package(&msg->log, &len);
+	uint32_t arg;
+	uint32_t cpu;
+
+	memcpy(&arg, package + 2 * sizeof(void *), sizeof(arg));
+	cpu = arg >> SEQ_BITS;
+
+	if (timestamp <= mock_backend.last_timestamp) {
+		mock_backend.unordered++;
+	}
+
+	if ((cpu >= ARRAY_SIZE(mock_backend.next_seq)) ||
+	    ((arg & BIT_MASK(SEQ_BITS)) != mock_backend.next_seq[cpu]++)) {
+		mock_backend.out_of_seq++;
+	}
+
+	mock_backend.last_timestamp = timestamp;
+	mock_backend.cnt++;
+}
+
+static void mock_init(struct log_backend const *const backend)
+{
+
+}
+
+static void panic(struct log_backend const *const backend)
+{
+	zassert_true(false);
+}
+
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	mock_backend.dropped += cnt;
+}
+
+static const struct log_backend_api log_backend_api = {
+	.process = process,
+	.panic = panic,
+	.init = mock_init,
+	.dropped = dropped,
+};
+
+LOG_BACKEND_DEFINE(test, log_backend_api, true, NULL);
+
+static void logger_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t cpu = (uint32_t)(uintptr_t)p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!atomic_get(&start_flag)) {
+		arch_spin_relax();
+	}
+
+	for (uint32_t seq = 0; seq < MSGS_PER_CPU; seq++) {
+		LOG_INF("%u", (cpu << SEQ_BITS) | seq);
+	}
+}
+
+static void log_all_cpus(unsigned int num_cpus)
+{
+	for (unsigned int cpu = 0; cpu < num_cpus; cpu++) {
+		k_thread_create(&logger_thread[cpu], logger_stack[cpu], STACK_SIZE,
+				logger_entry, (void *)(uintptr_t)cpu, NULL, NULL,
+				K_PRIO_PREEMPT(5), 0, K_FOREVER);
+		zassert_ok(k_thread_cpu_pin(&logger_thread[cpu], cpu));
+		k_thread_start(&logger_thread[cpu]);
+	}
+
+	/* Let the loggers on the other CPUs reach the start line, the one
+	 * sharing this CPU starts once we block.
+	 */
+	k_busy_wait(10000);
+	atomic_set(&start_flag, 1);
+
+	for (unsigned int cpu = 0; cpu < num_cpus; cpu++) {
+		zassert_ok(k_thread_join(&logger_thread[cpu], K_SECONDS(5)));
+	}
+
+	atomic_clear(&start_flag);
+}
+
+ZTEST(log_cpu_buffers, test_timestamp_order)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	uint32_t cpu_dropped;
+
+	log_all_cpus(num_cpus);
+
+	while (log_process()) {
+	}
+
+	zassert_equal(mock_backend.dropped, 0, "%u messages dropped",
+		      mock_backend.dropped);
+	zassert_equal(mock_backend.cnt, num_cpus * MSGS_PER_CPU,
+		      "got %u messages", mock_backend.cnt);
+	zassert_equal(mock_backend.unordered, 0,
+		      "%u messages older than the previous one",
+		      mock_backend.unordered);
+	zassert_equal(mock_backend.out_of_seq, 0,
+		      "%u messages out of their CPU sequence",
+		      mock_backend.out_of_seq);
+
+	for (unsigned int cpu = 0; cpu < num_cpus; cpu++) {
+		zassert_ok(log_dropped_cpu_get(cpu, &cpu_dropped));
+		zassert_equal(cpu_dropped, 0, "CPU %u dropped %u messages",
+			      cpu, cpu_dropped);
+	}
+}
+
+static void *setup(void)
+{
+	zassert_ok(log_set_timestamp_func(timestamp_get, 1000000));
+
+	return NULL;
+}
+
+ZTEST_SUITE(log_cpu_buffers, NULL, setup, NULL, NULL, NULL);
@@ -35,13 +35,37 @@ static void dummy_submit(struct rtio_iodev_sqe *iodev_sqe)
 	rtio_work_req_submit(req, iodev_sqe, work_handler);
 }
 
+/** Records the order in which requests are run */
+static uintptr_t order[3];
+static int order_count;
+
+static void order_handler(struct rtio_iodev_sqe *iodev_sqe)
+{
+	order[order_count++] = (uintptr_t)iodev_sqe->sqe.userdata;
+
+	rtio_executor_ok(iodev_sqe, 0);
+}
+
+static void order_submit(struct rtio_iodev_sqe *iodev_sqe)
+{
+	struct rtio_work_req *req = rtio_work_req_alloc();
+
+	rtio_work_req_submit(req, iodev_sqe, order_handler);
+}
+
 struct rtio_iodev_api r_iodev_test_api = {
 	.submit = dummy_submit,
 };
 
+struct rtio_iodev_api r_iodev_order_api = {
+	.submit = order_submit,
+};
+
 RTIO_IODEV_DEFINE(dummy_iodev, &r_iodev_test_api, NULL);
 RTIO_IODEV_DEFINE(dummy_iodev_2, &r_iodev_test_api, NULL);
 RTIO_IODEV_DEFINE(dummy_iodev_3, &r_iodev_test_api, NULL);
+RTIO_IODEV_DEFINE(order_iodev, &r_iodev_order_api, NULL);
+RTIO_IODEV_DEFINE(order_iodev_2, &r_iodev_order_api, NULL);
 
 RTIO_DEFINE(r_test, 3, 3);
 RTIO_DEFINE(r_test_2, 3, 3);
@@ -58,6 +82,7 @@ static void before(void *unused)
 	k_sem_init(&work_handler_sem_3, 0, 1);
 
 	work_handler_called = 0;
+	order_count = 0;
 }
 
 static void after(void *unused)
@@ -170,6 +195,103 @@ ZTEST(rtio_work, test_work_supports_preempting_on_higher_prio_submissions)
 	rtio_cqe_release(&r_test_3, cqe);
 }
 
+ZTEST(rtio_work, test_work_limits_requests_in_flight_per_iodev)
+{
+	struct rtio_sqe *sqe_a;
+	struct rtio_sqe *sqe_b;
+	struct rtio_sqe *sqe_c;
+	struct rtio_cqe *cqe;
+
+	if (CONFIG_RTIO_WORKQ_IODEV_INFLIGHT != 1) {
+		ztest_test_skip();
+	}
+
+	/** Two requests of a slow iodev, then one of another iodev */
+	sqe_a = rtio_sqe_acquire(&r_test);
+	rtio_sqe_prep_nop(sqe_a, &dummy_iodev, &work_handler_sem_1);
+	sqe_a->prio = RTIO_PRIO_NORM;
+
+	sqe_b = rtio_sqe_acquire(&r_test);
+	rtio_sqe_prep_nop(sqe_b, &dummy_iodev, &work_handler_sem_2);
+	sqe_b->prio = RTIO_PRIO_NORM;
+
+	sqe_c = rtio_sqe_acquire(&r_test);
+	rtio_sqe_prep_nop(sqe_c, &dummy_iodev_2, &work_handler_sem_3);
+	sqe_c->prio = RTIO_PRIO_NORM;
+
+	zassert_ok(rtio_submit(&r_test, 0));
+
+	/** The second request of the slow iodev waits, the other iodev does not */
+	zassert_equal(2, work_handler_called);
+	zassert_equal(3, rtio_work_req_used_count_get());
+
+	k_sem_give(&work_handler_sem_3);
+	zassert_equal(2, work_handler_called);
+	zassert_equal(2, rtio_work_req_used_count_get());
+
+	k_sem_give(&work_handler_sem_1);
+	zassert_equal(3, work_handler_called);
+	zassert_equal(1, rtio_work_req_used_count_get());
+
+	k_sem_give(&work_handler_sem_2);
+	zassert_equal(0, rtio_work_req_used_count_get());
+
+	/** Clean-up */
+	cqe = rtio_cqe_consume_block(&r_test);
+	rtio_cqe_release(&r_test, cqe);
+	cqe = rtio_cqe_consume_block(&r_test);
+	rtio_cqe_release(&r_test, cqe);
+	cqe = rtio_cqe_consume_block(&r_test);
+	rtio_cqe_release(&r_test, cqe);
+}
+
+ZTEST(rtio_work, test_work_takes_contexts_in_turn)
+{
+	int prio = k_thread_priority_get(k_current_get());
+	struct rtio_sqe *sqe_a;
+	struct rtio_sqe *sqe_b;
+	struct rtio_sqe *sqe_c;
+	struct rtio_cqe *cqe;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_RTIO_WORKQ_FAIR);
+
+	/** Let the deadlines of the requests of the previous tests pass */
+	k_msleep(1);
+
+	sqe_a = rtio_sqe_acquire(&r_test);
+	rtio_sqe_prep_nop(sqe_a, &order_iodev, (void *)1);
+	sqe_a->prio = RTIO_PRIO_NORM;
+
+	sqe_b = rtio_sqe_acquire(&r_test);
+	rtio_sqe_prep_nop(sqe_b, &order_iodev, (void *)2);
+	sqe_b->prio = RTIO_PRIO_NORM;
+
+	sqe_c = rtio_sqe_acquire(&r_test_2);
+	rtio_sqe_prep_nop(sqe_c, &order_iodev_2, (void *)3);
+	sqe_c->prio = RTIO_PRIO_NORM;
+
+	/** Queue all requests before any thread takes one */
+	k_thread_priority_set(k_current_get(), CONFIG_RTIO_WORKQ_PRIO_MED - 2);
+
+	zassert_ok(rtio_submit(&r_test, 0));
+	zassert_ok(rtio_submit(&r_test_2, 0));
+	zassert_equal(0, order_count);
+
+	k_thread_priority_set(k_current_get(), prio);
+
+	/** The request of the second context is not queued behind both of the first one */
+	zassert_equal(3, order_count);
+	zassert_equal(2, order[2]);
+
+	/** Clean-up */
+	cqe = rtio_cqe_consume_block(&r_test);
+	rtio_cqe_release(&r_test, cqe);
+	cqe = rtio_cqe_consume_block(&r_test);
+	rtio_cqe_release(&r_test, cqe);
+	cqe = rtio_cqe_consume_block(&r_test_2);
+	rtio_cqe_release(&r_test_2, cqe);
+}
+
 ZTEST(rtio_work, test_used_count_keeps_track_of_alloc_items)
 {
 	struct rtio_work_req *req_a = NULL;
@@ -13,11 +13,15 @@
 #include <zephyr/ztest.h>
 #include <errno.h>
 #include <zephyr/settings/settings.h>
+#include <zephyr/sys/panic_flush.h>
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(settings_basic_test);
 
 #if defined(CONFIG_SETTINGS_FCB) || defined(CONFIG_SETTINGS_NVS)
 #include <zephyr/storage/flash_map.h>
+#if defined(CONFIG_SETTINGS_NVS)
+#include <zephyr/fs/nvs.h>
+#endif
 #if DT_HAS_CHOSEN(zephyr_settings_partition)
 #define TEST_FLASH_AREA_ID DT_FIXED_PARTITION_ID(DT_CHOSEN(zephyr_settings_partition))
 #endif
@@ -619,3 +623,161 @@ ZTEST(settings_functional, test_direct_loading_filter)
 	}
 	settings_deregister(&filtered_loader_settings);
 }
+
+#if defined(CONFIG_SETTINGS_WRITE_BACK)
+static int wb_loader(const char *key, size_t len, settings_read_cb read_cb,
+		     void *cb_arg, void *param)
+{
+	uint32_t *val = param;
+
+	if (settings_name_steq(key, "key", NULL) && (len == sizeof(*val))) {
+		zassert_equal(read_cb(cb_arg, val, sizeof(*val)), sizeof(*val));
+	}
+
+	return 0;
+}
+
+ZTEST(settings_functional, test_write_back)
+{
+	struct settings_write_back_stats before, after;
+	uint32_t val;
+	int rc;
+
+	rc = settings_write_back_stats_get(&before);
+	zassert_equal(0, rc);
+
+	rc = settings_save_batch_begin();
+	zassert_equal(0, rc);
+
+	for (val = 1; val <= 5; val++) {
+		rc = settings_save_one("wb/key", &val, sizeof(val));
+		zassert_equal(0, rc);
+	}
+
+	rc = settings_save_one("wb/other", &val, sizeof(val));
+	zassert_equal(0, rc);
+	rc = settings_delete("wb/other");
+	zassert_equal(0, rc);
+
+	rc = settings_write_back_stats_get(&after);
+	zassert_equal(0, rc);
+	zassert_equal(after.writes, before.writes, "nothing written during a batch");
+
+	rc = settings_save_batch_commit();
+	zassert_equal(0, rc);
+
+	rc = settings_write_back_stats_get(&after);
+	zassert_equal(0, rc);
+	zassert_equal(after.saves - before.saves, 7);
+	zassert_equal(after.merged - before.merged, 5, "repeated saves should be merged");
+	zassert_equal(after.writes - before.writes, 2, "one write per setting expected");
+
+	rc = settings_save_batch_commit();
+	zassert_equal(-EINVAL, rc, "commit without a batch should fail");
+
+	/* A pending save is visible to a load */
+	val = 42;
+	rc = settings_save_one("wb/key", &val, sizeof(val));
+	zassert_equal(0, rc);
+
+	val = 0;
+	rc = settings_load_subtree_direct("wb", wb_loader, &val);
+	zassert_equal(0, rc);
+	zassert_equal(val, 42, "pending save not loaded");
+
+	rc = settings_delete("wb/key");
+	zassert_equal(0, rc);
+	rc = settings_flush();
+	zassert_equal(0, rc);
+}
+
+#if defined(CONFIG_SETTINGS_NVS)
+static K_THREAD_STACK_DEFINE(wb_holder_stack, 1024);
+static struct k_thread wb_holder_thread;
+static K_SEM_DEFINE(wb_held, 0, 1);
+static K_SEM_DEFINE(wb_release, 0, 1);
+
+/* Hold the NVS lock like a write in progress in another thread would, until
+ * released or for the time in milliseconds given as p2 if not 0.
+ */
+static void wb_holder(void *p1, void *p2, void *p3)
+{
+	struct nvs_fs *fs = p1;
+	int hold_ms = POINTER_TO_INT(p2);
+
+	ARG_UNUSED(p3);
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	k_sem_give(&wb_held);
+	(void)k_sem_take(&wb_release, (hold_ms != 0) ? K_MSEC(hold_ms) : K_FOREVER);
+	k_mutex_unlock(&fs->nvs_lock);
+}
+#endif /* CONFIG_SETTINGS_NVS */
+
+ZTEST(settings_functional, test_write_back_panic_flush)
+{
+	struct settings_write_back_stats before, after;
+	uint32_t val = 7;
+	int rc;
+
+	rc = settings_save_one("wb/panic", &val, sizeof(val));
+	zassert_equal(0, rc);
+
+	rc = settings_write_back_stats_get(&before);
+	zassert_equal(0, rc);
+
+#if defined(CONFIG_SETTINGS_NVS)
+	void *storage;
+
+	rc = settings_storage_get(&storage);
+	zassert_equal(0, rc);
+
+	k_thread_create(&wb_holder_thread, wb_holder_stack,
+			K_THREAD_STACK_SIZEOF(wb_holder_stack), wb_holder,
+			storage, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_equal(0, k_sem_take(&wb_held, K_SECONDS(1)));
+
+	/* The storage is in use, waiting for it could hang a panic */
+	sys_panic_flush_run(K_NO_WAIT);
+
+	rc = settings_write_back_stats_get(&after);
+	zassert_equal(0, rc);
+	zassert_equal(after.writes, before.writes, "written while the storage is in use");
+
+	k_sem_give(&wb_release);
+	zassert_equal(0, k_thread_join(&wb_holder_thread, K_SECONDS(1)));
+
+	/* The storage lock is recursive, a panic in the middle of a write of
+	 * the current thread must not write into it.
+	 */
+	k_mutex_lock(&((struct nvs_fs *)storage)->nvs_lock, K_FOREVER);
+	sys_panic_flush_run(K_MSEC(100));
+	k_mutex_unlock(&((struct nvs_fs *)storage)->nvs_lock);
+
+	rc = settings_write_back_stats_get(&after);
+	zassert_equal(0, rc);
+	zassert_equal(after.writes, before.writes, "written in the middle of a write");
+
+	/* On reboot, a storage in use for a short while is waited for */
+	k_thread_create(&wb_holder_thread, wb_holder_stack,
+			K_THREAD_STACK_SIZEOF(wb_holder_stack), wb_holder,
+			storage, INT_TO_POINTER(10), NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_equal(0, k_sem_take(&wb_held, K_SECONDS(1)));
+
+	sys_panic_flush_run(K_SECONDS(1));
+
+	zassert_equal(0, k_thread_join(&wb_holder_thread, K_SECONDS(1)));
+#else
+	sys_panic_flush_run(K_NO_WAIT);
+#endif /* CONFIG_SETTINGS_NVS */
+
+	rc = settings_write_back_stats_get(&after);
+	zassert_equal(0, rc);
+	zassert_equal(after.writes - before.writes, 1, "pending save not written");
+
+	rc = settings_delete("wb/panic");
+	zassert_equal(0, rc);
+	rc = settings_flush();
+	zassert_equal(0, rc);
+}
+#endif /* CONFIG_SETTINGS_WRITE_BACK */
@@ -394,6 +394,137 @@ ZTEST(lib_stream_flash, test_stream_flash_flush)
 	zassert_equal(rc, 0, "expected success");
 }
 
+#ifdef CONFIG_STREAM_FLASH_WRITE_BEHIND
+ZTEST(lib_stream_flash, test_stream_flash_write_behind)
+{
+	static uint8_t wb_bufs[2 * BUF_LEN];
+	size_t total = (2 * page_size) + (BUF_LEN / 2);
+	size_t chunk = 100;
+	size_t done;
+	int rc;
+
+	init_target();
+
+	rc = stream_flash_write_behind(&ctx, wb_bufs, 0);
+	zassert_equal(rc, -EINVAL, "should fail as there are no buffers");
+
+	rc = stream_flash_write_behind(&ctx, wb_bufs, 2);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_write_behind(&ctx, wb_bufs, 2);
+	zassert_equal(rc, -EBUSY, "should fail as already enabled");
+
+	/* Chunks crossing buffer and page borders */
+	for (done = 0; done < total; done += chunk) {
+		rc = stream_flash_buffered_write(&ctx, write_buf, MIN(chunk, total - done),
+						 false);
+		zassert_equal(rc, 0, "expected success");
+		zassert_true(stream_flash_bytes_written(&ctx) <= done + chunk,
+			     "more bytes written than buffered");
+	}
+
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), total, "all bytes should be written");
+
+	VERIFY_WRITTEN(0, total);
+
+	/* Writing past the available area is refused, buffered bytes included */
+	init_target();
+
+	rc = stream_flash_write_behind(&ctx, wb_bufs, 2);
+	zassert_equal(rc, 0, "expected success");
+
+	ctx.available = 3 * BUF_LEN;
+	rc = stream_flash_buffered_write(&ctx, write_buf, 3 * BUF_LEN, false);
+	zassert_equal(rc, 0, "expected success");
+	rc = stream_flash_buffered_write(&ctx, write_buf, 1, false);
+	zassert_equal(rc, -ENOMEM, "should fail as area is full");
+
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, 0, "expected success");
+	VERIFY_WRITTEN(0, 3 * BUF_LEN);
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_write_behind_error)
+{
+	static uint8_t wb_bufs[BUF_LEN];
+	int rc;
+
+	init_target();
+
+	rc = stream_flash_write_behind(&ctx, wb_bufs, 1);
+	zassert_equal(rc, 0, "expected success");
+
+	/* A failing write in the background is reported by the next write */
+	cb_ret = -EFAULT;
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, false);
+	zassert_true(rc == 0 || rc == -EFAULT, "unexpected error %d", rc);
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, 1, true);
+	zassert_equal(rc, -EFAULT, "expected failure from callback");
+	zassert_equal(stream_flash_bytes_written(&ctx), 0, "no bytes should be written");
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, 1, false);
+	zassert_equal(rc, -EFAULT, "error should be kept");
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_write_behind_stop)
+{
+	static uint8_t wb_bufs[2 * BUF_LEN];
+	int rc;
+
+	init_target();
+
+	rc = stream_flash_write_behind(&ctx, wb_bufs, 2);
+	zassert_equal(rc, 0, "expected success");
+
+	/* Two full buffers wait for the work queue, which has not run yet */
+	rc = stream_flash_buffered_write(&ctx, write_buf, 2 * BUF_LEN, false);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_write_behind_stop(&ctx);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), 0, "no bytes should be written");
+
+	/* Restart the stream */
+	rc = stream_flash_init(&ctx, fdev, generic_buf, BUF_LEN, FLASH_BASE, FLASH_AVAILABLE,
+			       stream_flash_callback);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_write_behind(&ctx, wb_bufs, 2);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, true);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), BUF_LEN,
+		      "buffers of the previous stream should be dropped");
+
+	VERIFY_WRITTEN(0, BUF_LEN);
+	VERIFY_ERASED(BUF_LEN, BUF_LEN);
+}
+
+ZTEST(lib_stream_flash, test_stream_flash_write_behind_init_garbage)
+{
+	struct stream_flash_ctx stack_ctx;
+	int rc;
+
+	erase_flash();
+
+	/* Initializing must not look at what the context held before */
+	memset(&stack_ctx, 0xa5, sizeof(stack_ctx));
+	rc = stream_flash_init(&stack_ctx, fdev, generic_buf, BUF_LEN, FLASH_BASE,
+			       FLASH_AVAILABLE, NULL);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_buffered_write(&stack_ctx, write_buf, BUF_LEN, true);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&stack_ctx), BUF_LEN, "expected BUF_LEN");
+
+	VERIFY_WRITTEN(0, BUF_LEN);
+}
+#endif
+
 #ifdef CONFIG_STREAM_FLASH_ERASE
 ZTEST(lib_stream_flash, test_stream_flash_buffered_write_whole_page)
 {
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/ztest.h>
+#include <zephyr/ztest_assert.h>
+
+#define LOANS 3
+
+struct frame_meta {
+	uint32_t seq;
+	uint8_t payload[60];
+};
+
+static const void *lis_msg;
+static uint32_t lis_seq;
+
+static void lis_cb(const struct zbus_channel *chan)
+{
+	const struct frame_meta *meta = zbus_chan_const_msg(chan);
+
+	lis_msg = meta;
+	lis_seq = meta->seq;
+}
+
+ZBUS_LISTENER_DEFINE(lis, lis_cb);
+ZBUS_MSG_SUBSCRIBER_DEFINE(msg_sub);
+
+ZBUS_CHAN_DEFINE(chan, struct frame_meta, NULL, NULL, ZBUS_OBSERVERS(lis, msg_sub),
+		 ZBUS_MSG_INIT(0));
+
+ZBUS_LOAN_POOL_DEFINE(loan_pool, struct frame_meta, LOANS);
+
+static int publish(uint32_t seq, struct net_buf **loaned)
+{
+	struct frame_meta *meta;
+	struct net_buf *buf;
+	int err;
+
+	err = zbus_chan_loan(&chan, &buf, K_NO_WAIT);
+	if (err) {
+		return err;
+	}
+
+	zassert_equal(sizeof(struct frame_meta), buf->len);
+
+	meta = (struct frame_meta *)buf->data;
+	meta->seq = seq;
+	memset(meta->payload, (uint8_t)seq, sizeof(meta->payload));
+
+	if (loaned != NULL) {
+		*loaned = buf;
+	}
+
+	return zbus_chan_commit(&chan, buf, K_NO_WAIT);
+}
+
+static void drain(void)
+{
+	const struct zbus_channel *from;
+	struct net_buf *buf;
+
+	while (zbus_sub_wait_msg_ref(&msg_sub, &from, &buf, K_NO_WAIT) == 0) {
+		zbus_msg_release(buf);
+	}
+}
+
+static void *setup(void)
+{
+	zbus_chan_set_loan_pool(&chan, &loan_pool);
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	struct frame_meta zero = {0};
+
+	ARG_UNUSED(fixture);
+
+	drain();
+
+	/* Back to the channel's own message, returning its loan to the pool */
+	zassert_ok(zbus_chan_pub(&chan, &zero, K_NO_WAIT));
+	drain();
+}
+
+ZTEST_SUITE(loaned_msg, NULL, setup, before, NULL, NULL);
+
+ZTEST(loaned_msg, test_commit_is_zero_copy)
+{
+	const struct zbus_channel *from;
+	struct net_buf *loaned;
+	struct net_buf *buf;
+	struct frame_meta meta;
+
+	zassert_ok(publish(1, &loaned));
+
+	/* The listener read the message in place */
+	zassert_equal(1, lis_seq);
+	zassert_equal_ptr(loaned->data, lis_msg);
+
+	/* The message subscriber got a reference to the same buffer */
+	zassert_ok(zbus_sub_wait_msg_ref(&msg_sub, &from, &buf, K_NO_WAIT));
+	zassert_equal_ptr(&chan, from);
+	zassert_equal_ptr(loaned, buf);
+	zbus_msg_release(buf);
+
+	/* So does a reader */
+	zassert_ok(zbus_chan_read_ref(&chan, &buf, K_NO_WAIT));
+	zassert_equal_ptr(loaned, buf);
+	zbus_msg_release(buf);
+
+	/* Reading by copy still works */
+	zassert_ok(zbus_chan_read(&chan, &meta, K_NO_WAIT));
+	zassert_equal(1, meta.seq);
+	zassert_equal(1, meta.payload[sizeof(meta.payload) - 1]);
+}
+
+ZTEST(loaned_msg, test_copy_subscribers_get_loaned_msg)
+{
+	const struct zbus_channel *from;
+	struct frame_meta meta;
+
+	zassert_ok(publish(2, NULL));
+	zassert_ok(publish(3, NULL));
+
+	zassert_ok(zbus_sub_wait_msg(&msg_sub, &from, &meta, K_NO_WAIT));
+	zassert_equal(2, meta.seq);
+	zassert_ok(zbus_sub_wait_msg(&msg_sub, &from, &meta, K_NO_WAIT));
+	zassert_equal(3, meta.seq);
+	zassert_equal(3, meta.payload[0]);
+}
+
+ZTEST(loaned_msg, test_buffers_return_to_pool)
+{
+	const struct zbus_channel *from;
+	struct net_buf *held;
+	struct net_buf *extra;
+	struct net_buf *buf;
+
+	/* One buffer holds the channel's message, another one is held by the subscriber */
+	zassert_ok(publish(4, NULL));
+	zassert_ok(publish(5, NULL));
+	zassert_ok(zbus_sub_wait_msg_ref(&msg_sub, &from, &held, K_NO_WAIT));
+	zassert_equal(4, ((struct frame_meta *)held->data)->seq);
+
+	/* Only the subscriber's notification of the last message keeps it now */
+	zassert_ok(zbus_sub_wait_msg_ref(&msg_sub, &from, &buf, K_NO_WAIT));
+	zbus_msg_release(buf);
+
+	zassert_ok(zbus_chan_loan(&chan, &buf, K_NO_WAIT));
+	zassert_equal(-ENOMEM, zbus_chan_loan(&chan, &extra, K_NO_WAIT));
+	zbus_msg_release(buf);
+
+	/* Releasing the held message frees its buffer */
+	zbus_msg_release(held);
+	zassert_ok(zbus_chan_loan(&chan, &buf, K_NO_WAIT));
+	zassert_ok(zbus_chan_loan(&chan, &extra, K_NO_WAIT));
+	zbus_msg_release(buf);
+	zbus_msg_release(extra);
+}
+
+ZTEST(loaned_msg, test_claim_and_pub_drop_the_loan)
+{
+	struct frame_meta *meta;
+	struct frame_meta val = {.seq = 7};
+	struct net_buf *bufs[LOANS];
+	struct net_buf *buf;
+
+	zassert_ok(publish(6, NULL));
+	drain();
+
+	/* Claiming copies the message back, since it may be modified in place */
+	zassert_ok(zbus_chan_claim(&chan, K_NO_WAIT));
+	meta = zbus_chan_msg(&chan);
+	zassert_equal(6, meta->seq);
+	meta->seq = 16;
+	zassert_ok(zbus_chan_finish(&chan));
+	zassert_equal(-ENODATA, zbus_chan_read_ref(&chan, &buf, K_NO_WAIT));
+
+	zassert_ok(zbus_chan_read(&chan, &val, K_NO_WAIT));
+	zassert_equal(16, val.seq);
+
+	zassert_ok(publish(8, NULL));
+	drain();
+	val.seq = 9;
+	zassert_ok(zbus_chan_pub(&chan, &val, K_NO_WAIT));
+	zassert_equal(9, lis_seq);
+	zassert_equal(-ENODATA, zbus_chan_read_ref(&chan, &buf, K_NO_WAIT));
+
+	/* All buffers are back */
+	for (int i = 0; i < LOANS; i++) {
+		zassert_ok(zbus_chan_loan(&chan, &bufs[i], K_NO_WAIT));
+	}
+	for (int i = 0; i < LOANS; i++) {
+		zbus_msg_release(bufs[i]);
+	}
+}
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/ztest.h>
+#include <zephyr/ztest_assert.h>
+
+#define SAMPLE_WORDS 16
+#define PUBLISHES    5000
+
+struct sample_msg {
+	uint32_t words[SAMPLE_WORDS];
+};
+
+static uint32_t lis_word;
+static int lis_prio;
+
+static void lis_cb(const struct zbus_channel *chan)
+{
+	const struct sample_msg *msg = zbus_chan_const_msg(chan);
+
+	lis_word = msg->words[0];
+	lis_prio = k_thread_priority_get(k_current_get());
+}
+
+ZBUS_LISTENER_DEFINE(lis, lis_cb);
+ZBUS_MSG_SUBSCRIBER_DEFINE(msg_sub);
+
+ZBUS_CHAN_DEFINE_SEQLOCK(chan, struct sample_msg, NULL, NULL, ZBUS_OBSERVERS(lis, msg_sub),
+			 ZBUS_MSG_INIT(.words = {7}));
+
+ZBUS_CHAN_DEFINE(locked_chan, struct sample_msg, NULL, NULL, ZBUS_OBSERVERS(lis, msg_sub),
+		 ZBUS_MSG_INIT(0));
+
+static void fill(struct sample_msg *msg, uint32_t word)
+{
+	for (int i = 0; i < SAMPLE_WORDS; i++) {
+		msg->words[i] = word;
+	}
+}
+
+static void drain(void)
+{
+	const struct zbus_channel *from;
+	struct sample_msg msg;
+
+	while (zbus_sub_wait_msg(&msg_sub, &from, &msg, K_NO_WAIT) == 0) {
+	}
+}
+
+static void before(void *f)
+{
+	ARG_UNUSED(f);
+
+	drain();
+}
+
+ZTEST_SUITE(seqlock, NULL, NULL, before, NULL, NULL);
+
+ZTEST(seqlock, test_pub_and_read)
+{
+	const struct zbus_channel *from;
+	struct sample_msg msg;
+
+	zassert_equal(0, zbus_chan_read(&chan, &msg, K_NO_WAIT));
+	zassert_equal(7, msg.words[0], "initial value not read");
+
+	for (uint32_t word = 1; word <= 3; word++) {
+		fill(&msg, word);
+		zassert_equal(0, zbus_chan_pub(&chan, &msg, K_NO_WAIT));
+
+		zassert_equal(word, lis_word, "listener did not see the published message");
+
+		memset(&msg, 0, sizeof(msg));
+		zassert_equal(0, zbus_sub_wait_msg(&msg_sub, &from, &msg, K_NO_WAIT));
+		zassert_equal_ptr(&chan, from);
+		zassert_equal(word, msg.words[SAMPLE_WORDS - 1]);
+
+		memset(&msg, 0, sizeof(msg));
+		zassert_equal(0, zbus_chan_read(&chan, &msg, K_NO_WAIT));
+		zassert_equal(word, msg.words[0]);
+		zassert_equal(word, msg.words[SAMPLE_WORDS - 1]);
+	}
+}
+
+ZTEST(seqlock, test_read_does_not_lock)
+{
+	struct sample_msg msg;
+
+	fill(&msg, 42);
+	zassert_equal(0, zbus_chan_pub(&chan, &msg, K_NO_WAIT));
+	drain();
+
+	zassert_equal(0, zbus_chan_claim(&chan, K_NO_WAIT));
+
+	memset(&msg, 0, sizeof(msg));
+	zassert_equal(0, zbus_chan_read(&chan, &msg, K_NO_WAIT), "read waited for the claim");
+	zassert_equal(42, msg.words[0]);
+
+	/* Publishers are still serialized */
+	zassert_equal(-EBUSY, zbus_chan_pub(&chan, &msg, K_NO_WAIT));
+
+	zassert_equal(0, zbus_chan_finish(&chan));
+}
+
+static struct k_timer reader_timer;
+static uint32_t reads;
+static uint32_t torn_reads;
+
+/* Read the channel, counting failed reads and torn messages */
+static void read_and_check(void)
+{
+	struct sample_msg msg;
+
+	reads++;
+
+	if (zbus_chan_read(&chan, &msg, K_NO_WAIT) != 0) {
+		torn_reads++;
+		return;
+	}
+
+	for (int i = 1; i < SAMPLE_WORDS; i++) {
+		if (msg.words[i] != msg.words[0]) {
+			torn_reads++;
+			break;
+		}
+	}
+}
+
+static void reader_expiry(struct k_timer *timer)
+{
+	ARG_UNUSED(timer);
+
+	read_and_check();
+}
+
+ZTEST(seqlock, test_reads_from_isr_are_consistent)
+{
+	struct sample_msg msg;
+
+	reads = 0;
+	torn_reads = 0;
+	zassert_equal(0, zbus_obs_set_enable(&msg_sub, false));
+
+	k_timer_init(&reader_timer, reader_expiry, NULL);
+	k_timer_start(&reader_timer, K_TICKS(1), K_TICKS(1));
+
+	for (uint32_t word = 1; word <= PUBLISHES; word++) {
+		fill(&msg, word);
+		zassert_equal(0, zbus_chan_pub(&chan, &msg, K_NO_WAIT));
+
+		/* Let time pass on simulated targets too */
+		k_busy_wait(50);
+	}
+
+	k_timer_stop(&reader_timer);
+
+	zassert_equal(0, zbus_obs_set_enable(&msg_sub, true));
+
+	zassert_true(reads > 0, "reader did not run");
+	zassert_equal(0, torn_reads, "%u of %u reads failed or returned a torn message", torn_reads,
+		      reads);
+}
+
+#if defined(CONFIG_SMP) && (CONFIG_MP_MAX_NUM_CPUS > 1)
+
+#define READER_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_DEFINE(reader_stack, READER_STACK_SIZE);
+static struct k_thread reader_thread;
+static atomic_t reader_stop;
+
+static void reader_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!atomic_get(&reader_stop)) {
+		read_and_check();
+	}
+}
+
+ZTEST(seqlock, test_reads_from_other_cpu_are_consistent)
+{
+	struct sample_msg msg;
+
+	reads = 0;
+	torn_reads = 0;
+	atomic_set(&reader_stop, 0);
+	zassert_equal(0, zbus_obs_set_enable(&msg_sub, false));
+
+	/* The test thread is cooperative, so the reader runs on another CPU */
+	k_thread_create(&reader_thread, reader_stack, K_THREAD_STACK_SIZEOF(reader_stack),
+			reader_entry, NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	for (uint32_t word = 1; word <= PUBLISHES * 10; word++) {
+		fill(&msg, word);
+		zassert_equal(0, zbus_chan_pub(&chan, &msg, K_NO_WAIT));
+	}
+
+	atomic_set(&reader_stop, 1);
+	zassert_equal(0, k_thread_join(&reader_thread, K_FOREVER));
+
+	zassert_equal(0, zbus_obs_set_enable(&msg_sub, true));
+
+	zassert_true(reads > 0, "reader did not run");
+	zassert_equal(0, torn_reads, "%u of %u reads failed or returned a torn message", torn_reads,
+		      reads);
+}
+
+#endif /* CONFIG_SMP && CONFIG_MP_MAX_NUM_CPUS > 1 */
+
+#if defined(CONFIG_ZBUS_PRIORITY_BOOST)
+
+ZTEST(seqlock, test_publisher_is_not_boosted)
+{
+	struct sample_msg msg = {0};
+	int prio = k_thread_priority_get(k_current_get());
+
+	/* Make the message subscriber look like it runs on a higher priority thread */
+	k_thread_priority_set(k_current_get(), 1);
+	zassert_equal(0, zbus_obs_attach_to_thread(&msg_sub));
+	k_thread_priority_set(k_current_get(), 5);
+
+	zassert_equal(0, zbus_chan_pub(&locked_chan, &msg, K_NO_WAIT));
+	zassert_equal(0, lis_prio, "publisher of a locked channel not boosted");
+
+	zassert_equal(0, zbus_chan_pub(&chan, &msg, K_NO_WAIT));
+	zassert_equal(5, lis_prio, "publisher of a seqlock channel boosted");
+
+	zassert_equal(0, zbus_obs_detach_from_thread(&msg_sub));
+	k_thread_priority_set(k_current_get(), prio);
+	drain();
+}
+
+#endif /* CONFIG_ZBUS_PRIORITY_BOOST */